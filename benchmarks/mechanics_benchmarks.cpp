@@ -0,0 +1,417 @@
+#include <benchmark/benchmark.h>
+#include <corona/job_pool.h>
+#include <corona/systems/mechanics/spatial_index.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "aabb_kernels.h"
+#include "aabb_soa.h"
+#include "broadphase.h"
+#include "island_builder.h"
+#include "rigid_body_solver.h"
+
+namespace {
+
+using namespace Corona::Systems;
+
+/**
+ * @brief 在立方体内随机放置 count 个边长 [0.5, 1.5] 的包围盒
+ *
+ * 立方体体积与数量成正比，规模变化时每个物体的平均重叠数保持不变。
+ */
+AabbSoA make_scattered_bounds(std::size_t count, std::uint32_t seed = 42) {
+    std::mt19937 rng(seed);
+    const float extent = std::cbrt(static_cast<float>(count)) * 2.0f;
+    std::uniform_real_distribution<float> position(0.0f, extent);
+    std::uniform_real_distribution<float> size(0.5f, 1.5f);
+
+    AabbSoA bounds;
+    bounds.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const float x = position(rng);
+        const float y = position(rng);
+        const float z = position(rng);
+        const float s = size(rng) * 0.5f;
+        bounds.push_back(x - s, y - s, z - s, x + s, y + s, z + s);
+    }
+    return bounds;
+}
+
+/**
+ * @brief make_scattered_bounds 的场景，每个物体带有随机速度，每帧移动后在立方体边界反弹
+ *
+ * 速度最大为每帧 0.05（60 FPS 下 3 m/s），物体运动连贯，宽阶段走增量插入排序的路径。
+ */
+struct MovingBounds {
+    AabbSoA bounds;
+    std::vector<float> velocity;  ///< 每个物体 3 个分量
+    float extent;
+
+    explicit MovingBounds(std::size_t count, std::uint32_t seed = 42)
+        : bounds(make_scattered_bounds(count, seed)), extent(std::cbrt(static_cast<float>(count)) * 2.0f) {
+        std::mt19937 rng(seed + 1);
+        std::uniform_real_distribution<float> speed(-0.05f, 0.05f);
+        velocity.resize(count * 3);
+        for (float& v : velocity) {
+            v = speed(rng);
+        }
+    }
+
+    void step() {
+        std::vector<float>* mins[3] = {&bounds.min_x, &bounds.min_y, &bounds.min_z};
+        std::vector<float>* maxs[3] = {&bounds.max_x, &bounds.max_y, &bounds.max_z};
+        for (std::size_t i = 0; i < bounds.size(); ++i) {
+            for (int axis = 0; axis < 3; ++axis) {
+                float& v = velocity[i * 3 + axis];
+                float& lo = (*mins[axis])[i];
+                float& hi = (*maxs[axis])[i];
+                if ((lo + v < 0.0f) || (hi + v > extent)) {
+                    v = -v;
+                }
+                lo += v;
+                hi += v;
+            }
+        }
+    }
+};
+
+// ============================================================================
+// 宽阶段
+// ============================================================================
+
+/**
+ * @brief 物体每帧移动后更新宽阶段，报告每帧耗时（不含移动物体本身）
+ */
+void BM_SweepAndPrune(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    MovingBounds scene(count);
+
+    SweepAndPrune broadphase;
+    std::vector<BroadphasePair> pairs;
+    broadphase.update(scene.bounds, pairs);
+
+    std::size_t pair_tests = 0;
+    std::size_t sort_moves = 0;
+    std::size_t full_resorts = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        scene.step();
+        state.ResumeTiming();
+
+        broadphase.update(scene.bounds, pairs);
+        benchmark::DoNotOptimize(pairs.data());
+
+        pair_tests += broadphase.stats().pair_tests;
+        sort_moves += broadphase.stats().sort_moves;
+        full_resorts += broadphase.stats().full_resort ? 1 : 0;
+    }
+    const auto frames = static_cast<double>(state.iterations());
+    state.counters["pairs"] = static_cast<double>(pairs.size());
+    state.counters["pair_tests"] = static_cast<double>(pair_tests) / frames;
+    state.counters["sort_moves"] = static_cast<double>(sort_moves) / frames;
+    state.counters["full_resorts"] = static_cast<double>(full_resorts);
+    state.counters["cells"] = static_cast<double>(broadphase.stats().cell_count);
+    state.counters["entries"] = static_cast<double>(broadphase.stats().entry_count);
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+BENCHMARK(BM_SweepAndPrune)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief 线程扩展参数：{数量, 参与者数}，参与者数取 1、2、4 ... 直到硬件线程数
+ */
+void thread_scaling_args(benchmark::internal::Benchmark* benchmark) {
+    // 覆盖全部硬件线程，而不是线程池自动选择时的一半
+    const auto hardware = std::max<std::int64_t>(1, std::thread::hardware_concurrency());
+    for (const std::int64_t count : {10000, 50000}) {
+        for (std::int64_t threads = 1; threads < hardware; threads *= 2) {
+            benchmark->Args({count, threads});
+        }
+        benchmark->Args({count, hardware});
+    }
+}
+
+void BM_SweepAndPruneParallel(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    MovingBounds scene(count);
+
+    Corona::WorkStealingPool pool(static_cast<std::size_t>(state.range(1)));
+    SweepAndPrune broadphase;
+    std::vector<BroadphasePair> pairs;
+    broadphase.update(scene.bounds, pairs, &pool);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        scene.step();
+        state.ResumeTiming();
+
+        broadphase.update(scene.bounds, pairs, &pool);
+        benchmark::DoNotOptimize(pairs.data());
+    }
+    state.counters["pairs"] = static_cast<double>(pairs.size());
+    state.counters["workers"] = static_cast<double>(pool.thread_count());
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+BENCHMARK(BM_SweepAndPruneParallel)->Apply(thread_scaling_args)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void BM_AabbOverlapRange(benchmark::State& state) {
+    const auto kernel = static_cast<AabbKernel>(state.range(0));
+    const AabbKernel previous = aabb_overlap_kernel();
+    if (!set_aabb_overlap_kernel(kernel)) {
+        state.SkipWithError("kernel not supported on this CPU");
+        return;
+    }
+
+    const std::size_t count = 4096;
+    const AabbSoA bounds = make_scattered_bounds(count);
+    const AabbQuery query{0.0f, 0.0f, 0.0f, 8.0f, 8.0f, 8.0f};
+    std::vector<std::uint32_t> hits(count);
+
+    for (auto _ : state) {
+        const std::size_t found = aabb_overlap_range(query, bounds, 0, count, hits.data());
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetLabel(aabb_kernel_name(kernel));
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+    set_aabb_overlap_kernel(previous);
+}
+BENCHMARK(BM_AabbOverlapRange)
+    ->Arg(static_cast<std::int64_t>(AabbKernel::Scalar))
+    ->Arg(static_cast<std::int64_t>(AabbKernel::Sse2))
+    ->Arg(static_cast<std::int64_t>(AabbKernel::Avx2));
+
+// ============================================================================
+// 求解器
+// ============================================================================
+
+/**
+ * @brief 金字塔堆叠场景：地面上 rows 层盒子，顶层 1 个
+ */
+struct PyramidScene {
+    std::vector<RigidBody> bodies;
+    std::vector<std::uintptr_t> keys;
+    std::vector<ktm::fvec3> half_extents;
+
+    explicit PyramidScene(int rows) {
+        add({0.0f, -1.0f, 0.0f}, {50.0f, 1.0f, 50.0f}, 0.0f);
+        for (int row = 0; row < rows; ++row) {
+            const int columns = rows - row;
+            for (int column = 0; column < columns; ++column) {
+                const float x = (static_cast<float>(column) - static_cast<float>(columns) * 0.5f) * 1.05f + 0.5f;
+                add({x, 0.5f + static_cast<float>(row), 0.0f}, {0.5f, 0.5f, 0.5f}, 1.0f);
+            }
+        }
+    }
+
+    void add(const ktm::fvec3& center, const ktm::fvec3& half, float mass) {
+        RigidBody body{};
+        body.center = center;
+        body.rotation = basis_from_euler(body.euler_rotation);
+        body.restitution = 0.2f;
+        body.friction = 0.5f;
+        set_box_mass(body, mass, half);
+        bodies.push_back(body);
+        keys.push_back((keys.size() + 1) * 16);
+        half_extents.push_back(half);
+    }
+
+    void gather_bounds(AabbSoA& bounds) const {
+        bounds.clear();
+        for (std::size_t i = 0; i < bodies.size(); ++i) {
+            const auto& c = bodies[i].center;
+            const auto& h = half_extents[i];
+            bounds.push_back(c.x - h.x, c.y - h.y, c.z - h.z, c.x + h.x, c.y + h.y, c.z + h.z);
+        }
+    }
+};
+
+void BM_RigidBodySolverPyramid(benchmark::State& state) {
+    PyramidScene scene(static_cast<int>(state.range(0)));
+
+    SolverSettings settings;
+    settings.time_to_sleep = 1e30f;  // 保持所有岛活动，测量的是稳定堆叠的求解开销
+
+    SweepAndPrune broadphase;
+    RigidBodySolver solver;
+    IslandBuilder islands;
+    AabbSoA bounds;
+    std::vector<BroadphasePair> pairs;
+    std::vector<std::uint8_t> dynamic(scene.bodies.size());
+    for (std::size_t i = 0; i < scene.bodies.size(); ++i) {
+        dynamic[i] = scene.bodies[i].inv_mass != 0.0f ? 1 : 0;
+    }
+
+    for (auto _ : state) {
+        scene.gather_bounds(bounds);
+        broadphase.update(bounds, pairs);
+        islands.build(dynamic, pairs);
+        const std::vector<std::uint8_t> awake(islands.island_count(), 1);
+        solver.step(scene.bodies, scene.keys, bounds, pairs, islands, awake, settings);
+    }
+    state.counters["bodies"] = static_cast<double>(scene.bodies.size());
+    state.counters["contacts"] = static_cast<double>(solver.stats().contact_count);
+    state.counters["top_y"] = scene.bodies.back().center.y;
+}
+BENCHMARK(BM_RigidBodySolverPyramid)->Arg(10)->Arg(20)->Arg(40)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief 从初始摆放开始推进，直到所有岛休眠或最大速度低于阈值，报告所需的帧数
+ *
+ * 每次迭代都从新的场景开始，测量的是堆叠稳定下来的总耗时；
+ * 在 kMaxFrames 帧内未能稳定时 settled 为 0。
+ */
+void BM_RigidBodySolverPyramidSettle(benchmark::State& state) {
+    constexpr int kMaxFrames = 3000;
+    constexpr float kSettledSpeed = 0.01f;
+
+    int frames = 0;
+    bool settled = false;
+    float top_y = 0.0f;
+    for (auto _ : state) {
+        PyramidScene scene(static_cast<int>(state.range(0)));
+        SolverSettings settings;
+        SweepAndPrune broadphase;
+        RigidBodySolver solver;
+        IslandBuilder islands;
+        AabbSoA bounds;
+        std::vector<BroadphasePair> pairs;
+        std::vector<std::uint8_t> dynamic(scene.bodies.size());
+        std::size_t dynamic_count = 0;
+        for (std::size_t i = 0; i < scene.bodies.size(); ++i) {
+            dynamic[i] = scene.bodies[i].inv_mass != 0.0f ? 1 : 0;
+            dynamic_count += dynamic[i];
+        }
+
+        settled = false;
+        for (frames = 0; frames < kMaxFrames && !settled;) {
+            scene.gather_bounds(bounds);
+            broadphase.update(bounds, pairs);
+            islands.build(dynamic, pairs);
+            std::vector<std::uint8_t> awake(islands.island_count(), 0);
+            for (std::size_t island = 0; island < islands.island_count(); ++island) {
+                for (const std::uint32_t body : islands.bodies(island)) {
+                    awake[island] = awake[island] || !scene.bodies[body].sleeping;
+                }
+            }
+            solver.step(scene.bodies, scene.keys, bounds, pairs, islands, awake, settings);
+            ++frames;
+
+            float max_speed = 0.0f;
+            for (const auto& body : scene.bodies) {
+                const auto& v = body.linear_velocity;
+                max_speed = std::max(max_speed, std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z));
+            }
+            settled = solver.stats().sleeping_bodies == dynamic_count || max_speed < kSettledSpeed;
+        }
+        top_y = scene.bodies.back().center.y;
+    }
+    state.counters["frames_to_settle"] = static_cast<double>(frames);
+    state.counters["settled"] = settled ? 1.0 : 0.0;
+    state.counters["top_y"] = top_y;
+}
+BENCHMARK(BM_RigidBodySolverPyramidSettle)->Arg(10)->Arg(20)->Unit(benchmark::kMillisecond)->Iterations(1);
+
+void BM_ExpandSweptBounds(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const AabbSoA bounds = make_scattered_bounds(count);
+
+    std::vector<RigidBody> bodies(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        auto& body = bodies[i];
+        set_box_mass(body, 1.0f, {0.5f, 0.5f, 0.5f});
+        body.linear_velocity = {30.0f, -10.0f, 5.0f};
+        body.continuous = i % 2 == 0;
+    }
+
+    SolverSettings settings;
+    AabbSoA swept;
+    for (auto _ : state) {
+        expand_swept_bounds(bodies, bounds, swept, settings);
+        benchmark::DoNotOptimize(swept.max_x.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+BENCHMARK(BM_ExpandSweptBounds)->Arg(10000);
+
+// ============================================================================
+// 空间查询
+// ============================================================================
+
+std::vector<SpatialIndex::Entry> make_index_entries(std::size_t count) {
+    const AabbSoA bounds = make_scattered_bounds(count, 7);
+    std::vector<SpatialIndex::Entry> entries(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        entries[i].min = {bounds.min_x[i], bounds.min_y[i], bounds.min_z[i]};
+        entries[i].max = {bounds.max_x[i], bounds.max_y[i], bounds.max_z[i]};
+        entries[i].body.mechanics_handle = (i + 1) * 16;
+        entries[i].body.geometry_handle = (i + 1) * 16;
+    }
+    return entries;
+}
+
+void BM_SpatialIndexBuild(benchmark::State& state) {
+    const auto entries = make_index_entries(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        SpatialIndex index(entries);
+        // BVH 在第一次查询时构建
+        benchmark::DoNotOptimize(index.overlap_box(QueryBox{{0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}}));
+    }
+}
+BENCHMARK(BM_SpatialIndexBuild)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+void BM_SpatialIndexRaycastBatch(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    SpatialIndex index(make_index_entries(count));
+
+    const float extent = std::cbrt(static_cast<float>(count)) * 2.0f;
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> coordinate(0.0f, extent);
+    std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+
+    std::vector<QueryRay> rays(1024);
+    for (auto& ray : rays) {
+        ray.origin = {coordinate(rng), coordinate(rng), coordinate(rng)};
+        ray.direction = {direction(rng), direction(rng), direction(rng)};
+        ray.max_distance = extent;
+    }
+    std::vector<RayHit> hits(rays.size());
+    index.raycast(rays, hits);
+
+    for (auto _ : state) {
+        index.raycast(rays, hits);
+        benchmark::DoNotOptimize(hits.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * rays.size()));
+}
+BENCHMARK(BM_SpatialIndexRaycastBatch)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+void BM_SpatialIndexOverlapBox(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    SpatialIndex index(make_index_entries(count));
+
+    const float extent = std::cbrt(static_cast<float>(count)) * 2.0f;
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> coordinate(0.0f, extent);
+
+    std::vector<QueryBox> boxes(1024);
+    for (auto& box : boxes) {
+        box.min = {coordinate(rng), coordinate(rng), coordinate(rng)};
+        box.max = {box.min.x + 2.0f, box.min.y + 2.0f, box.min.z + 2.0f};
+    }
+    OverlapResults results;
+    index.overlap_box(boxes, results);
+
+    for (auto _ : state) {
+        index.overlap_box(boxes, results);
+        benchmark::DoNotOptimize(results.bodies.data());
+    }
+    state.counters["hits"] = static_cast<double>(results.bodies.size());
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * boxes.size()));
+}
+BENCHMARK(BM_SpatialIndexOverlapBox)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+}  // namespace
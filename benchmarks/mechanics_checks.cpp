@@ -0,0 +1,461 @@
+// 力学内核的行为检查：任一检查失败时进程以非 0 退出，由 CTest 运行
+#include <corona/job_pool.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "aabb_kernels.h"
+#include "aabb_soa.h"
+#include "broadphase.h"
+#include "island_builder.h"
+#include "rigid_body_solver.h"
+
+namespace {
+
+using namespace Corona::Systems;
+using Corona::WorkStealingPool;
+
+/**
+ * @brief 最小的求解场景：盒体刚体与力学系统相同的单步流程（扫掠包围盒 -> 宽阶段 -> 岛 -> 求解）
+ */
+struct BoxScene {
+    std::vector<RigidBody> bodies;
+    std::vector<std::uintptr_t> keys;
+    std::vector<ktm::fvec3> half_extents;
+    SolverSettings settings;
+
+    SweepAndPrune broadphase;
+    RigidBodySolver solver;
+    IslandBuilder islands;
+    AabbSoA bounds;
+    AabbSoA swept;
+    std::vector<BroadphasePair> pairs;
+    std::vector<std::uint8_t> dynamic;
+    std::vector<std::uint8_t> awake;
+
+    std::size_t add(const ktm::fvec3& center, const ktm::fvec3& half, float mass) {
+        RigidBody body{};
+        body.center = center;
+        body.rotation = basis_from_euler(body.euler_rotation);
+        body.restitution = 0.0f;
+        body.friction = 0.5f;
+        set_box_mass(body, mass, half);
+        bodies.push_back(body);
+        keys.push_back((keys.size() + 1) * 16);
+        half_extents.push_back(half);
+        return bodies.size() - 1;
+    }
+
+    void step(WorkStealingPool* pool = nullptr) {
+        bounds.clear();
+        for (std::size_t i = 0; i < bodies.size(); ++i) {
+            const auto& c = bodies[i].center;
+            const auto& h = half_extents[i];
+            bounds.push_back(c.x - h.x, c.y - h.y, c.z - h.z, c.x + h.x, c.y + h.y, c.z + h.z);
+        }
+
+        expand_swept_bounds(bodies, bounds, swept, settings);
+        broadphase.update(swept, pairs, pool);
+
+        dynamic.resize(bodies.size());
+        for (std::size_t i = 0; i < bodies.size(); ++i) {
+            dynamic[i] = bodies[i].inv_mass != 0.0f ? 1 : 0;
+        }
+        islands.build(dynamic, pairs);
+        awake.assign(islands.island_count(), 0);
+        for (std::size_t island = 0; island < islands.island_count(); ++island) {
+            for (const std::uint32_t body : islands.bodies(island)) {
+                if (!bodies[body].sleeping) {
+                    awake[island] = 1;
+                    break;
+                }
+            }
+        }
+
+        solver.step(bodies, keys, bounds, pairs, islands, awake, settings, pool);
+    }
+};
+
+// ============================================================================
+// 包围盒重叠内核
+// ============================================================================
+
+/**
+ * @brief 比较向量实现与标量参考在 [begin, end) 上的输出，下标序列必须完全一致
+ */
+bool compare_overlap_range(const AabbQuery& query, const AabbSoA& bounds, std::size_t begin, std::size_t end,
+                           const char* label) {
+    std::vector<std::uint32_t> expected(end - begin + 1);
+    std::vector<std::uint32_t> actual(end - begin + 1);
+    const std::size_t expected_count = aabb_overlap_range_scalar(query, bounds, begin, end, expected.data());
+    const std::size_t actual_count = aabb_overlap_range(query, bounds, begin, end, actual.data());
+
+    bool same = expected_count == actual_count;
+    for (std::size_t i = 0; same && i < expected_count; ++i) {
+        same = expected[i] == actual[i];
+    }
+    if (!same) {
+        std::fprintf(stderr, "  overlap range (%s): [%zu, %zu) expected %zu hits, got %zu\n", label, begin, end,
+                     expected_count, actual_count);
+    }
+    return same;
+}
+
+/**
+ * @brief 向量化的重叠内核与标量参考逐一比较
+ *
+ * - 随机：坐标取 0.25 的整数倍，边界相等（接触）的情况频繁出现；区间的起点与长度随机，
+ *   覆盖不足一个向量宽度、不是向量宽度整数倍以及起点未对齐的情况；
+ * - 接触：与查询盒恰好在面、棱、角上接触的盒子，以及只差一个浮点间隔而分离的盒子；
+ * - 退化：零体积的盒子、正负零坐标。
+ */
+bool check_aabb_overlap_range() {
+    bool ok = true;
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> grid(-16, 16);
+    std::uniform_int_distribution<int> extent(0, 8);
+    const auto coordinate = [&] { return static_cast<float>(grid(rng)) * 0.25f; };
+
+    for (int round = 0; round < 2000; ++round) {
+        const std::size_t count = static_cast<std::size_t>(round % 67);
+        AabbSoA bounds;
+        for (std::size_t i = 0; i < count; ++i) {
+            const float x = coordinate();
+            const float y = coordinate();
+            const float z = coordinate();
+            bounds.push_back(x, y, z, x + extent(rng) * 0.25f, y + extent(rng) * 0.25f, z + extent(rng) * 0.25f);
+        }
+        const float x = coordinate();
+        const float y = coordinate();
+        const float z = coordinate();
+        const AabbQuery query{x, y, z, x + extent(rng) * 0.5f, y + extent(rng) * 0.5f, z + extent(rng) * 0.5f};
+
+        const std::size_t begin = count > 0 ? static_cast<std::size_t>(rng() % (count + 1)) : 0;
+        ok = compare_overlap_range(query, bounds, 0, count, "random") && ok;
+        ok = compare_overlap_range(query, bounds, begin, count, "random, offset") && ok;
+    }
+
+    // 查询盒 [0, 1]^3；沿每个轴、每个方向放置接触与刚好分离的盒子
+    const AabbQuery query{0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f};
+    AabbSoA touching;
+    for (int axis = 0; axis < 3; ++axis) {
+        for (const float side : {-1.0f, 1.0f}) {
+            float lo[3] = {0.0f, 0.0f, 0.0f};
+            float hi[3] = {1.0f, 1.0f, 1.0f};
+            // 面接触
+            lo[axis] = side > 0.0f ? 1.0f : -1.0f;
+            hi[axis] = side > 0.0f ? 2.0f : 0.0f;
+            touching.push_back(lo[0], lo[1], lo[2], hi[0], hi[1], hi[2]);
+            // 只差一个浮点间隔而分离
+            lo[axis] = side > 0.0f ? std::nextafter(1.0f, 2.0f) : -1.0f;
+            hi[axis] = side > 0.0f ? 2.0f : std::nextafter(0.0f, -1.0f);
+            touching.push_back(lo[0], lo[1], lo[2], hi[0], hi[1], hi[2]);
+        }
+    }
+    touching.push_back(1.0f, 1.0f, 0.0f, 2.0f, 2.0f, 1.0f);     // 棱接触
+    touching.push_back(1.0f, 1.0f, 1.0f, 2.0f, 2.0f, 2.0f);     // 角接触
+    touching.push_back(-1.0f, -1.0f, -1.0f, -0.0f, -0.0f, -0.0f);  // 负零与零接触
+    touching.push_back(0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f);     // 零体积，位于内部
+    touching.push_back(1.0f, 0.5f, 0.5f, 1.0f, 0.5f, 0.5f);     // 零体积，位于面上
+    touching.push_back(2.0f, 0.5f, 0.5f, 2.0f, 0.5f, 0.5f);     // 零体积，位于外部
+    for (std::size_t begin = 0; begin < touching.size(); ++begin) {
+        ok = compare_overlap_range(query, touching, begin, touching.size(), "touching") && ok;
+    }
+
+    // 接触盒必须被判为重叠：参考实现本身的约定（边界接触视为重叠）
+    std::vector<std::uint32_t> hits(touching.size());
+    const std::size_t found = aabb_overlap_range(query, touching, 0, touching.size(), hits.data());
+    const std::size_t expected = 6 + 2 + 1 + 2;  // 6 个面接触、棱与角、负零、2 个零体积（内部与面上）
+    if (found != expected) {
+        std::fprintf(stderr, "  overlap range (touching): expected %zu hits, got %zu\n", expected, found);
+        ok = false;
+    }
+    return ok;
+}
+
+// ============================================================================
+// 宽阶段
+// ============================================================================
+
+/**
+ * @brief 宽阶段输出与两两比较的参考结果逐一比较
+ */
+bool compare_broadphase(SweepAndPrune& broadphase, const AabbSoA& bounds, WorkStealingPool* pool, const char* label) {
+    std::vector<BroadphasePair> expected;
+    for (std::uint32_t a = 0; a < bounds.size(); ++a) {
+        for (std::uint32_t b = a + 1; b < bounds.size(); ++b) {
+            if (aabb_overlap(aabb_at(bounds, a), aabb_at(bounds, b))) {
+                expected.push_back({a, b});
+            }
+        }
+    }
+
+    std::vector<BroadphasePair> pairs;
+    broadphase.update(bounds, pairs, pool);
+    bool same = pairs.size() == expected.size();
+    for (std::size_t i = 0; same && i < expected.size(); ++i) {
+        same = pairs[i].a == expected[i].a && pairs[i].b == expected[i].b;
+    }
+    if (!same) {
+        std::fprintf(stderr, "  broadphase (%s, cell size %.2f, %zu cells): expected %zu pairs, got %zu\n", label,
+                     broadphase.stats().cell_size, broadphase.stats().cell_count, expected.size(), pairs.size());
+    }
+    return same;
+}
+
+/**
+ * @brief 网格划分的宽阶段与两两比较的结果完全一致
+ *
+ * 坐标取 0.25 的整数倍，接触与跨越单元边界的情况频繁出现；场景中包含覆盖整个场景的地面、
+ * 零体积的盒子以及所有物体位于同一平面的退化情况。每个场景在多种单元边长下连续移动若干帧，
+ * 覆盖增量插入排序，串行与并行两条路径都参与比较。
+ */
+bool check_broadphase_brute_force() {
+    bool ok = true;
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> grid(0, 160);
+    std::uniform_int_distribution<int> extent(0, 12);
+    std::uniform_int_distribution<int> step(-1, 1);
+    const auto coordinate = [&] { return static_cast<float>(grid(rng)) * 0.25f; };
+
+    WorkStealingPool pool(3);
+    for (const bool flat : {false, true}) {
+        AabbSoA bounds;
+        bounds.push_back(-1.0f, -1.0f, -1.0f, 41.0f, 0.0f, 41.0f);  // 地面
+        for (int i = 0; i < 1500; ++i) {
+            const float x = coordinate();
+            const float y = flat ? 0.0f : coordinate();
+            const float z = coordinate();
+            const float size = static_cast<float>(extent(rng)) * 0.25f;
+            bounds.push_back(x, y, z, x + size, flat ? 0.0f : y + size, z + size);
+        }
+
+        for (const float cell_size : {0.0f, 0.3f, 1.0f, 4.0f, 1000.0f}) {
+            SweepAndPrune serial;
+            SweepAndPrune parallel;
+            serial.set_cell_size(cell_size);
+            parallel.set_cell_size(cell_size);
+            AabbSoA moving = bounds;
+            for (int frame = 0; frame < 4; ++frame) {
+                ok = compare_broadphase(serial, moving, nullptr, flat ? "flat" : "scattered") && ok;
+                ok = compare_broadphase(parallel, moving, &pool, flat ? "flat, parallel" : "scattered, parallel") && ok;
+                for (std::size_t i = 1; i < moving.size(); ++i) {
+                    const float dx = static_cast<float>(step(rng)) * 0.25f;
+                    const float dz = static_cast<float>(step(rng)) * 0.25f;
+                    moving.set(i, moving.min_x[i] + dx, moving.min_y[i], moving.min_z[i] + dz, moving.max_x[i] + dx,
+                               moving.max_y[i], moving.max_z[i] + dz);
+                }
+            }
+        }
+    }
+    return ok;
+}
+
+// ============================================================================
+// 并行确定性
+// ============================================================================
+
+/**
+ * @brief 地面上 16 x 16 堆随机扰动的盒子，带随机初速度
+ *
+ * 物体与接触数量都超过宽阶段扫描和求解器的并行分块粒度，确保并行路径被实际执行。
+ */
+void build_pile_scene(BoxScene& scene) {
+    std::mt19937 rng(23);
+    std::uniform_real_distribution<float> jitter(-0.2f, 0.2f);
+    std::uniform_real_distribution<float> speed(-2.0f, 2.0f);
+
+    scene.add({0.0f, -1.0f, 0.0f}, {40.0f, 1.0f, 40.0f}, 0.0f);
+    for (int pile_x = 0; pile_x < 16; ++pile_x) {
+        for (int pile_z = 0; pile_z < 16; ++pile_z) {
+            for (int level = 0; level < 5; ++level) {
+                const ktm::fvec3 center{static_cast<float>(pile_x) * 3.0f - 24.0f + jitter(rng),
+                                        0.5f + static_cast<float>(level) * 1.1f,
+                                        static_cast<float>(pile_z) * 3.0f - 24.0f + jitter(rng)};
+                const std::size_t body = scene.add(center, {0.5f, 0.5f, 0.5f}, 1.0f);
+                scene.bodies[body].linear_velocity = {speed(rng), 0.0f, speed(rng)};
+                scene.bodies[body].continuous = level == 4;
+            }
+        }
+    }
+}
+
+bool same_bits(const ktm::fvec3& lhs, const ktm::fvec3& rhs) {
+    return std::memcmp(&lhs.x, &rhs.x, sizeof(float)) == 0 && std::memcmp(&lhs.y, &rhs.y, sizeof(float)) == 0 &&
+           std::memcmp(&lhs.z, &rhs.z, sizeof(float)) == 0;
+}
+
+/**
+ * @brief 宽阶段候选对与求解结果与线程数量无关
+ *
+ * 以串行执行为参考，分别用 1、2、4、8 个参与者的线程池运行相同的场景，
+ * 每一步的候选对序列与每个物体的位置、速度都必须逐位相同。
+ */
+bool check_parallel_determinism() {
+    constexpr int kFrames = 120;
+
+    BoxScene reference;
+    build_pile_scene(reference);
+    std::vector<std::vector<BroadphasePair>> reference_pairs(kFrames);
+    for (int frame = 0; frame < kFrames; ++frame) {
+        reference.step();
+        reference_pairs[frame] = reference.pairs;
+    }
+
+    bool ok = true;
+    for (const std::size_t threads : {1u, 2u, 4u, 8u}) {
+        WorkStealingPool pool(threads);
+        BoxScene scene;
+        build_pile_scene(scene);
+
+        int diverged = -1;
+        for (int frame = 0; frame < kFrames && diverged < 0; ++frame) {
+            scene.step(&pool);
+            const auto& expected = reference_pairs[frame];
+            bool same = scene.pairs.size() == expected.size();
+            for (std::size_t i = 0; same && i < expected.size(); ++i) {
+                same = scene.pairs[i].a == expected[i].a && scene.pairs[i].b == expected[i].b;
+            }
+            if (!same) {
+                diverged = frame;
+            }
+        }
+        if (diverged >= 0) {
+            std::fprintf(stderr, "  determinism: %zu threads, pair list differs at frame %d\n", threads, diverged);
+            ok = false;
+            continue;
+        }
+
+        for (std::size_t i = 0; i < scene.bodies.size(); ++i) {
+            const auto& a = scene.bodies[i];
+            const auto& b = reference.bodies[i];
+            if (!same_bits(a.center, b.center) || !same_bits(a.linear_velocity, b.linear_velocity) ||
+                !same_bits(a.angular_velocity, b.angular_velocity) || a.sleeping != b.sleeping) {
+                std::fprintf(stderr, "  determinism: %zu threads, body %zu differs after %d frames\n", threads, i,
+                             kFrames);
+                ok = false;
+                break;
+            }
+        }
+    }
+    return ok;
+}
+
+// ============================================================================
+// 连续碰撞检测
+// ============================================================================
+
+/**
+ * @brief 以递增的速度把小盒子射向薄墙，任何速度下都不得穿过墙体
+ *
+ * 墙厚 0.1 米、盒子边长 0.2 米，最高速度下单步位移远大于两者之和，离散检测必然穿透。
+ * 同时要求盒子确实到达了墙面，避免因提前停下而误判为通过。
+ */
+bool check_thin_wall_tunnelling() {
+    constexpr float kWallX = 5.0f;
+    constexpr float kWallHalf = 0.05f;
+    constexpr float kBoxHalf = 0.1f;
+    const float speeds[] = {5.0f, 20.0f, 60.0f, 120.0f, 250.0f, 500.0f, 1000.0f, 2000.0f};
+
+    bool ok = true;
+    for (const float speed : speeds) {
+        BoxScene scene;
+        scene.settings.gravity = {0.0f, 0.0f, 0.0f};
+        scene.add({kWallX, 0.0f, 0.0f}, {kWallHalf, 5.0f, 5.0f}, 0.0f);
+        const std::size_t box = scene.add({0.0f, 0.0f, 0.0f}, {kBoxHalf, kBoxHalf, kBoxHalf}, 1.0f);
+        scene.bodies[box].continuous = true;
+        scene.bodies[box].linear_velocity = {speed, 0.0f, 0.0f};
+
+        // 步数足够让未拦截的盒子飞到墙后 2 倍距离之外
+        const float step_distance = speed * scene.settings.time_step;
+        const int frames = static_cast<int>(std::ceil(2.0f * kWallX / step_distance)) + 10;
+
+        bool tunnelled = false;
+        float furthest = scene.bodies[box].center.x;
+        for (int frame = 0; frame < frames && !tunnelled; ++frame) {
+            scene.step();
+            furthest = std::max(furthest, scene.bodies[box].center.x);
+            tunnelled = scene.bodies[box].center.x > kWallX;
+        }
+
+        // 低速时离散接触的穿透修正会把盒子轻轻推回，因此按到达过的最远位置判断
+        const bool reached = furthest + kBoxHalf >= kWallX - kWallHalf - 0.05f;
+        if (tunnelled || !reached) {
+            std::fprintf(stderr, "  thin wall: speed %.0f m/s %s (box x = %.3f)\n", speed,
+                         tunnelled ? "tunnelled through" : "stopped short of", furthest);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+struct Check {
+    const char* name;
+    bool (*run)();
+};
+
+constexpr Check kChecks[] = {
+    {"aabb_overlap_range", check_aabb_overlap_range},
+    {"broadphase_brute_force", check_broadphase_brute_force},
+    {"parallel_determinism", check_parallel_determinism},
+    {"thin_wall_tunnelling", check_thin_wall_tunnelling},
+};
+
+// CTest 视为跳过的退出码（SKIP_RETURN_CODE）
+constexpr int kSkipReturnCode = 77;
+
+/**
+ * @brief 解析 --aabb-kernel=<scalar|sse2|avx2>，强制使用指定的重叠内核
+ *
+ * @return 0 表示继续运行；否则为进程退出码（参数无效为 2，当前 CPU 不支持为 kSkipReturnCode）
+ */
+int select_aabb_kernel(int argc, char** argv) {
+    constexpr std::string_view kOption = "--aabb-kernel=";
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (!arg.starts_with(kOption)) {
+            std::fprintf(stderr, "unknown argument: %s\n", argv[i]);
+            return 2;
+        }
+        const std::string_view name = arg.substr(kOption.size());
+        bool known = false;
+        for (const AabbKernel kernel : {AabbKernel::Scalar, AabbKernel::Sse2, AabbKernel::Avx2}) {
+            if (name != aabb_kernel_name(kernel)) {
+                continue;
+            }
+            known = true;
+            if (!set_aabb_overlap_kernel(kernel)) {
+                std::printf("[SKIP] aabb kernel %s is not supported on this CPU\n", aabb_kernel_name(kernel));
+                return kSkipReturnCode;
+            }
+        }
+        if (!known) {
+            std::fprintf(stderr, "unknown aabb kernel: %.*s\n", static_cast<int>(name.size()), name.data());
+            return 2;
+        }
+    }
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (const int code = select_aabb_kernel(argc, argv); code != 0) {
+        return code;
+    }
+    std::printf("aabb kernel: %s (%zu lanes)\n", aabb_kernel_name(aabb_overlap_kernel()), aabb_overlap_lane_width());
+
+    int failed = 0;
+    for (const auto& check : kChecks) {
+        const bool ok = check.run();
+        std::printf("[%s] %s\n", ok ? "PASS" : "FAIL", check.name);
+        failed += ok ? 0 : 1;
+    }
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+#include <benchmark/benchmark.h>
+#include <corona/shared_data_hub.h>
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "scene_traversal.h"
+
+namespace {
+
+using namespace Corona;
+
+/**
+ * @brief 不访问 GPU 的后端：只累计提交的矩阵，用于测量光学系统遍历场景的开销
+ */
+struct NullRecorder {
+    std::size_t views = 0;
+    std::size_t draws = 0;
+    float checksum = 0.0f;
+
+    void begin_view(const CameraDevice& camera) {
+        const auto view_proj = camera.compute_view_proj_matrix();
+        checksum += view_proj[0][0];
+        ++views;
+    }
+
+    void draw(GeometryDevice& geometry, const ktm::fmat4x4* model_matrix) {
+        if (model_matrix) {
+            checksum += (*model_matrix)[3][0];
+        }
+        draws += geometry.mesh_handles.size() + 1;
+    }
+
+    void end_view(const SceneDevice&, const CameraDevice&) {
+    }
+};
+
+/**
+ * @brief 在 SharedDataHub 中建立一个场景、一个视口与 count 个光学物体，析构时全部释放
+ */
+class OpticsScene {
+   public:
+    explicit OpticsScene(std::size_t count) {
+        auto& hub = SharedDataHub::instance();
+
+        camera_ = hub.camera_storage().allocate();
+        viewport_ = hub.viewport_storage().allocate();
+        if (auto viewport = hub.viewport_storage().acquire_write(viewport_)) {
+            viewport->camera = camera_;
+        }
+        scene_ = hub.scene_storage().allocate();
+        if (auto scene = hub.scene_storage().acquire_write(scene_)) {
+            scene->viewport_handles.push_back(viewport_);
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto transform = hub.model_transform_storage().allocate();
+            if (auto accessor = hub.model_transform_storage().acquire_write(transform)) {
+                accessor->position.x = static_cast<float>(i % 100);
+                accessor->position.z = static_cast<float>(i / 100);
+                accessor->euler_rotation.y = static_cast<float>(i) * 0.01f;
+            }
+
+            const auto geometry = hub.geometry_storage().allocate();
+            if (auto accessor = hub.geometry_storage().acquire_write(geometry)) {
+                accessor->transform_handle = transform;
+            }
+
+            const auto optics = hub.optics_storage().allocate();
+            if (auto accessor = hub.optics_storage().acquire_write(optics)) {
+                accessor->geometry_handle = geometry;
+            }
+
+            transforms_.push_back(transform);
+            geometries_.push_back(geometry);
+            optics_.push_back(optics);
+        }
+    }
+
+    ~OpticsScene() {
+        auto& hub = SharedDataHub::instance();
+        for (const auto handle : optics_) {
+            hub.optics_storage().deallocate(handle);
+        }
+        for (const auto handle : geometries_) {
+            hub.geometry_storage().deallocate(handle);
+        }
+        for (const auto handle : transforms_) {
+            hub.model_transform_storage().deallocate(handle);
+        }
+        hub.scene_storage().deallocate(scene_);
+        hub.viewport_storage().deallocate(viewport_);
+        hub.camera_storage().deallocate(camera_);
+    }
+
+    OpticsScene(const OpticsScene&) = delete;
+    OpticsScene& operator=(const OpticsScene&) = delete;
+
+   private:
+    std::uintptr_t camera_ = 0;
+    std::uintptr_t viewport_ = 0;
+    std::uintptr_t scene_ = 0;
+    std::vector<std::uintptr_t> transforms_;
+    std::vector<std::uintptr_t> geometries_;
+    std::vector<std::uintptr_t> optics_;
+};
+
+void BM_OpticsSceneTraversal(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    OpticsScene scene(count);
+
+    NullRecorder recorder;
+    for (auto _ : state) {
+        Systems::traverse_scene_views(recorder, std::chrono::steady_clock::now());
+    }
+    benchmark::DoNotOptimize(recorder.checksum);
+    state.counters["draws_per_frame"] = static_cast<double>(recorder.draws) / static_cast<double>(state.iterations());
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+BENCHMARK(BM_OpticsSceneTraversal)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+}  // namespace
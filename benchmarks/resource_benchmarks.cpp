@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+#include <corona/resource/resource_manager.h>
+#include <corona/resource/types/image.h>
+#include <corona/resource/types/scene.h>
+#include <corona/resource/types/text.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+namespace fs = std::filesystem;
+
+const fs::path kAssetsDir = CORONA_BENCHMARK_ASSETS_DIR;
+
+Corona::Resource::ResourceManager& resource_manager() {
+    auto& manager = Corona::Resource::ResourceManager::get_instance();
+
+    // 与 Engine::initialize 注册相同的解析器
+    [[maybe_unused]] static const bool registered = [&manager] {
+        manager.register_parser<Corona::Resource::TextParser>();
+        manager.register_parser<Corona::Resource::ImageParser>();
+        manager.register_parser<Corona::Resource::SceneParser>();
+        return true;
+    }();
+    return manager;
+}
+
+/**
+ * @brief 每次迭代把源文件复制到新的临时目录再导入，测量的是未命中任何缓存的完整解析
+ */
+void run_import(benchmark::State& state, const std::vector<fs::path>& sources) {
+    auto& manager = resource_manager();
+    const fs::path root = fs::temp_directory_path() / "corona_resource_benchmark";
+    fs::remove_all(root);
+
+    std::uint64_t index = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        const fs::path directory = root / std::to_string(index++);
+        fs::create_directories(directory);
+        for (const auto& source : sources) {
+            fs::copy_file(source, directory / source.filename());
+        }
+        const fs::path target = directory / sources.front().filename();
+        state.ResumeTiming();
+
+        const auto id = manager.import_sync(target);
+        if (id == 0) {
+            state.SkipWithError("import_sync failed");
+            break;
+        }
+        benchmark::DoNotOptimize(id);
+    }
+
+    std::error_code ec;
+    fs::remove_all(root, ec);
+}
+
+void BM_ResourceImportText(benchmark::State& state) {
+    run_import(state, {kAssetsDir / "shaders" / "test.frag.glsl"});
+}
+BENCHMARK(BM_ResourceImportText)->Unit(benchmark::kMicrosecond)->Iterations(256);
+
+void BM_ResourceImportModel(benchmark::State& state) {
+    run_import(state, {kAssetsDir / "model" / "Ball.obj", kAssetsDir / "model" / "Ball.mtl"});
+}
+BENCHMARK(BM_ResourceImportModel)->Unit(benchmark::kMillisecond)->Iterations(32);
+
+}  // namespace
@@ -0,0 +1,149 @@
+#include <benchmark/benchmark.h>
+#include <corona/frame_arena.h>
+#include <corona/frame_graph.h>
+#include <corona/job_pool.h>
+#include <corona/metrics.h>
+#include <corona/profiler.h>
+#include <corona/systems/acoustics/acoustics_system.h>
+#include <corona/systems/display/display_system.h>
+#include <corona/systems/geometry/geometry_system.h>
+#include <corona/systems/kinematics/kinematics_system.h>
+#include <corona/systems/mechanics/mechanics_system.h>
+#include <corona/systems/optics/optics_system.h>
+#include <corona/systems/script/script_system.h>
+
+#include <atomic>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace Corona;
+
+// ============================================================================
+// 线程池与帧图
+// ============================================================================
+
+void BM_WorkStealingPoolParallelFor(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    WorkStealingPool pool(0);
+    std::vector<float> values(count, 1.0f);
+
+    for (auto _ : state) {
+        pool.parallel_for(count, 1024, [&values](const JobRange& range) {
+            for (std::size_t i = range.begin; i < range.end; ++i) {
+                values[i] = values[i] * 0.5f + 1.0f;
+            }
+        });
+        benchmark::ClobberMemory();
+    }
+    state.counters["workers"] = static_cast<double>(pool.thread_count());
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+BENCHMARK(BM_WorkStealingPoolParallelFor)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20)->UseRealTime();
+
+/**
+ * @brief 与引擎注册的各系统相同的访问声明，节点本身不做工作，测量调度开销
+ */
+void BM_FrameGraphExecute(benchmark::State& state) {
+    FrameGraph graph;
+    std::atomic<int> executed{0};
+    const auto task = [&executed](float) { executed.fetch_add(1, std::memory_order_relaxed); };
+
+    graph.add_node("Display", Systems::DisplaySystem::storage_access(), task);
+    graph.add_node("Optics", Systems::OpticsSystem::storage_access(), task);
+    graph.add_node("Geometry", Systems::GeometrySystem::storage_access(), task);
+    graph.add_node("Kinematics", Systems::KinematicsSystem::storage_access(), task);
+    graph.add_node("Mechanics", Systems::MechanicsSystem::storage_access(), task);
+    graph.add_node("Acoustics", Systems::AcousticsSystem::storage_access(), task);
+    graph.add_node("Script", Systems::ScriptSystem::storage_access(), task);
+
+    WorkStealingPool pool(0);
+    for (auto _ : state) {
+        graph.execute(1.0f / 60.0f, pool);
+    }
+    state.counters["critical_path"] = static_cast<double>(graph.critical_path_length());
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * graph.size()));
+}
+BENCHMARK(BM_FrameGraphExecute)->UseRealTime();
+
+// ============================================================================
+// 插桩开销
+// ============================================================================
+
+void BM_ProfileZone(benchmark::State& state) {
+    const bool capturing = state.range(0) != 0;
+    if (capturing) {
+        Profiler::instance().start();
+    }
+    for (auto _ : state) {
+        ProfileZone zone("BM_ProfileZone");
+        benchmark::DoNotOptimize(&zone);
+    }
+    Profiler::instance().stop();
+    state.SetLabel(capturing ? "capturing" : "idle");
+}
+BENCHMARK(BM_ProfileZone)->Arg(0)->Arg(1);
+
+void BM_LatencyHistogramRecord(benchmark::State& state) {
+    // 多线程时共享同一个直方图，测量并发记录的开销
+    static LatencyHistogram histogram;
+    std::uint64_t seed = static_cast<std::uint64_t>(state.thread_index()) + 1;
+    for (auto _ : state) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        histogram.record_ns(seed >> 40);
+    }
+    benchmark::DoNotOptimize(histogram.count());
+}
+BENCHMARK(BM_LatencyHistogramRecord)->ThreadRange(1, 8);
+
+// ============================================================================
+// 临时内存
+// ============================================================================
+
+/**
+ * @brief 一次更新内的临时数组：逐个追加后读取一遍，range(1) 为 1 时从 FrameArena 分配
+ */
+void BM_ScratchVector(benchmark::State& state) {
+    const auto count = static_cast<std::uint32_t>(state.range(0));
+    const bool arena = state.range(1) != 0;
+    for (auto _ : state) {
+        const FrameArenaScope scratch;
+        std::pmr::vector<std::uint32_t> values(arena ? scratch.resource() : std::pmr::new_delete_resource());
+        for (std::uint32_t i = 0; i < count; ++i) {
+            values.push_back(i);
+        }
+        std::uint64_t sum = 0;
+        for (const auto value : values) {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetLabel(arena ? "frame_arena" : "new_delete");
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+BENCHMARK(BM_ScratchVector)->Args({64, 0})->Args({64, 1})->Args({4096, 0})->Args({4096, 1});
+
+/**
+ * @brief 拼接日志用的临时字符串，range(0) 为 1 时从 FrameArena 分配
+ */
+void BM_ScratchString(benchmark::State& state) {
+    const bool arena = state.range(0) != 0;
+    const std::string module = "gameplay.scripts.enemy_controller";
+    for (auto _ : state) {
+        const FrameArenaScope scratch;
+        std::pmr::string text(arena ? scratch.resource() : std::pmr::new_delete_resource());
+        for (int i = 0; i < 16; ++i) {
+            if (!text.empty()) {
+                text += ", ";
+            }
+            text += module;
+        }
+        benchmark::DoNotOptimize(text.data());
+    }
+    state.SetLabel(arena ? "frame_arena" : "new_delete");
+}
+BENCHMARK(BM_ScratchString)->Arg(0)->Arg(1);
+
+}  // namespace
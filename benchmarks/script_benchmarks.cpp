@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+#include <corona/systems/script/corona_engine_api.h>
+#include <nanobind/nanobind.h>
+
+#include <array>
+
+extern "C" PyObject* PyInit_CoronaEngine();
+
+namespace {
+
+namespace nb = nanobind;
+
+/**
+ * @brief 在基准进程中嵌入解释器并导入 CoronaEngine 模块，进程退出前不关闭
+ */
+nb::module_& engine_module() {
+    static nb::module_ module = [] {
+        if (!Py_IsInitialized()) {
+            PyImport_AppendInittab("CoronaEngine", &PyInit_CoronaEngine);
+            Py_Initialize();
+        }
+        return nb::module_::import_("CoronaEngine");
+    }();
+    return module;
+}
+
+// 场景中没有力学物体时 raycast 直接返回，三组基准的差值即为绑定层与解释器的开销
+
+void BM_PythonCallBuiltin(benchmark::State& state) {
+    engine_module();
+    nb::object len = nb::module_::import_("builtins").attr("len");
+    nb::list values;
+    values.append(1.0f);
+
+    for (auto _ : state) {
+        nb::object result = len(values);
+        benchmark::DoNotOptimize(result.ptr());
+    }
+}
+BENCHMARK(BM_PythonCallBuiltin);
+
+void BM_PythonBindingRaycast(benchmark::State& state) {
+    nb::object raycast = engine_module().attr("raycast");
+    nb::list origin;
+    nb::list direction;
+    for (const float value : {0.0f, 10.0f, 0.0f}) {
+        origin.append(value);
+    }
+    for (const float value : {0.0f, -1.0f, 0.0f}) {
+        direction.append(value);
+    }
+
+    for (auto _ : state) {
+        nb::object hit = raycast(origin, direction);
+        benchmark::DoNotOptimize(hit.ptr());
+    }
+}
+BENCHMARK(BM_PythonBindingRaycast);
+
+void BM_ApiRaycastDirect(benchmark::State& state) {
+    const std::array<float, 3> origin{0.0f, 10.0f, 0.0f};
+    const std::array<float, 3> direction{0.0f, -1.0f, 0.0f};
+
+    for (auto _ : state) {
+        auto hit = Corona::API::raycast(origin, direction);
+        benchmark::DoNotOptimize(hit);
+    }
+}
+BENCHMARK(BM_ApiRaycastDirect);
+
+}  // namespace
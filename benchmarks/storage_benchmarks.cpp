@@ -0,0 +1,508 @@
+#include <benchmark/benchmark.h>
+#include <corona/shared_data_hub.h>
+#include <corona/transform_store.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+using MechanicsStorage = Corona::SharedDataHub::MechanicsStorage;
+using UnderlyingMechanicsStorage = Corona::Kernel::Utils::Storage<Corona::MechanicsDevice, 128, 2>;  ///< MechanicsStorage 的底层存储
+
+// ============================================================================
+// DenseStorage
+// ============================================================================
+
+void BM_StorageAllocateDeallocate(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    MechanicsStorage storage;
+    std::vector<std::uintptr_t> handles(count);
+
+    for (auto _ : state) {
+        for (auto& handle : handles) {
+            handle = storage.allocate();
+        }
+        for (const auto handle : handles) {
+            storage.deallocate(handle);
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+BENCHMARK(BM_StorageAllocateDeallocate)->Arg(1 << 10)->Arg(1 << 14);
+
+/**
+ * @brief 向新建的存储分配对象，range(1) 为 1 时先在计时之外预留容量（模拟关卡加载前预留）
+ */
+void BM_StorageAllocateFresh(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const bool reserved = state.range(1) != 0;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto storage = std::make_unique<MechanicsStorage>();
+        if (reserved) {
+            storage->reserve(count);
+        }
+        state.ResumeTiming();
+
+        for (std::size_t i = 0; i < count; ++i) {
+            benchmark::DoNotOptimize(storage->allocate());
+        }
+
+        state.PauseTiming();
+        storage.reset();
+        state.ResumeTiming();
+    }
+    state.SetLabel(reserved ? "reserved" : "incremental");
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+BENCHMARK(BM_StorageAllocateFresh)->Args({1 << 14, 0})->Args({1 << 14, 1})->Args({1 << 18, 0})->Args({1 << 18, 1});
+
+void BM_StorageAcquireRead(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    MechanicsStorage storage;
+    std::vector<std::uintptr_t> handles(count);
+    for (auto& handle : handles) {
+        handle = storage.allocate();
+    }
+
+    for (auto _ : state) {
+        float mass = 0.0f;
+        for (const auto handle : handles) {
+            if (auto device = storage.acquire_read(handle)) {
+                mass += device->mass;
+            }
+        }
+        benchmark::DoNotOptimize(mass);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+
+    for (const auto handle : handles) {
+        storage.deallocate(handle);
+    }
+}
+BENCHMARK(BM_StorageAcquireRead)->Arg(1 << 10)->Arg(1 << 14);
+
+void BM_StorageAcquireWrite(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    MechanicsStorage storage;
+    std::vector<std::uintptr_t> handles(count);
+    for (auto& handle : handles) {
+        handle = storage.allocate();
+    }
+
+    for (auto _ : state) {
+        for (const auto handle : handles) {
+            if (auto device = storage.acquire_write(handle)) {
+                device->sleep_timer += 1.0f;
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+
+    for (const auto handle : handles) {
+        storage.deallocate(handle);
+    }
+}
+BENCHMARK(BM_StorageAcquireWrite)->Arg(1 << 10)->Arg(1 << 14);
+
+void BM_StorageSnapshotHandles(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    MechanicsStorage storage;
+    std::vector<std::uintptr_t> handles(count);
+    for (auto& handle : handles) {
+        handle = storage.allocate();
+    }
+
+    std::vector<std::uintptr_t> snapshot;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(storage.snapshot_handles(snapshot));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+
+    for (const auto handle : handles) {
+        storage.deallocate(handle);
+    }
+}
+BENCHMARK(BM_StorageSnapshotHandles)->Arg(1 << 10)->Arg(1 << 14);
+
+/**
+ * @brief 遍历全部对象与按句柄逐个读取的对照
+ *
+ * range(1) 选择访问方式：
+ * - 0：按存储的对象顺序整体遍历（底层 Storage 的迭代器，与光学场景遍历相同）；
+ * - 1：每帧 snapshot_handles 后按紧凑句柄数组逐个 acquire_read（系统每帧取句柄的做法）；
+ * - 2：对调用方早已持有、顺序被打乱的句柄逐个 acquire_read（按句柄零散查询）。
+ */
+void BM_StorageIterateVsLookup(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto mode = state.range(1);
+    MechanicsStorage storage;
+    std::vector<std::uintptr_t> handles(count);
+    for (auto& handle : handles) {
+        handle = storage.allocate();
+        if (auto device = storage.acquire_write(handle)) {
+            device->mass = 1.0f;
+        }
+    }
+    std::shuffle(handles.begin(), handles.end(), std::mt19937{42});
+
+    std::vector<std::uintptr_t> snapshot;
+    for (auto _ : state) {
+        float mass = 0.0f;
+        if (mode == 0) {
+            for (const auto& device : storage) {
+                mass += device.mass;
+            }
+        } else {
+            if (mode == 1) {
+                storage.snapshot_handles(snapshot);
+            }
+            for (const auto handle : mode == 1 ? snapshot : handles) {
+                if (auto device = storage.acquire_read(handle)) {
+                    mass += device->mass;
+                }
+            }
+        }
+        benchmark::DoNotOptimize(mass);
+    }
+    constexpr const char* kLabels[] = {"iterate", "snapshot+acquire_read", "acquire_read"};
+    state.SetLabel(kLabels[mode]);
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+
+    for (const auto handle : handles) {
+        storage.deallocate(handle);
+    }
+}
+BENCHMARK(BM_StorageIterateVsLookup)->ArgsProduct({{1 << 10, 1 << 14, 1 << 18}, {0, 1, 2}});
+
+/**
+ * @brief 一半句柄已释放并被新对象复用槽位，逐个检查句柄是否仍然有效
+ */
+std::vector<std::uintptr_t> make_half_stale_handles(MechanicsStorage& storage, std::size_t count) {
+    std::vector<std::uintptr_t> handles(count);
+    for (auto& handle : handles) {
+        handle = storage.allocate();
+    }
+    for (std::size_t i = 0; i < count; i += 2) {
+        storage.deallocate(handles[i]);
+    }
+    for (std::size_t i = 0; i < count; i += 2) {
+        storage.allocate();
+    }
+    std::shuffle(handles.begin(), handles.end(), std::mt19937{42});
+    return handles;
+}
+
+void BM_StorageHandleCheckGeneration(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    MechanicsStorage storage;
+    const auto handles = make_half_stale_handles(storage, count);
+
+    for (auto _ : state) {
+        std::size_t valid = 0;
+        for (const auto handle : handles) {
+            valid += storage.is_valid(handle) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(valid);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+BENCHMARK(BM_StorageHandleCheckGeneration)->Arg(1 << 10)->Arg(1 << 14)->Arg(1 << 18);
+
+/**
+ * @brief 对照组：分代句柄之前的做法，直接以底层 Kernel::Utils::Storage 的句柄 acquire_read 并检查空访问器
+ *
+ * 与 make_half_stale_handles 相同：一半对象释放后由新分配复用。底层 Storage 无法识别复用了同一位置的
+ * 过期句柄，计数因此偏多，这正是分代句柄要解决的问题；这里只比较每次检查的耗时。
+ */
+void BM_StorageHandleCheckUnderlying(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    UnderlyingMechanicsStorage storage;
+    std::vector<std::uintptr_t> handles(count);
+    for (auto& handle : handles) {
+        handle = static_cast<std::uintptr_t>(storage.allocate());
+    }
+    for (std::size_t i = 0; i < count; i += 2) {
+        storage.deallocate(handles[i]);
+    }
+    for (std::size_t i = 0; i < count; i += 2) {
+        storage.allocate();
+    }
+    std::shuffle(handles.begin(), handles.end(), std::mt19937{42});
+
+    for (auto _ : state) {
+        std::size_t valid = 0;
+        for (const auto handle : handles) {
+            valid += storage.acquire_read(handle) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(valid);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+BENCHMARK(BM_StorageHandleCheckUnderlying)->Arg(1 << 10)->Arg(1 << 14)->Arg(1 << 18);
+
+/**
+ * @brief 通过过期与有效混合的句柄读取，过期句柄得到空访问器
+ */
+void BM_StorageAcquireReadHalfStale(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    MechanicsStorage storage;
+    const auto handles = make_half_stale_handles(storage, count);
+
+    for (auto _ : state) {
+        float mass = 0.0f;
+        for (const auto handle : handles) {
+            if (auto device = storage.acquire_read(handle)) {
+                mass += device->mass;
+            }
+        }
+        benchmark::DoNotOptimize(mass);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+BENCHMARK(BM_StorageAcquireReadHalfStale)->Arg(1 << 10)->Arg(1 << 14)->Arg(1 << 18);
+
+// ============================================================================
+// ModelTransform
+// ============================================================================
+
+Corona::ModelTransform make_transform() {
+    Corona::ModelTransform transform;
+    transform.position.x = 1.0f;
+    transform.position.y = 2.0f;
+    transform.position.z = 3.0f;
+    transform.euler_rotation.x = 0.3f;
+    transform.euler_rotation.y = 1.1f;
+    transform.euler_rotation.z = -0.7f;
+    transform.previous_position = transform.position;
+    transform.previous_euler_rotation.x = 0.2f;
+    transform.previous_euler_rotation.y = 1.0f;
+    transform.previous_euler_rotation.z = -0.6f;
+    return transform;
+}
+
+void BM_ModelTransformComputeMatrix(benchmark::State& state) {
+    Corona::ModelTransform transform = make_transform();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(&transform);
+        auto matrix = transform.compute_matrix();
+        benchmark::DoNotOptimize(matrix);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+BENCHMARK(BM_ModelTransformComputeMatrix);
+
+void BM_ModelTransformComputeInterpolatedMatrix(benchmark::State& state) {
+    Corona::ModelTransform transform = make_transform();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(&transform);
+        auto matrix = transform.compute_interpolated_matrix(0.5f);
+        benchmark::DoNotOptimize(matrix);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+BENCHMARK(BM_ModelTransformComputeInterpolatedMatrix);
+
+// ============================================================================
+// TransformStore：缓存世界矩阵，每帧批量重算脏条目
+// ============================================================================
+
+std::vector<Corona::ModelTransform> make_transforms(std::size_t count) {
+    std::vector<Corona::ModelTransform> transforms(count, make_transform());
+    for (std::size_t i = 0; i < count; ++i) {
+        transforms[i].position.x = static_cast<float>(i % 1000);
+        transforms[i].position.z = static_cast<float>(i / 1000);
+        transforms[i].euler_rotation.y = static_cast<float>(i) * 0.001f;
+    }
+    return transforms;
+}
+
+Corona::TransformStore make_store(const std::vector<Corona::ModelTransform>& transforms) {
+    Corona::TransformStore store;
+    store.resize(transforms.size());
+    for (std::size_t i = 0; i < transforms.size(); ++i) {
+        store.set(i, transforms[i].position, transforms[i].euler_rotation, transforms[i].scale);
+    }
+    store.update_world_matrices();
+    return store;
+}
+
+/**
+ * @brief 对照组：每个变换每帧调用一次 compute_matrix
+ */
+void BM_ModelTransformRecomputeAll(benchmark::State& state) {
+    const auto transforms = make_transforms(static_cast<std::size_t>(state.range(0)));
+    std::vector<ktm::fmat4x4> matrices(transforms.size());
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < transforms.size(); ++i) {
+            matrices[i] = transforms[i].compute_matrix();
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * transforms.size()));
+}
+BENCHMARK(BM_ModelTransformRecomputeAll)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+void BM_TransformStoreUpdateAll(benchmark::State& state) {
+    auto store = make_store(make_transforms(static_cast<std::size_t>(state.range(0))));
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < store.size(); ++i) {
+            store.mark_dirty(i);
+        }
+        benchmark::DoNotOptimize(store.update_world_matrices());
+    }
+    state.counters["lanes"] = static_cast<double>(Corona::TransformStore::lane_width());
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * store.size()));
+}
+BENCHMARK(BM_TransformStoreUpdateAll)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+void BM_TransformStoreUpdateAllScalar(benchmark::State& state) {
+    auto store = make_store(make_transforms(static_cast<std::size_t>(state.range(0))));
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < store.size(); ++i) {
+            store.mark_dirty(i);
+        }
+        benchmark::DoNotOptimize(store.update_world_matrices_scalar());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * store.size()));
+}
+BENCHMARK(BM_TransformStoreUpdateAllScalar)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief 典型帧：全部变换经 set() 写入，其中 1% 的数值发生变化
+ */
+void BM_TransformStoreUpdateOnePercent(benchmark::State& state) {
+    auto transforms = make_transforms(static_cast<std::size_t>(state.range(0)));
+    auto store = make_store(transforms);
+    const std::size_t stride = 100;
+
+    std::size_t frame = 0;
+    for (auto _ : state) {
+        for (std::size_t i = frame % stride; i < transforms.size(); i += stride) {
+            transforms[i].position.y += 0.01f;
+        }
+        for (std::size_t i = 0; i < transforms.size(); ++i) {
+            store.set(i, transforms[i].position, transforms[i].euler_rotation, transforms[i].scale);
+        }
+        benchmark::DoNotOptimize(store.update_world_matrices());
+        ++frame;
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * transforms.size()));
+}
+BENCHMARK(BM_TransformStoreUpdateOnePercent)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+// ============================================================================
+// 变换快照
+// ============================================================================
+
+/**
+ * @brief 在 SharedDataHub 中分配 count 个变换，析构时释放
+ */
+class HubTransforms {
+   public:
+    explicit HubTransforms(std::size_t count) : handles_(count) {
+        auto& storage = Corona::SharedDataHub::instance().model_transform_storage();
+        for (auto& handle : handles_) {
+            handle = storage.allocate();
+            if (auto transform = storage.acquire_write(handle)) {
+                *transform = make_transform();
+            }
+        }
+        // 读者按帧内无序的句柄查找，打乱后避免顺序访问掩盖查找开销
+        std::shuffle(handles_.begin(), handles_.end(), std::mt19937{42});
+    }
+
+    ~HubTransforms() {
+        auto& storage = Corona::SharedDataHub::instance().model_transform_storage();
+        for (const auto handle : handles_) {
+            storage.deallocate(handle);
+        }
+    }
+
+    HubTransforms(const HubTransforms&) = delete;
+    HubTransforms& operator=(const HubTransforms&) = delete;
+
+    [[nodiscard]] const std::vector<std::uintptr_t>& handles() const {
+        return handles_;
+    }
+
+   private:
+    std::vector<std::uintptr_t> handles_;
+};
+
+void BM_TransformSnapshotPublish(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    HubTransforms transforms(count);
+    auto& hub = Corona::SharedDataHub::instance();
+
+    std::uint64_t frame = 0;
+    for (auto _ : state) {
+        hub.publish_model_transforms(++frame);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+BENCHMARK(BM_TransformSnapshotPublish)->Arg(1 << 10)->Arg(1 << 14);
+
+/**
+ * @brief 读者逐个加锁读取变换存储，作为快照查找的对照
+ */
+void BM_TransformReadLocked(benchmark::State& state) {
+    // 多线程时共享同一组变换，测量并发读者之间的争用
+    static std::unique_ptr<HubTransforms> transforms;
+    if (state.thread_index() == 0) {
+        transforms = std::make_unique<HubTransforms>(static_cast<std::size_t>(state.range(0)));
+    }
+    const auto& storage = Corona::SharedDataHub::instance().model_transform_storage();
+
+    for (auto _ : state) {
+        float sum = 0.0f;
+        for (const auto handle : transforms->handles()) {
+            if (auto transform = storage.acquire_read(handle)) {
+                sum += transform->position.x;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * state.range(0)));
+
+    if (state.thread_index() == 0) {
+        transforms.reset();
+    }
+}
+BENCHMARK(BM_TransformReadLocked)->Arg(1 << 10)->Arg(1 << 14)->ThreadRange(1, 4);
+
+void BM_TransformReadSnapshot(benchmark::State& state) {
+    static std::unique_ptr<HubTransforms> transforms;
+    if (state.thread_index() == 0) {
+        transforms = std::make_unique<HubTransforms>(static_cast<std::size_t>(state.range(0)));
+        Corona::SharedDataHub::instance().publish_model_transforms(0);
+    }
+
+    for (auto _ : state) {
+        const auto snapshot = Corona::SharedDataHub::instance().model_transform_snapshot();
+        float sum = 0.0f;
+        for (const auto handle : transforms->handles()) {
+            if (const auto* transform = snapshot->find(handle)) {
+                sum += transform->position.x;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * state.range(0)));
+
+    if (state.thread_index() == 0) {
+        transforms.reset();
+    }
+}
+BENCHMARK(BM_TransformReadSnapshot)->Arg(1 << 10)->Arg(1 << 14)->ThreadRange(1, 4);
+
+}  // namespace
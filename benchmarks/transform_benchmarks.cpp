@@ -0,0 +1,139 @@
+#include <benchmark/benchmark.h>
+#include <corona/transform_hierarchy.h>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+using Corona::TransformHierarchy;
+
+// ============================================================================
+// TransformHierarchy：深度优先顺序的父子变换传播
+// ============================================================================
+
+enum class Shape : std::int64_t {
+    Wide = 0,  ///< 32 叉平衡树，深度约 4
+    Deep = 1,  ///< 1000 条长度为 100 的链
+};
+
+ktm::fmat4x4 make_local(float x, float angle) {
+    ktm::fmat4x4 matrix;
+    const float c = std::cos(angle);
+    const float s = std::sin(angle);
+    for (int col = 0; col < 4; ++col) {
+        for (int row = 0; row < 4; ++row) {
+            matrix[col][row] = col == row ? 1.0f : 0.0f;
+        }
+    }
+    matrix[0][0] = c;
+    matrix[0][2] = -s;
+    matrix[2][0] = s;
+    matrix[2][2] = c;
+    matrix[3][0] = x;
+    return matrix;
+}
+
+TransformHierarchy make_hierarchy(std::size_t count, Shape shape) {
+    TransformHierarchy hierarchy;
+    hierarchy.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint32_t parent = TransformHierarchy::kNoParent;
+        if (shape == Shape::Wide && i > 0) {
+            parent = static_cast<std::uint32_t>((i - 1) / 32);
+        } else if (shape == Shape::Deep && i % 100 != 0) {
+            parent = static_cast<std::uint32_t>(i - 1);
+        }
+        hierarchy.set_parent(i, parent);
+        hierarchy.set_local(i, make_local(0.1f, static_cast<float>(i % 7) * 0.01f));
+    }
+    hierarchy.update();
+    return hierarchy;
+}
+
+const char* shape_label(Shape shape) {
+    return shape == Shape::Wide ? "wide" : "deep";
+}
+
+/**
+ * @brief 每帧随机 1% 的节点改变局部矩阵，只重算其子树
+ */
+void BM_TransformHierarchyUpdateOnePercent(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto shape = static_cast<Shape>(state.range(1));
+    auto hierarchy = make_hierarchy(count, shape);
+
+    std::mt19937 rng{7};
+    std::uniform_int_distribution<std::size_t> pick(0, count - 1);
+    const std::size_t movers = count / 100;
+
+    std::size_t recomputed = 0;
+    float angle = 0.0f;
+    for (auto _ : state) {
+        angle += 0.01f;
+        for (std::size_t i = 0; i < movers; ++i) {
+            hierarchy.set_local(pick(rng), make_local(0.1f, angle));
+        }
+        recomputed += hierarchy.update();
+    }
+    benchmark::DoNotOptimize(hierarchy.world(count - 1));
+    state.counters["recomputed_per_frame"] = static_cast<double>(recomputed) / static_cast<double>(state.iterations());
+    state.SetLabel(shape_label(shape));
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+BENCHMARK(BM_TransformHierarchyUpdateOnePercent)
+    ->Args({100000, static_cast<std::int64_t>(Shape::Wide)})
+    ->Args({100000, static_cast<std::int64_t>(Shape::Deep)})
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief 对照组：每帧从根节点重新传播整棵层级
+ */
+void BM_TransformHierarchyUpdateAll(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto shape = static_cast<Shape>(state.range(1));
+    auto hierarchy = make_hierarchy(count, shape);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (hierarchy.parent(i) == TransformHierarchy::kNoParent) {
+                hierarchy.set_local(i, hierarchy.local(i));
+            }
+        }
+        benchmark::DoNotOptimize(hierarchy.update());
+    }
+    state.SetLabel(shape_label(shape));
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+BENCHMARK(BM_TransformHierarchyUpdateAll)
+    ->Args({100000, static_cast<std::int64_t>(Shape::Wide)})
+    ->Args({100000, static_cast<std::int64_t>(Shape::Deep)})
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief 改变父子关系后重建深度优先顺序并全部传播
+ */
+void BM_TransformHierarchyRebuild(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto shape = static_cast<Shape>(state.range(1));
+    auto hierarchy = make_hierarchy(count, shape);
+
+    const std::size_t node = count / 2 + 1;  // 两种形状下都不是根节点
+    const std::uint32_t parent = hierarchy.parent(node);
+    bool detached = false;
+    for (auto _ : state) {
+        detached = !detached;
+        hierarchy.set_parent(node, detached ? TransformHierarchy::kNoParent : parent);
+        benchmark::DoNotOptimize(hierarchy.update());
+    }
+    state.SetLabel(shape_label(shape));
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+BENCHMARK(BM_TransformHierarchyRebuild)
+    ->Args({100000, static_cast<std::int64_t>(Shape::Wide)})
+    ->Args({100000, static_cast<std::int64_t>(Shape::Deep)})
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
@@ -2,7 +2,10 @@
 #include <corona/systems/script/python_api.h>
 
 #include <csignal>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
+#include <string_view>
 #include <thread>
 
 // 全局引擎实例指针，用于信号处理
@@ -22,13 +25,39 @@ void signal_handler(int signal) {
     }
 }
 
+/**
+ * @brief 批量模拟参数（--headless <帧数> [--dt <秒>] [--speed <倍数>]）
+ */
+struct HeadlessOptions {
+    bool enabled = false;
+    std::uint64_t frames = 0;
+    float fixed_dt = 1.0f / 60.0f;
+    double time_scale = 0.0;  ///< 0 表示尽可能快
+};
+
+HeadlessOptions parse_headless_options(int argc, char* argv[]) {
+    HeadlessOptions options;
+    for (int i = 1; i + 1 < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--headless") {
+            options.enabled = true;
+            options.frames = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--dt") {
+            options.fixed_dt = std::strtof(argv[++i], nullptr);
+        } else if (arg == "--speed") {
+            options.time_scale = std::strtod(argv[++i], nullptr);
+        }
+    }
+    return options;
+}
+
 /**
  * @brief CoronaEngine 主程序
  *
  * 功能：
  * 1. 初始化 CoronaEngine
  * 2. 注册信号处理器
- * 3. 启动主循环
+ * 3. 启动主循环（或以 --headless 批量运行指定帧数）
  * 4. 优雅关闭引擎
  */
 int main(int argc, char* argv[]) {
@@ -42,8 +71,11 @@ int main(int argc, char* argv[]) {
     std::cout << "    +==================================================================+" << std::endl;
     std::cout << std::endl;
 
+    const HeadlessOptions headless = parse_headless_options(argc, argv);
+
     // 创建引擎实例
     Corona::Engine engine;
+    engine.set_headless(headless.enabled);
     g_engine = &engine;
 
     // 注册信号处理器
@@ -63,24 +95,35 @@ int main(int argc, char* argv[]) {
     std::cout << "[Main] Engine initialized successfully" << std::endl;
     std::cout << std::endl;
 
-    // ========================================
-    // 2. 启动主循环（在独立线程）
-    // ========================================
-    std::cout << "[Main] Starting engine main loop..." << std::endl;
-    std::cout << "[Main] Press Ctrl+C to exit" << std::endl;
-    std::cout << std::endl;
-
-    // 在独立线程运行引擎主循环
-    std::thread engine_thread([&engine]() {
-        engine.run();
-    });
-
-    // ========================================
-    // 3. 等待用户输入或信号中断
-    // ========================================
-
-    // 等待引擎线程结束（用户按 Ctrl+C 或调用 request_exit()）
-    engine_thread.join();
+    if (headless.enabled) {
+        // ========================================
+        // 2. 无头批量模拟
+        // ========================================
+        std::cout << "[Main] Running " << headless.frames << " headless frames..." << std::endl;
+
+        const auto stats = engine.run_frames(headless.frames, headless.fixed_dt, headless.time_scale);
+        std::cout << "[Main] " << stats.frames << " frames in " << stats.wall_seconds << " s ("
+                  << stats.frames_per_second << " frames/s, " << stats.realtime_factor << "x real time)" << std::endl;
+    } else {
+        // ========================================
+        // 2. 启动主循环（在独立线程）
+        // ========================================
+        std::cout << "[Main] Starting engine main loop..." << std::endl;
+        std::cout << "[Main] Press Ctrl+C to exit" << std::endl;
+        std::cout << std::endl;
+
+        // 在独立线程运行引擎主循环
+        std::thread engine_thread([&engine]() {
+            engine.run();
+        });
+
+        // ========================================
+        // 3. 等待用户输入或信号中断
+        // ========================================
+
+        // 等待引擎线程结束（用户按 Ctrl+C 或调用 request_exit()）
+        engine_thread.join();
+    }
 
     // ========================================
     // 4. 关闭引擎
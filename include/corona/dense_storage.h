@@ -0,0 +1,355 @@
+#pragma once
+#include <corona/kernel/utils/storage.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+namespace Corona {
+
+/**
+ * @brief 预留容量用尽后的增长方式
+ */
+enum class StorageGrowth : std::uint8_t {
+    Incremental,  ///< 由底层 Storage 按块逐次增长（默认）
+    Geometric,    ///< 一次预留到当前容量的两倍
+    Linear,       ///< 一次预留 growth_step 个对象
+};
+
+/**
+ * @brief DenseStorage 的容量配置
+ */
+struct StorageConfig {
+    std::size_t capacity = 0;                           ///< 预留的对象数量
+    StorageGrowth growth = StorageGrowth::Incremental;  ///< 预留容量用尽后的增长方式
+    std::size_t growth_step = 1024;                     ///< 每次增长的最少对象数量
+};
+
+/**
+ * @brief 带分代句柄与紧凑句柄列表的 Storage
+ *
+ * 对外句柄为 64 位：低 32 位是槽位下标，高 32 位是槽位的代数（从 1 开始，句柄永不为 0）。
+ * 槽位记录底层 Kernel::Utils::Storage 的句柄，释放时代数加一，
+ * 因此过期句柄在 acquire_read/acquire_write 时只需一次下标寻址与一次代数比较即被拒绝，
+ * 不会再指向复用同一位置的新对象。取得底层访问器后会再比较一次代数，
+ * 检查与获取之间句柄被其他线程释放（对象随后被新分配复用）时同样返回空访问器。
+ * 槽位按固定大小的页分配且页表不搬移，读取路径无需加锁；下标经空闲链表复用。
+ *
+ * 同时维护一份与 allocate/deallocate 同步的活动句柄数组，使系统可以在每帧开始时
+ * 一次性取得全部句柄并顺序遍历，而不必在成对访问时反复查询。
+ * 句柄列表采用 swap-remove 保持紧凑，version() 在每次分配/释放后递增，
+ * 调用方可据此判断是否需要重新拷贝句柄列表。
+ *
+ * reserve() 预先分配槽位页与句柄数组，并让底层 Storage 分配再释放相应数量的对象，
+ * 使其块留在内存池中（底层 Storage 释放对象后保留块以供复用），关卡加载前调用可避免帧中增长。
+ * configure() 设置初始预留容量与用尽后的增长方式；预留用尽后在 allocate() 中的自动增长
+ * 只扩展槽位页与句柄数组，底层 Storage 照常按块增长，不在持锁期间批量构造对象。
+ * 底层的块容量与内存池参数是编译期模板参数。
+ */
+template <typename T, auto... StorageArgs>
+class DenseStorage : public Kernel::Utils::Storage<T, StorageArgs...> {
+    using Base = Kernel::Utils::Storage<T, StorageArgs...>;
+
+    static_assert(sizeof(std::uintptr_t) >= sizeof(std::uint64_t), "分代句柄需要 64 位 std::uintptr_t");
+
+   public:
+    using Base::Base;
+
+    static constexpr std::uint32_t kPageBits = 12;
+    static constexpr std::uint32_t kPageSize = 1u << kPageBits;
+    static constexpr std::uint32_t kMaxPages = 4096;
+    static constexpr std::uint32_t kMaxSlots = kPageSize * kMaxPages;
+
+    /**
+     * @brief 句柄中的槽位下标
+     */
+    [[nodiscard]] static constexpr std::uint32_t handle_index(std::uintptr_t handle) {
+        return static_cast<std::uint32_t>(handle & 0xFFFFFFFFu);
+    }
+
+    /**
+     * @brief 句柄中的代数
+     */
+    [[nodiscard]] static constexpr std::uint32_t handle_generation(std::uintptr_t handle) {
+        return static_cast<std::uint32_t>(static_cast<std::uint64_t>(handle) >> 32);
+    }
+
+    /**
+     * @brief 分配对象并登记句柄
+     * @return 分代句柄，失败时为 0
+     */
+    std::uintptr_t allocate() {
+        const auto object = static_cast<std::uintptr_t>(Base::allocate());
+        if (object == 0) {
+            return 0;
+        }
+
+        std::unique_lock lock(handles_mutex_);
+        std::uint32_t index;
+        if (!free_slots_.empty()) {
+            index = free_slots_.back();
+            free_slots_.pop_back();
+        } else {
+            index = slot_count_.load(std::memory_order_relaxed);
+            if (index >= kMaxSlots) {
+                lock.unlock();
+                Base::deallocate(object);
+                return 0;
+            }
+            auto& page = pages_[index >> kPageBits];
+            if (!page) {
+                page = std::make_unique<Slot[]>(kPageSize);
+            }
+            slot_count_.store(index + 1, std::memory_order_release);
+        }
+
+        Slot& slot = slot_at(index);
+        slot.object.store(object, std::memory_order_release);
+        slot.dense = static_cast<std::uint32_t>(handles_.size());
+        const std::uintptr_t handle =
+            (static_cast<std::uintptr_t>(slot.generation.load(std::memory_order_relaxed)) << 32) | index;
+        handles_.push_back(handle);
+        version_.fetch_add(1, std::memory_order_release);
+
+        if (config_.growth != StorageGrowth::Incremental && handles_.size() >= capacity_) {
+            const std::size_t step = std::max<std::size_t>(config_.growth_step, 1);
+            const std::size_t target = config_.growth == StorageGrowth::Geometric
+                                           ? std::max(capacity_ * 2, handles_.size() + step)
+                                           : handles_.size() + step;
+            // 帧中自动增长只扩展槽位页与句柄数组，不预热底层 Storage，避免在持锁期间构造大量对象
+            reserve_slots_locked(target);
+        }
+        return handle;
+    }
+
+    /**
+     * @brief 注销句柄并释放对象
+     * @return 句柄有效并被释放时为 true；过期或无效句柄不做任何事
+     */
+    bool deallocate(std::uintptr_t handle) {
+        std::uintptr_t object = 0;
+        {
+            std::unique_lock lock(handles_mutex_);
+            if (resolve(handle) == 0) {
+                return false;
+            }
+            Slot& slot = slot_at(handle_index(handle));
+            std::uint32_t generation = slot.generation.load(std::memory_order_relaxed) + 1;
+            if (generation == 0) {
+                generation = 1;
+            }
+            slot.generation.store(generation, std::memory_order_release);
+            object = slot.object.exchange(0, std::memory_order_acq_rel);
+
+            const std::uintptr_t last = handles_.back();
+            handles_[slot.dense] = last;
+            slot_at(handle_index(last)).dense = slot.dense;
+            handles_.pop_back();
+            free_slots_.push_back(handle_index(handle));
+            version_.fetch_add(1, std::memory_order_release);
+        }
+        Base::deallocate(object);
+        return true;
+    }
+
+    /**
+     * @brief 句柄是否仍指向存活对象（一次代数比较，无锁）
+     */
+    [[nodiscard]] bool is_valid(std::uintptr_t handle) const {
+        return resolve(handle) != 0;
+    }
+
+    /**
+     * @brief 以分代句柄读取对象，过期句柄得到空访问器
+     */
+    auto acquire_read(std::uintptr_t handle) const {
+        const std::uintptr_t object = resolve(handle);
+        if (object == 0) {
+            return decltype(Base::acquire_read(object)){};
+        }
+        auto accessor = Base::acquire_read(object);
+        if (!still_resolves(handle, object)) {
+            return decltype(accessor){};
+        }
+        return accessor;
+    }
+
+    auto acquire_read(std::uintptr_t handle) {
+        const std::uintptr_t object = resolve(handle);
+        if (object == 0) {
+            return decltype(Base::acquire_read(object)){};
+        }
+        auto accessor = Base::acquire_read(object);
+        if (!still_resolves(handle, object)) {
+            return decltype(accessor){};
+        }
+        return accessor;
+    }
+
+    /**
+     * @brief 以分代句柄写入对象，过期句柄得到空访问器
+     */
+    auto acquire_write(std::uintptr_t handle) {
+        const std::uintptr_t object = resolve(handle);
+        if (object == 0) {
+            return decltype(Base::acquire_write(object)){};
+        }
+        auto accessor = Base::acquire_write(object);
+        if (!still_resolves(handle, object)) {
+            return decltype(accessor){};
+        }
+        return accessor;
+    }
+
+    /**
+     * @brief 设置容量配置并预留 config.capacity 个对象
+     */
+    void configure(const StorageConfig& config) {
+        std::unique_lock lock(handles_mutex_);
+        config_ = config;
+        reserve_locked(config.capacity);
+    }
+
+    [[nodiscard]] StorageConfig config() const {
+        std::shared_lock lock(handles_mutex_);
+        return config_;
+    }
+
+    /**
+     * @brief 预留容量，使活动对象数量达到 count 之前分配不再增长
+     * @return 预留后的容量
+     */
+    std::size_t reserve(std::size_t count) {
+        std::unique_lock lock(handles_mutex_);
+        reserve_locked(count);
+        return capacity_;
+    }
+
+    /**
+     * @brief 已预留的对象数量
+     */
+    [[nodiscard]] std::size_t capacity() const {
+        std::shared_lock lock(handles_mutex_);
+        return capacity_;
+    }
+
+    /**
+     * @brief 当前活动对象数量
+     */
+    [[nodiscard]] std::size_t size() const {
+        std::shared_lock lock(handles_mutex_);
+        return handles_.size();
+    }
+
+    /**
+     * @brief 句柄列表版本号，每次分配/释放后递增
+     */
+    [[nodiscard]] std::uint64_t version() const {
+        return version_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief 拷贝当前所有活动句柄
+     * @param out 输出句柄数组（会被覆盖），复用其容量避免每帧分配
+     * @return 拷贝时的版本号
+     */
+    std::uint64_t snapshot_handles(std::vector<std::uintptr_t>& out) const {
+        std::shared_lock lock(handles_mutex_);
+        out.assign(handles_.begin(), handles_.end());
+        return version_.load(std::memory_order_acquire);
+    }
+
+   private:
+    struct Slot {
+        std::atomic<std::uint32_t> generation{1};
+        std::atomic<std::uintptr_t> object{0};  ///< 底层 Storage 的句柄，空闲时为 0
+        std::uint32_t dense = 0;                ///< 在 handles_ 中的下标，持有写锁时访问
+    };
+
+    [[nodiscard]] Slot& slot_at(std::uint32_t index) const {
+        return pages_[index >> kPageBits][index & (kPageSize - 1)];
+    }
+
+    // 预留槽位页与句柄数组，调用方持有写锁
+    void reserve_slots_locked(std::size_t count) {
+        count = std::min<std::size_t>(count, kMaxSlots);
+        if (count <= capacity_) {
+            return;
+        }
+
+        handles_.reserve(count);
+        free_slots_.reserve(count);
+        const std::size_t page_count = (count + kPageSize - 1) >> kPageBits;
+        for (std::size_t page = 0; page < page_count; ++page) {
+            if (!pages_[page]) {
+                pages_[page] = std::make_unique<Slot[]>(kPageSize);
+            }
+        }
+        capacity_ = count;
+    }
+
+    // 预留槽位并预热底层 Storage，只用于 reserve()/configure()，调用方持有写锁
+    void reserve_locked(std::size_t count) {
+        count = std::min<std::size_t>(count, kMaxSlots);
+        if (count <= capacity_) {
+            return;
+        }
+        reserve_slots_locked(count);
+
+        // 分配后立即释放，底层 Storage 的块留在内存池中供后续分配
+        std::vector<std::uintptr_t> objects;
+        objects.reserve(count - std::min(count, handles_.size()));
+        while (handles_.size() + objects.size() < count) {
+            const auto object = static_cast<std::uintptr_t>(Base::allocate());
+            if (object == 0) {
+                break;
+            }
+            objects.push_back(object);
+        }
+        for (const auto object : objects) {
+            Base::deallocate(object);
+        }
+    }
+
+    // 句柄有效时返回底层句柄，否则返回 0
+    [[nodiscard]] std::uintptr_t resolve(std::uintptr_t handle) const {
+        const std::uint32_t index = handle_index(handle);
+        if (index >= slot_count_.load(std::memory_order_acquire)) {
+            return 0;
+        }
+        const Slot& slot = slot_at(index);
+        const std::uint32_t generation = handle_generation(handle);
+        if (slot.generation.load(std::memory_order_acquire) != generation) {
+            return 0;
+        }
+        const std::uintptr_t object = slot.object.load(std::memory_order_acquire);
+        // 读取期间槽位被释放并复用时，代数已改变，不能返回新对象
+        if (slot.generation.load(std::memory_order_relaxed) != generation) {
+            return 0;
+        }
+        return object;
+    }
+
+    // 取得访问器后复查：resolve 与 acquire 之间句柄被释放、对象被新分配复用时代数已改变
+    [[nodiscard]] bool still_resolves(std::uintptr_t handle, std::uintptr_t object) const {
+        const Slot& slot = slot_at(handle_index(handle));
+        return slot.generation.load(std::memory_order_acquire) == handle_generation(handle) &&
+               slot.object.load(std::memory_order_acquire) == object;
+    }
+
+    mutable std::shared_mutex handles_mutex_;
+    std::vector<std::uintptr_t> handles_;  ///< 紧凑的活动句柄数组
+    std::vector<std::uint32_t> free_slots_;
+    std::unique_ptr<std::unique_ptr<Slot[]>[]> pages_ = std::make_unique<std::unique_ptr<Slot[]>[]>(kMaxPages);
+    std::atomic<std::uint32_t> slot_count_{0};
+    std::size_t capacity_ = 0;
+    StorageConfig config_;
+    std::atomic<std::uint64_t> version_{0};
+};
+
+}  // namespace Corona
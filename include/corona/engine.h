@@ -1,11 +1,44 @@
 #pragma once
 
+#include <corona/frame_graph.h>
+#include <corona/frame_pacer.h>
+#include <corona/frame_sync.h>
+#include <corona/update_budget.h>
 #include <corona/kernel/core/kernel_context.h>
 
 #include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
 
 namespace Corona {
 
+class WorkStealingPool;
+
+namespace Systems {
+class MechanicsSystem;
+}
+
+/**
+ * @brief 系统的执行方式
+ */
+enum class ExecutionMode {
+    SystemThreads,  ///< 每个系统一个专用线程，各自按目标帧率运行（默认）
+    FrameGraph,     ///< 主循环每帧按数据依赖调度系统更新，在固定大小的线程池上并行执行
+};
+
+/**
+ * @brief run_frames() 的运行结果
+ */
+struct BatchRunStats {
+    std::uint64_t frames = 0;        ///< 实际执行的帧数
+    double simulated_seconds = 0.0;  ///< 模拟时间（帧数 × 固定帧时间）
+    double wall_seconds = 0.0;       ///< 实际耗时
+    double frames_per_second = 0.0;  ///< 每秒真实时间执行的模拟帧数
+    double realtime_factor = 0.0;    ///< 模拟时间 / 实际耗时
+};
+
 /**
  * @brief CoronaEngine 主引擎类
  *
@@ -75,6 +108,20 @@ class Engine {
      */
     void run();
 
+    /**
+     * @brief 以固定帧时间运行指定帧数后返回（批量模拟）
+     *
+     * 不启动系统线程，也不按真实时间控制帧率：每帧由调用线程在线程池上按帧图顺序执行所有系统，
+     * 系统收到的帧时间恒为 fixed_dt，结果可重复。更新预算降低的有效帧率在此期间不生效，每个系统每帧都执行。
+     * 通常与 set_headless(true) 配合用于服务端模拟。
+     *
+     * @param frames 运行的帧数，request_exit() 可提前结束
+     * @param fixed_dt 每帧的模拟时间（秒）
+     * @param time_scale 大于 0 时按该倍数的实时速度运行（1 为实时），否则尽可能快
+     * @return 实际运行的帧数与每秒模拟帧数
+     */
+    BatchRunStats run_frames(std::uint64_t frames, float fixed_dt, double time_scale = 0.0);
+
     /**
      * @brief 请求退出引擎
      *
@@ -92,6 +139,112 @@ class Engine {
      */
     void shutdown();
 
+    // ========================================
+    // 执行方式
+    // ========================================
+
+    /**
+     * @brief 设置无头模式，需在 initialize() 之前调用
+     *
+     * 无头模式下不注册 DisplaySystem 与 OpticsSystem，不需要窗口和 GPU。
+     */
+    void set_headless(bool headless);
+
+    /**
+     * @brief 是否为无头模式
+     */
+    bool is_headless() const;
+
+    /**
+     * @brief 设置系统的执行方式，需在 run() 之前调用
+     *
+     * 帧图模式下系统不再各自启动线程，而是根据 storage_access() 声明的读写依赖，
+     * 由主循环每帧在按硬件线程数创建的线程池上并行执行一次 update。
+     */
+    void set_execution_mode(ExecutionMode mode);
+
+    /**
+     * @brief 获取当前的执行方式
+     */
+    ExecutionMode execution_mode() const;
+
+    /**
+     * @brief 获取帧图（包含各系统节点的依赖与最近一次执行耗时）
+     */
+    const FrameGraph& frame_graph() const;
+
+    // ========================================
+    // 帧率控制
+    // ========================================
+
+    /**
+     * @brief 获取主循环的帧率控制器
+     *
+     * 可在运行期间调整目标帧率与控制方式，并查询实际帧时间的分位数：
+     * @code
+     * engine.frame_pacer().set_target_rate(144.0);
+     * engine.frame_pacer().set_mode(Corona::PacingMode::Hybrid);
+     * auto stats = engine.frame_pacer().stats();  // stats.p99_ms ...
+     * @endcode
+     */
+    FramePacer& frame_pacer();
+    const FramePacer& frame_pacer() const;
+
+    // ========================================
+    // 帧同步
+    // ========================================
+
+    /**
+     * @brief 开启或关闭锁步，下一帧开始时生效
+     *
+     * 线程模式下开启锁步后，每个系统线程每帧恰好更新一次，并等待主循环开始下一帧；
+     * 主循环在 tick() 中等待所有系统完成本帧。帧图模式本身即按帧执行。
+     * 锁步期间（两种模式下）每帧的帧时间都是固定步长（见 set_lock_step_delta_time），
+     * 不使用实测的帧时间，提供 advance(float) 的系统因此每帧推进相同的时间，可以确定性地重放。
+     */
+    void set_lock_step(bool enabled);
+
+    /**
+     * @brief 是否请求了锁步
+     */
+    bool is_lock_step() const;
+
+    /**
+     * @brief 设置锁步时每帧的固定步长（秒）
+     * @param delta_time 小于等于 0 时使用主循环目标帧率的帧间隔，不限帧率时使用默认帧率的帧间隔
+     */
+    void set_lock_step_delta_time(float delta_time);
+
+    /**
+     * @brief 锁步时每帧实际使用的步长（秒）
+     */
+    float lock_step_delta_time() const;
+
+    /**
+     * @brief 各系统最近的更新耗时
+     */
+    std::vector<FrameSync::SystemTiming> system_timings() const;
+
+    // ========================================
+    // 更新预算
+    // ========================================
+
+    /**
+     * @brief 获取系统更新预算控制器
+     *
+     * 可设置单个系统的耗时预算、可降级的优先级阈值或关闭自动降级：
+     * @code
+     * engine.update_budget().set_budget("Mechanics", 8.0f);
+     * engine.update_budget().set_shed_priority(75);  // 只降低 Acoustics、Script 等低优先级系统
+     * @endcode
+     */
+    UpdateBudget& update_budget();
+
+    /**
+     * @brief 各系统声明的帧率、当前有效帧率与预算状态
+     */
+    std::vector<SystemRate> system_rates() const;
+
     // ========================================
     // 状态查询
     // ========================================
@@ -147,10 +300,22 @@ class Engine {
      */
     bool register_systems();
 
+    /**
+     * @brief 创建帧图模式与 run_frames() 使用的线程池
+     *
+     * 线程数不超过系统数量（更多的线程只会空等），其余核心交给力学系统的线程池
+     */
+    void start_frame_pool();
+
+    /**
+     * @brief 销毁帧线程池，力学线程池恢复默认大小
+     */
+    void stop_frame_pool();
+
     /**
      * @brief 主循环的单次迭代
      *
-     * 更新帧时间、同步系统、处理事件
+     * 广播 FrameBeginEvent，执行或同步本帧的系统更新，再广播 FrameEndEvent
      */
     void tick();
 
@@ -165,6 +330,19 @@ class Engine {
 
     uint64_t frame_number_;  ///< 当前帧号
     float last_frame_time_;  ///< 上一帧时间（秒）
+    std::atomic<float> lock_step_delta_time_;  ///< 锁步时的固定步长（秒），小于等于 0 时取目标帧率的帧间隔
+    std::atomic<bool> every_frame_;            ///< run_frames() 期间为 true：每个系统每帧都执行，不按有效帧率跳帧
+
+    bool headless_;                                  ///< 无头模式，不注册显示与光学系统
+    ExecutionMode execution_mode_;                   ///< 系统执行方式
+    FrameGraph frame_graph_;                         ///< 各系统节点，注册系统时建立
+    std::unique_ptr<WorkStealingPool> frame_pool_;  ///< 帧图模式下执行系统更新的线程池
+    Systems::MechanicsSystem* mechanics_system_;     ///< 已注册的力学系统（由系统管理器持有），用于分配工作线程
+    FramePacer frame_pacer_;                         ///< 主循环帧率控制
+    FrameSync frame_sync_;                           ///< 系统线程的锁步与更新耗时
+    UpdateBudget update_budget_;                     ///< 各系统的更新预算与有效帧率
+    std::filesystem::path trace_file_;               ///< 关闭时写入性能分析 trace 的文件（CORONA_TRACE_FILE）
+    std::filesystem::path metrics_file_;             ///< 定期写入 Prometheus 指标的文件（CORONA_METRICS_FILE）
 };
 
 }  // namespace Corona
\ No newline at end of file
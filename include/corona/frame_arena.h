@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace Corona {
+
+/**
+ * @brief 线性分配的临时内存池，供系统在一次更新内分配临时数据
+ *
+ * 分配只移动当前块内的偏移量，释放是空操作；FrameArenaScope 退出时把偏移量回卷到进入时的位置，
+ * 内存块本身保留给后续分配复用，稳态下不再向系统申请内存。当前块不足时顺延到下一块，
+ * 没有可用的块时按 block_size（或请求大小）追加新块。
+ *
+ * 每个线程各有一个实例（current()），不是线程安全的，也不应跨线程传递分配到的内存。
+ * 引擎在每个系统的每次更新外包裹一个 FrameArenaScope，因此系统在更新期间分配的临时数据
+ * 在更新结束时整体回收；在更新之外使用时由调用方自行建立作用域。
+ *
+ * resource() 提供 std::pmr::memory_resource 接口，可直接用于 std::pmr 容器：
+ * @code
+ * FrameArenaScope scratch;
+ * std::pmr::vector<std::uint32_t> stack(scratch.resource());
+ * @endcode
+ */
+class FrameArena {
+   public:
+    static constexpr std::size_t kDefaultBlockSize = 64 * 1024;
+
+    /**
+     * @brief 回卷位置，由 mark() 取得
+     */
+    struct Marker {
+        std::size_t block = 0;
+        std::size_t offset = 0;
+    };
+
+    explicit FrameArena(std::size_t block_size = kDefaultBlockSize);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /**
+     * @brief 当前线程的内存池
+     */
+    static FrameArena& current();
+
+    /**
+     * @brief 分配未初始化的内存
+     * @param alignment 对齐，必须是 2 的幂
+     */
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t));
+
+    [[nodiscard]] Marker mark() const {
+        return {block_, offset_};
+    }
+
+    /**
+     * @brief 回卷到 marker 的位置，之后分配的内存全部失效
+     *
+     * 必须按后进先出的顺序回卷，FrameArenaScope 保证了这一点。
+     */
+    void rewind(Marker marker) {
+        block_ = marker.block;
+        offset_ = marker.offset;
+    }
+
+    /**
+     * @brief 当前已分配的字节数（包括对齐与块末尾的空隙）
+     */
+    [[nodiscard]] std::size_t used() const;
+
+    /**
+     * @brief 已向系统申请的字节数
+     */
+    [[nodiscard]] std::size_t capacity() const;
+
+    [[nodiscard]] std::pmr::memory_resource* resource() {
+        return &resource_;
+    }
+
+   private:
+    class Resource final : public std::pmr::memory_resource {
+       public:
+        explicit Resource(FrameArena& arena) : arena_(arena) {}
+
+       private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            return arena_.allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+
+        FrameArena& arena_;
+    };
+
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size = 0;
+    };
+
+    std::vector<Block> blocks_;
+    std::size_t block_ = 0;   ///< 当前块下标，等于 blocks_.size() 时需要追加新块
+    std::size_t offset_ = 0;  ///< 当前块内已分配的字节数
+    std::size_t block_size_;
+    Resource resource_{*this};
+};
+
+/**
+ * @brief 在作用域内使用内存池，退出时回卷到进入时的位置
+ */
+class FrameArenaScope {
+   public:
+    explicit FrameArenaScope(FrameArena& arena = FrameArena::current()) : arena_(arena), marker_(arena.mark()) {}
+
+    ~FrameArenaScope() {
+        arena_.rewind(marker_);
+    }
+
+    FrameArenaScope(const FrameArenaScope&) = delete;
+    FrameArenaScope& operator=(const FrameArenaScope&) = delete;
+
+    [[nodiscard]] FrameArena& arena() const {
+        return arena_;
+    }
+
+    [[nodiscard]] std::pmr::memory_resource* resource() const {
+        return arena_.resource();
+    }
+
+   private:
+    FrameArena& arena_;
+    FrameArena::Marker marker_;
+};
+
+/**
+ * @brief 当前线程内存池的 std::pmr 接口，生命周期到所在的 FrameArenaScope 结束为止
+ */
+inline std::pmr::memory_resource* frame_memory_resource() {
+    return FrameArena::current().resource();
+}
+
+}  // namespace Corona
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Corona {
+
+class WorkStealingPool;
+
+/**
+ * @brief SharedDataHub 中可被系统读写的存储
+ */
+enum class StorageId : std::uint8_t {
+    ModelResource,
+    ModelTransform,
+    Geometry,
+    Kinematics,
+    Mechanics,
+    Acoustics,
+    Optics,
+    Profile,
+    Actor,
+    Camera,
+    Viewport,
+    Environment,
+    Scene,
+    Count,
+};
+
+/**
+ * @brief 系统在一次更新中对共享数据的访问声明
+ *
+ * 帧图据此推导系统间的依赖：两个系统访问同一存储且至少一方写入时按注册顺序串行，否则可以并行。
+ *
+ * @code
+ * static StorageAccess storage_access() {
+ *     return StorageAccess{}.read(StorageId::Geometry).write(StorageId::ModelTransform);
+ * }
+ * @endcode
+ */
+struct StorageAccess {
+    std::uint32_t reads = 0;
+    std::uint32_t writes = 0;
+    bool main_thread = false;  ///< 必须在驱动帧图的线程（主线程）上执行
+
+    [[nodiscard]] constexpr StorageAccess read(StorageId id) const {
+        StorageAccess result = *this;
+        result.reads |= bit(id);
+        return result;
+    }
+
+    [[nodiscard]] constexpr StorageAccess write(StorageId id) const {
+        StorageAccess result = *this;
+        result.writes |= bit(id);
+        return result;
+    }
+
+    [[nodiscard]] constexpr StorageAccess on_main_thread() const {
+        StorageAccess result = *this;
+        result.main_thread = true;
+        return result;
+    }
+
+    /**
+     * @brief 读写全部存储，与所有系统串行
+     */
+    [[nodiscard]] static constexpr StorageAccess all() {
+        StorageAccess result;
+        result.reads = (1u << static_cast<std::uint32_t>(StorageId::Count)) - 1u;
+        result.writes = result.reads;
+        return result;
+    }
+
+    [[nodiscard]] constexpr bool conflicts_with(const StorageAccess& other) const {
+        return (writes & (other.reads | other.writes)) != 0 || (other.writes & reads) != 0;
+    }
+
+   private:
+    static constexpr std::uint32_t bit(StorageId id) {
+        return 1u << static_cast<std::uint32_t>(id);
+    }
+};
+
+/**
+ * @brief 按数据依赖并行执行系统更新的帧图
+ *
+ * 节点按注册顺序加入，与之前访问冲突的节点之间建立依赖边；每帧 execute 时，
+ * 依赖已满足的节点由线程池中的参与者动态领取执行，互不冲突的系统因此并行运行。
+ * 声明为 main_thread 的节点只由调用 execute 的线程执行。
+ */
+class FrameGraph {
+   public:
+    using Task = std::function<void(float delta_time)>;
+
+    struct NodeInfo {
+        std::string name;
+        StorageAccess access;
+        std::vector<std::uint32_t> dependencies;  ///< 直接依赖的节点下标
+        float last_duration_ms = 0.0f;            ///< 最近一次执行耗时
+    };
+
+    /**
+     * @brief 添加节点，返回节点下标
+     */
+    std::size_t add_node(std::string name, const StorageAccess& access, Task task);
+
+    /**
+     * @brief 执行一帧：所有节点各运行一次，返回时全部完成
+     * @param delta_time 传给各节点的帧时间（秒）
+     * @param pool 执行所用的线程池，调用线程作为 0 号参与者
+     */
+    void execute(float delta_time, WorkStealingPool& pool);
+
+    [[nodiscard]] std::size_t size() const {
+        return nodes_.size();
+    }
+
+    [[nodiscard]] std::span<const NodeInfo> nodes() const {
+        return info_;
+    }
+
+    /**
+     * @brief 依赖链上最长的节点数，即一帧内不可并行的最少阶段数
+     */
+    [[nodiscard]] std::size_t critical_path_length() const;
+
+   private:
+    struct Node {
+        Task task;
+        std::vector<std::uint32_t> successors;
+        std::uint32_t predecessor_count = 0;
+    };
+
+    bool take_ready(std::size_t worker, std::uint32_t& out);
+    void run_node(std::uint32_t index, float delta_time);
+
+    std::vector<Node> nodes_;
+    std::vector<NodeInfo> info_;
+
+    // 每帧执行状态
+    std::mutex mutex_;
+    std::condition_variable ready_cv_;
+    std::deque<std::uint32_t> ready_;
+    std::vector<std::uint32_t> pending_;
+    std::size_t completed_ = 0;
+};
+
+}  // namespace Corona
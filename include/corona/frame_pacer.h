@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace Corona {
+
+/**
+ * @brief 帧率控制方式
+ */
+enum class PacingMode {
+    Sleep,     ///< 按绝对截止时间睡眠，省电，精度取决于系统定时器
+    Hybrid,    ///< 先睡眠到截止时间前的自旋阈值，再自旋等待，抖动最小但占用 CPU
+    Uncapped,  ///< 不限帧率，用于性能测试
+};
+
+/**
+ * @brief 最近一段时间内实际帧时间的统计（毫秒）
+ */
+struct FrameTimeStats {
+    std::size_t samples = 0;
+    double average_ms = 0.0;
+    double p50_ms = 0.0;
+    double p90_ms = 0.0;
+    double p99_ms = 0.0;
+    double max_ms = 0.0;
+};
+
+/**
+ * @brief 主循环帧率控制器
+ *
+ * 每帧的截止时间由上一帧的截止时间加上帧间隔得到，而不是由本帧的结束时间推算，
+ * 因此睡眠的误差不会逐帧累积。落后超过一帧时直接从当前时间重新开始，不会连续补帧。
+ * Linux 下使用 clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME) 按绝对时间睡眠。
+ *
+ * 设置函数可在任意线程调用，下一帧生效；wait() 只应由主循环调用。
+ */
+class FramePacer {
+   public:
+    static constexpr double kDefaultTargetRate = 120.0;
+    static constexpr std::size_t kStatsWindow = 1024;  ///< 参与统计的最近帧数
+
+    /**
+     * @brief 设置目标帧率
+     * @param frames_per_second 目标帧率，小于等于 0 时不限帧率
+     */
+    void set_target_rate(double frames_per_second);
+    [[nodiscard]] double target_rate() const;
+
+    void set_mode(PacingMode mode);
+    [[nodiscard]] PacingMode mode() const;
+
+    /**
+     * @brief 设置 Hybrid 模式下截止时间前改为自旋等待的时长
+     */
+    void set_spin_threshold(std::chrono::microseconds threshold);
+    [[nodiscard]] std::chrono::microseconds spin_threshold() const;
+
+    /**
+     * @brief 以当前时间作为起点重新开始计时，并清空统计
+     */
+    void reset();
+
+    /**
+     * @brief 等待到下一帧的截止时间，并记录本帧的实际时长
+     */
+    void wait();
+
+    /**
+     * @brief 最近 kStatsWindow 帧的帧时间分位数
+     */
+    [[nodiscard]] FrameTimeStats stats() const;
+
+   private:
+    using Clock = std::chrono::steady_clock;
+
+    void record(Clock::duration frame_time);
+
+    std::atomic<double> target_rate_{kDefaultTargetRate};
+    std::atomic<PacingMode> mode_{PacingMode::Sleep};
+    std::atomic<std::int64_t> spin_threshold_us_{1000};
+
+    // 仅主循环访问
+    bool started_ = false;
+    Clock::time_point last_frame_{};
+    Clock::time_point next_deadline_{};
+
+    mutable std::mutex stats_mutex_;
+    std::array<float, kStatsWindow> frame_times_ms_{};
+    std::size_t frame_count_ = 0;
+};
+
+}  // namespace Corona
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Corona {
+
+/**
+ * @brief 系统线程与引擎主循环之间的帧同步与耗时统计
+ *
+ * 每个系统注册为一个参与者，每次更新前后分别调用 enter() 与 leave()：
+ * - 未开启锁步时 enter() 立即返回 std::nullopt，系统按自身帧率运行，leave() 只记录本次更新耗时；
+ * - 开启锁步后，系统在 enter() 中等待引擎开始新的一帧，每帧恰好更新一次，并使用引擎的帧时间；
+ *   引擎在 end_frame() 中等待所有参与者完成本帧，从而整个引擎按主循环的帧确定性地推进。
+ *
+ * 锁步开关在下一次 begin_frame() 时生效，避免在一帧中途改变参与者的计数。
+ */
+class FrameSync {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief 锁步模式下系统本次更新所属的帧
+     */
+    struct Ticket {
+        std::uint64_t frame_number = 0;
+        float delta_time = 0.0f;
+    };
+
+    /**
+     * @brief 单个系统的更新耗时（毫秒）
+     */
+    struct SystemTiming {
+        std::string name;
+        float last_ms = 0.0f;
+        float average_ms = 0.0f;  ///< 指数滑动平均
+        float max_ms = 0.0f;
+        std::uint64_t updates = 0;
+    };
+
+    /**
+     * @brief 注册参与者，返回其编号；需在系统开始更新之前调用
+     */
+    std::size_t add_participant(std::string name);
+
+    /**
+     * @brief 请求开启或关闭锁步，下一帧开始时生效
+     */
+    void set_lock_step(bool enabled);
+    [[nodiscard]] bool lock_step() const;
+
+    // ========================================
+    // 系统线程侧
+    // ========================================
+
+    /**
+     * @brief 开始一次系统更新
+     * @return 锁步模式下返回本次更新所属的帧；未锁步（或等待期间锁步被关闭）时返回 std::nullopt
+     */
+    std::optional<Ticket> enter(std::size_t participant);
+
+    /**
+     * @brief 结束一次系统更新，记录耗时并在锁步模式下向引擎报到
+     */
+    void leave(std::size_t participant, Clock::duration elapsed);
+
+    // ========================================
+    // 引擎侧
+    // ========================================
+
+    /**
+     * @brief 开始新的一帧，唤醒等待中的参与者
+     */
+    void begin_frame(std::uint64_t frame_number, float delta_time);
+
+    /**
+     * @brief 等待所有参与者完成当前帧
+     * @return 全部完成（或未锁步）返回 true，超时返回 false
+     */
+    bool end_frame(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief 立即退出锁步并唤醒所有等待中的参与者，主循环退出时调用
+     */
+    void release();
+
+    [[nodiscard]] std::vector<SystemTiming> timings() const;
+
+   private:
+    struct Participant {
+        SystemTiming timing;
+        std::uint64_t generation = 0;  ///< 最近一次以锁步方式处理的帧序号
+        bool in_frame = false;         ///< 正在以锁步方式处理当前帧
+    };
+
+    mutable std::mutex mutex_;
+    std::condition_variable frame_cv_;  ///< 唤醒等待新帧的参与者
+    std::condition_variable done_cv_;   ///< 唤醒等待本帧完成的引擎
+    std::vector<std::unique_ptr<Participant>> participants_;
+
+    bool requested_ = false;  ///< set_lock_step 请求的状态
+    bool active_ = false;     ///< 当前帧是否处于锁步
+    Ticket current_;
+    std::uint64_t generation_ = 0;  ///< begin_frame 的调用次数，区分不同的帧
+    std::size_t arrived_ = 0;
+};
+
+}  // namespace Corona
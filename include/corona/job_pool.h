@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Corona {
+
+/**
+ * @brief 并行任务中的一个区间
+ *
+ * chunk 为区间序号（begin / grain），调用方可按序号写入各自的输出缓冲，
+ * 再按序号顺序合并，从而保证结果与线程数量无关。
+ * worker 为执行该区间的参与者编号，范围 [0, thread_count())，可用于索引线程私有的临时缓冲。
+ */
+struct JobRange {
+    std::size_t chunk;
+    std::size_t begin;
+    std::size_t end;
+    std::size_t worker;
+};
+
+/**
+ * @brief 工作窃取线程池
+ *
+ * 每个参与者拥有一个区间队列：自己从队尾取（LIFO，保持缓存局部性），
+ * 空闲时从其他队列的队首窃取（FIFO，优先拿走较大的剩余工作）。
+ * 调用 parallel_for 的线程本身作为 0 号参与者一同执行，返回时所有区间均已完成。
+ *
+ * parallel_for 不可重入：区间回调中不能再次调用同一线程池的 parallel_for。
+ * 力学系统用它并行各求解阶段，帧图模式下引擎用它并行执行各系统的更新。
+ */
+class WorkStealingPool {
+   public:
+    using RangeFn = std::function<void(const JobRange&)>;
+
+    /**
+     * @brief 创建线程池
+     * @param thread_count 参与者总数（包含调用线程），0 表示按硬件线程数自动选择
+     */
+    explicit WorkStealingPool(std::size_t thread_count);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+    WorkStealingPool(WorkStealingPool&&) = delete;
+    WorkStealingPool& operator=(WorkStealingPool&&) = delete;
+
+    /**
+     * @brief 参与者总数（包含调用线程）
+     */
+    [[nodiscard]] std::size_t thread_count() const {
+        return queues_.size();
+    }
+
+    /**
+     * @brief 将 [0, count) 按 grain 切分为区间并行执行，阻塞直到全部完成
+     */
+    void parallel_for(std::size_t count, std::size_t grain, const RangeFn& fn);
+
+    /**
+     * @brief 按 grain 切分 count 得到的区间数量
+     */
+    [[nodiscard]] static std::size_t chunk_count(std::size_t count, std::size_t grain) {
+        return grain == 0 ? 0 : (count + grain - 1) / grain;
+    }
+
+    /**
+     * @brief 自动选择时使用的参与者数量：硬件线程数的一半（至少 1）
+     *
+     * 线程模式下显示、光学、几何等系统各自占用一个线程并与本线程池同时运行，
+     * 只取一半硬件线程可避免线程数超过核心数。需要其他数量时由使用方显式指定，
+     * 例如 MechanicsSystem::set_worker_count()。
+     */
+    [[nodiscard]] static std::size_t default_thread_count();
+
+   private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<JobRange> ranges;
+    };
+
+    void worker_loop(std::size_t index);
+    void run_ranges(std::size_t index);
+    bool pop_or_steal(std::size_t index, JobRange& out);
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> threads_;
+
+    std::mutex state_mutex_;
+    std::condition_variable wake_cv_;
+    std::condition_variable done_cv_;
+    std::uint64_t generation_ = 0;
+    bool stopping_ = false;
+
+    const RangeFn* job_ = nullptr;
+    std::atomic<std::size_t> remaining_{0};
+};
+
+}  // namespace Corona
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Corona {
+
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * @brief 单调递增计数器
+ */
+class Counter {
+   public:
+    void increment(std::uint64_t amount = 1) noexcept {
+        value_.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::uint64_t value() const noexcept {
+        return value_.load(std::memory_order_relaxed);
+    }
+
+   private:
+    std::atomic<std::uint64_t> value_{0};
+};
+
+/**
+ * @brief 可任意设置的瞬时值
+ */
+class Gauge {
+   public:
+    void set(double value) noexcept {
+        value_.store(value, std::memory_order_relaxed);
+    }
+
+    void add(double delta) noexcept {
+        value_.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] double value() const noexcept {
+        return value_.load(std::memory_order_relaxed);
+    }
+
+   private:
+    std::atomic<double> value_{0.0};
+};
+
+/**
+ * @brief HDR 风格的延迟直方图
+ *
+ * 以纳秒记录，每个 2 的幂区间再均分为 8 个子桶，分位数的相对误差不超过 1/16；
+ * 桶数固定，记录只做两次原子加法，不分配内存。
+ */
+class LatencyHistogram {
+   public:
+    static constexpr unsigned kSubBucketBits = 3;
+    static constexpr std::size_t kSubBuckets = std::size_t{1} << kSubBucketBits;
+    static constexpr std::size_t kBucketCount = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+    void record(std::chrono::nanoseconds latency) noexcept {
+        record_ns(latency.count() > 0 ? static_cast<std::uint64_t>(latency.count()) : 0);
+    }
+
+    void record_ns(std::uint64_t nanoseconds) noexcept {
+        buckets_[bucket_of(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_ns_.fetch_add(nanoseconds, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::uint64_t count() const noexcept {
+        return count_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] double sum_seconds() const noexcept {
+        return static_cast<double>(sum_ns_.load(std::memory_order_relaxed)) * 1e-9;
+    }
+
+    /**
+     * @brief 分位数（秒），取所在桶的中点
+     */
+    [[nodiscard]] double quantile_seconds(double q) const noexcept;
+
+   private:
+    static std::size_t bucket_of(std::uint64_t value) noexcept;
+    static double bucket_midpoint(std::size_t bucket) noexcept;
+
+    std::array<std::atomic<std::uint64_t>, kBucketCount> buckets_{};
+    std::atomic<std::uint64_t> count_{0};
+    std::atomic<std::uint64_t> sum_ns_{0};
+};
+
+/**
+ * @brief 引擎指标注册表
+ *
+ * 系统在初始化时按名称和标签注册指标并保存返回的引用，之后在热路径上只做原子操作。
+ * 同一名称与标签重复注册返回同一个指标；同名指标必须使用相同的类型。
+ * 直方图以 Prometheus summary 的形式导出 0.5/0.9/0.99 分位数、总和与次数。
+ *
+ * @code
+ * auto& contacts = MetricsRegistry::instance().counter("corona_mechanics_contacts_total", "Contacts solved");
+ * contacts.increment(solver_stats.contact_count);
+ * @endcode
+ */
+class MetricsRegistry {
+   public:
+    enum class Type {
+        Counter,
+        Gauge,
+        Histogram,
+    };
+
+    static MetricsRegistry& instance();
+
+    Counter& counter(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+    Gauge& gauge(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+    LatencyHistogram& histogram(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+
+    /**
+     * @brief 注册在导出时才求值的仪表，用于读取成本较高或已由其他对象维护的数值
+     *
+     * 回调在注册表加锁期间调用，不能在其中注册指标。
+     */
+    void gauge_callback(const std::string& name, const std::string& help, const MetricLabels& labels,
+                        std::function<double()> read);
+
+    /**
+     * @brief 按 Prometheus 文本格式展开的所有时间序列，键为带标签的序列名
+     */
+    [[nodiscard]] std::vector<std::pair<std::string, double>> series() const;
+
+    void write_prometheus(std::ostream& out) const;
+
+    /**
+     * @brief 写入 Prometheus 文本文件，先写临时文件再替换，读取方不会看到写了一半的文件
+     */
+    bool write_prometheus(const std::filesystem::path& path) const;
+
+   private:
+    struct Entry {
+        Type type = Type::Counter;
+        std::string help;
+        MetricLabels labels;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<LatencyHistogram> histogram;
+        std::function<double()> read;
+    };
+
+    struct Series {
+        const Entry* entry = nullptr;
+        std::string name;    ///< 指标名称
+        std::string series;  ///< 带后缀与标签的序列名
+        double value = 0.0;
+    };
+
+    MetricsRegistry() = default;
+
+    [[nodiscard]] std::vector<Series> collect() const;
+    Entry& find_or_add(Type type, const std::string& name, const std::string& help, const MetricLabels& labels);
+
+    mutable std::mutex mutex_;
+    std::map<std::pair<std::string, std::string>, Entry> entries_;  ///< (名称, 序列化标签) -> 指标
+};
+
+}  // namespace Corona
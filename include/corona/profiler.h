@@ -0,0 +1,158 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Corona {
+
+/**
+ * @brief 低开销的分区 CPU 性能分析器
+ *
+ * 每个线程拥有独立的环形缓冲区，记录作用域的起止时间，写入时无锁；缓冲区写满后覆盖最旧的记录。
+ * 记录可随时导出为 Chrome trace-event JSON，在 Perfetto 或 chrome://tracing 中查看，
+ * 嵌套的作用域按时间自动显示为层级。
+ *
+ * 一般通过宏使用，关闭 CORONA_BUILD_PROFILER 时宏在编译期移除：
+ * @code
+ * void MechanicsSystem::update_physics() {
+ *     CORONA_PROFILE_SCOPE("MechanicsSystem::update_physics");
+ *     ...
+ * }
+ *
+ * Corona::Profiler::instance().start();
+ * ...
+ * Corona::Profiler::instance().write_chrome_trace("trace.json");
+ * @endcode
+ *
+ * 作用域名称只保存 string_view，必须指向静态存储（字符串字面量或同等生命周期的字符串）。
+ */
+class Profiler {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t kThreadCapacity = std::size_t{1} << 16;  ///< 每个线程保留的最近记录数
+
+    static Profiler& instance();
+
+    /**
+     * @brief 丢弃已有记录并开始记录
+     */
+    void start();
+
+    /**
+     * @brief 停止记录，已有记录保留到下次 start()
+     */
+    void stop();
+
+    [[nodiscard]] bool is_active() const {
+        return active_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 设置当前线程在 trace 中显示的名称
+     */
+    void set_thread_name(std::string name);
+
+    /**
+     * @brief 导出 Chrome trace-event JSON
+     *
+     * 记录过程中也可调用，此时正在被覆盖的最旧记录会被丢弃。
+     */
+    void write_chrome_trace(std::ostream& out) const;
+    bool write_chrome_trace(const std::filesystem::path& path) const;
+
+    /**
+     * @brief 记录一个已结束的作用域，由 ProfileZone 调用
+     */
+    void record(std::string_view name, Clock::time_point begin, Clock::time_point end);
+
+   private:
+    struct Event {
+        std::string_view name;
+        std::int64_t begin_ns = 0;
+        std::int64_t end_ns = 0;
+    };
+
+    /**
+     * @brief 环形缓冲区中的一条记录
+     *
+     * 以顺序锁保护：所属线程写入前把 sequence 置 0，写完后置为该记录的序号 + 1；
+     * 导出线程在复制前后读到相同且匹配的序号时才采用副本，否则说明记录正在被覆盖。
+     */
+    struct Slot {
+        std::atomic<std::uint64_t> sequence{0};
+        std::atomic<const char*> name_data{nullptr};
+        std::atomic<std::size_t> name_size{0};
+        std::atomic<std::int64_t> begin_ns{0};
+        std::atomic<std::int64_t> end_ns{0};
+    };
+
+    struct ThreadBuffer {
+        std::uint32_t thread_id = 0;
+        std::string name;
+        std::unique_ptr<Slot[]> events;
+        std::atomic<std::uint64_t> head{0};   ///< 下一条记录的序号，只由所属线程写入
+        std::atomic<std::uint64_t> start{0};  ///< 本次记录的起始序号，之前的记录已被丢弃
+    };
+
+    Profiler();
+
+    ThreadBuffer& local_buffer();
+
+    std::atomic<bool> active_{false};
+    const Clock::time_point epoch_;
+
+    mutable std::mutex mutex_;  ///< 保护缓冲区列表与线程名称
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+};
+
+/**
+ * @brief 记录所在作用域耗时的 RAII 对象，性能分析器未开始记录时几乎没有开销
+ */
+class ProfileZone {
+   public:
+    explicit ProfileZone(std::string_view name)
+        : name_(name) {
+        if (Profiler::instance().is_active()) {
+            active_ = true;
+            begin_ = Profiler::Clock::now();
+        }
+    }
+
+    ~ProfileZone() {
+        if (active_) {
+            Profiler::instance().record(name_, begin_, Profiler::Clock::now());
+        }
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+   private:
+    std::string_view name_;
+    Profiler::Clock::time_point begin_{};
+    bool active_ = false;
+};
+
+}  // namespace Corona
+
+#if defined(CORONA_ENABLE_PROFILER)
+#define CORONA_PROFILE_CONCAT_IMPL(a, b) a##b
+#define CORONA_PROFILE_CONCAT(a, b) CORONA_PROFILE_CONCAT_IMPL(a, b)
+#define CORONA_PROFILE_SCOPE(name) ::Corona::ProfileZone CORONA_PROFILE_CONCAT(corona_profile_zone_, __LINE__)(name)
+#define CORONA_PROFILE_FUNCTION() CORONA_PROFILE_SCOPE(__func__)
+#define CORONA_PROFILE_THREAD(name) ::Corona::Profiler::instance().set_thread_name(name)
+#else
+#define CORONA_PROFILE_SCOPE(name) ((void)0)
+#define CORONA_PROFILE_FUNCTION() ((void)0)
+#define CORONA_PROFILE_THREAD(name) ((void)0)
+#endif
@@ -1,7 +1,18 @@
 #pragma once
+#include <corona/dense_storage.h>
 #include <corona/kernel/utils/storage.h>
-
+#include <corona/snapshot_buffer.h>
+#include <corona/transform_hierarchy.h>
+#include <corona/transform_store.h>
+#include <corona/update_budget.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
 #include <memory>
+#include <mutex>
+#include <string_view>
 #include <vector>
 
 #include <ktm/ktm.h>
@@ -9,6 +20,9 @@
 #include "CabbageHardware.h"
 
 // Forward declarations
+namespace Corona::Systems {
+class SpatialIndex;
+}  // namespace Corona::Systems
 
 namespace Corona {
 
@@ -30,6 +44,16 @@ struct ModelTransform {
     ktm::fvec3 euler_rotation;
     ktm::fvec3 scale;
 
+    // 父变换句柄，0 表示根节点；非 0 时上面的位姿相对于父变换。
+    // 世界矩阵由帧末发布的 TransformSnapshot 沿层级传播得到；力学系统按世界空间处理变换，
+    // 带父节点的变换不能挂载刚体（脚本 API 拒绝，力学系统跳过）
+    std::uintptr_t parent_handle{0};
+
+    // 力学系统上一个固定步开始时的位姿，用于渲染插值
+    ktm::fvec3 previous_position;
+    ktm::fvec3 previous_euler_rotation;
+    std::uint64_t physics_step{0};  ///< 最近一次由力学系统写入的步序号，0 表示不参与插值
+
     ModelTransform() {
         position.x = 0.0f;
         position.y = 0.0f;
@@ -42,6 +66,9 @@ struct ModelTransform {
         scale.x = 1.0f;
         scale.y = 1.0f;
         scale.z = 1.0f;
+
+        previous_position = position;
+        previous_euler_rotation = euler_rotation;
     }
 
     [[nodiscard]] ktm::fmat4x4 compute_matrix() const {
@@ -57,6 +84,133 @@ struct ModelTransform {
         affine >> result;
         return result;
     }
+
+    /**
+     * @brief 在上一个物理步与当前位姿之间插值后计算世界矩阵
+     * @param alpha 插值系数，0 为上一步位姿，1 为当前位姿
+     */
+    [[nodiscard]] ktm::fmat4x4 compute_interpolated_matrix(float alpha) const {
+        // 欧拉角按最短方向插值，避免跨越 ±π 时绕远路
+        const auto lerp_angle = [alpha](float from, float to) {
+            constexpr float kPi = 3.14159265358979f;
+            const float delta = std::remainder(to - from, 2.0f * kPi);
+            return from + delta * alpha;
+        };
+
+        ModelTransform blended = *this;
+        blended.position.x = previous_position.x + (position.x - previous_position.x) * alpha;
+        blended.position.y = previous_position.y + (position.y - previous_position.y) * alpha;
+        blended.position.z = previous_position.z + (position.z - previous_position.z) * alpha;
+        blended.euler_rotation.x = lerp_angle(previous_euler_rotation.x, euler_rotation.x);
+        blended.euler_rotation.y = lerp_angle(previous_euler_rotation.y, euler_rotation.y);
+        blended.euler_rotation.z = lerp_angle(previous_euler_rotation.z, euler_rotation.z);
+        return blended.compute_matrix();
+    }
+};
+
+/**
+ * @brief 力学系统发布的插值状态
+ *
+ * 力学系统以固定步长推进，每次更新后发布最近一步的序号与剩余累积时间。
+ * 渲染线程的帧率高于力学系统，因此按发布后经过的时间继续推算插值系数。
+ */
+struct PhysicsInterpolation {
+    std::uint64_t step{0};             ///< 最近完成的固定步序号
+    float time_step{1.0f / 60.0f};     ///< 固定步长（秒）
+    float accumulator{0.0f};           ///< 发布时尚未模拟的累积时间（秒）
+    std::chrono::steady_clock::time_point published_at{};
+
+    /**
+     * @brief 计算 now 时刻的插值系数 [0, 1]
+     */
+    [[nodiscard]] float alpha_at(std::chrono::steady_clock::time_point now) const {
+        if (step == 0 || time_step <= 0.0f) {
+            return 1.0f;
+        }
+        const float elapsed = std::chrono::duration<float>(now - published_at).count();
+        const float alpha = (accumulator + (elapsed > 0.0f ? elapsed : 0.0f)) / time_step;
+        return alpha < 1.0f ? alpha : 1.0f;
+    }
+};
+
+/**
+ * @brief 力学系统在最近一步写回的刚体位姿
+ *
+ * 力学系统在更新结束时从自身的刚体状态填充（不读取变换存储），与该步的插值状态一同发布。
+ * 发布变换快照时以它覆盖从存储复制的对应变换，因此即使力学线程正在写回下一步，
+ * 快照中的刚体位姿也与快照的插值状态属于同一步。
+ */
+struct PhysicsPoseSnapshot {
+    struct Pose {
+        std::uintptr_t transform_handle{};
+        ktm::fvec3 position;
+        ktm::fvec3 euler_rotation;
+        ktm::fvec3 previous_position;
+        ktm::fvec3 previous_euler_rotation;
+    };
+
+    std::uint64_t step{0};    ///< 位姿所属的固定步序号
+    std::vector<Pose> poses;  ///< 该步写回过的刚体
+};
+
+/**
+ * @brief 某一帧结束时全部模型变换的不可变快照
+ *
+ * 由主循环在帧末发布，读者（光学系统等）按句柄查找变换时不再逐个加锁。
+ * 发布时主循环仍需对每个变换获取一次读访问来复制它，逐个加锁的开销由读者转移到了帧末的这一次复制。
+ * handles、transforms 与 world_matrices 一一对应，slots 为句柄到下标的开放寻址索引；
+ * world_matrices 为未插值的世界矩阵，取自 TransformStore 的缓存，只有变化过的变换被重算；
+ * 存在父子关系时再经 TransformHierarchy 传播，只有变化过的子树被重算。
+ * interpolation 为与最近一次 PhysicsPoseSnapshot 一同发布的插值状态，刚体的位姿与 physics_step
+ * 取自该位姿快照，因此与 interpolation 属于同一步；其余变换是复制时存储中的值。
+ */
+struct TransformSnapshot {
+    std::uint64_t frame{0};
+    PhysicsInterpolation interpolation;
+    std::vector<std::uintptr_t> handles;
+    std::vector<ModelTransform> transforms;
+    std::vector<ktm::fmat4x4> world_matrices;
+    std::vector<std::uint32_t> slots;  ///< 容量为 2 的幂，存放下标 + 1，0 表示空槽
+
+    /**
+     * @brief 按 handles 重建 slots，复用已有容量
+     */
+    void rebuild_index();
+
+    static constexpr std::size_t kNotFound = static_cast<std::size_t>(-1);
+
+    /**
+     * @brief 按句柄查找下标，不存在时返回 kNotFound
+     */
+    [[nodiscard]] std::size_t index_of(std::uintptr_t handle) const {
+        if (slots.empty()) {
+            return kNotFound;
+        }
+        const std::size_t mask = slots.size() - 1;
+        for (std::size_t slot = slot_of(handle) & mask;; slot = (slot + 1) & mask) {
+            const std::uint32_t entry = slots[slot];
+            if (entry == 0) {
+                return kNotFound;
+            }
+            if (handles[entry - 1] == handle) {
+                return entry - 1;
+            }
+        }
+    }
+
+    /**
+     * @brief 按句柄查找变换，不存在时返回 nullptr
+     */
+    [[nodiscard]] const ModelTransform* find(std::uintptr_t handle) const {
+        const std::size_t index = index_of(handle);
+        return index == kNotFound ? nullptr : &transforms[index];
+    }
+
+    [[nodiscard]] static std::size_t slot_of(std::uintptr_t handle) {
+        // 分代句柄的低 32 位是连续的槽位下标、高 32 位是代数，乘法散列后取高位使二者都参与散列
+        const std::uint64_t hash = static_cast<std::uint64_t>(handle) * 0x9E3779B97F4A7C15ull;
+        return static_cast<std::size_t>(hash >> 32);
+    }
 };
 
 struct ModelResource {
@@ -75,8 +229,56 @@ struct KinematicsDevice {
 
 struct MechanicsDevice {
     std::uintptr_t geometry_handle{};
-    ktm::fvec3 max_xyz;
+    ktm::fvec3 max_xyz;  ///< 模型空间包围盒，三个方向都必须有正的厚度
     ktm::fvec3 min_xyz;
+
+    // 刚体参数
+    float mass{0.0f};           ///< 质量（千克），0 表示静态物体
+    float restitution{0.2f};    ///< 恢复系数 [0, 1]
+    float friction{0.5f};       ///< 摩擦系数
+    float gravity_scale{1.0f};  ///< 重力缩放
+    bool continuous{false};     ///< 高速物体，启用连续碰撞检测（扫掠包围盒）以免穿过薄物体
+
+    // 刚体状态，由力学系统每步写回
+    ktm::fvec3 linear_velocity;   ///< 线速度（米/秒）
+    ktm::fvec3 angular_velocity;  ///< 角速度（弧度/秒，世界空间）
+
+    // 休眠状态：休眠物体不再读取变换，直接使用入睡时缓存的世界包围盒
+    bool sleeping{false};
+    float sleep_timer{0.0f};
+    ktm::fvec3 sleep_min_xyz;
+    ktm::fvec3 sleep_max_xyz;
+
+    // 脚本修改速度或休眠状态时递增；力学系统写回前比较，收集之后被修改过的物体不覆盖脚本的修改
+    std::uint32_t revision{0};
+
+    MechanicsDevice() {
+        max_xyz.x = 0.0f;
+        max_xyz.y = 0.0f;
+        max_xyz.z = 0.0f;
+
+        min_xyz.x = 0.0f;
+        min_xyz.y = 0.0f;
+        min_xyz.z = 0.0f;
+
+        linear_velocity.x = 0.0f;
+        linear_velocity.y = 0.0f;
+        linear_velocity.z = 0.0f;
+
+        angular_velocity.x = 0.0f;
+        angular_velocity.y = 0.0f;
+        angular_velocity.z = 0.0f;
+
+        sleep_min_xyz = min_xyz;
+        sleep_max_xyz = max_xyz;
+    }
+
+    /**
+     * @brief 局部包围盒是否有体积，没有体积的物体不参与模拟
+     */
+    [[nodiscard]] bool has_volume() const {
+        return max_xyz.x > min_xyz.x && max_xyz.y > min_xyz.y && max_xyz.z > min_xyz.z;
+    }
 };
 
 struct AcousticsDevice {
@@ -169,19 +371,21 @@ class SharedDataHub {
 
    public:
     // 新的 Storage 类型定义，包含默认的容量和内存池参数
-    using ModelResourceStorage = Kernel::Utils::Storage<ModelResource, 128, 2>;
-    using ModelTransformStorage = Kernel::Utils::Storage<ModelTransform, 128, 2>;
-    using GeometryStorage = Kernel::Utils::Storage<GeometryDevice, 128, 2>;
-    using KinematicsStorage = Kernel::Utils::Storage<KinematicsDevice, 128, 2>;
-    using MechanicsStorage = Kernel::Utils::Storage<MechanicsDevice, 128, 2>;
-    using AcousticsStorage = Kernel::Utils::Storage<AcousticsDevice, 128, 2>;
-    using OpticsStorage = Kernel::Utils::Storage<OpticsDevice, 128, 2>;
-    using ProfileStorage = Kernel::Utils::Storage<ProfileDevice, 128, 2>;
-    using ActorStorage = Kernel::Utils::Storage<ActorDevice, 128, 2>;
-    using CameraStorage = Kernel::Utils::Storage<CameraDevice, 128, 2>;
-    using ViewportStorage = Kernel::Utils::Storage<ViewportDevice, 128, 2>;
-    using EnvironmentStorage = Kernel::Utils::Storage<EnvironmentDevice, 128, 2>;
-    using SceneStorage = Kernel::Utils::Storage<SceneDevice, 128, 2>;
+    // DenseStorage 额外维护紧凑的活动句柄列表，供系统每帧顺序遍历
+    // 块容量与内存池参数是编译期常量；预留容量与增长方式在运行时由 configure_storage() 配置
+    using ModelResourceStorage = DenseStorage<ModelResource, 128, 2>;
+    using ModelTransformStorage = DenseStorage<ModelTransform, 128, 2>;
+    using GeometryStorage = DenseStorage<GeometryDevice, 128, 2>;
+    using KinematicsStorage = DenseStorage<KinematicsDevice, 128, 2>;
+    using MechanicsStorage = DenseStorage<MechanicsDevice, 128, 2>;
+    using AcousticsStorage = DenseStorage<AcousticsDevice, 128, 2>;
+    using OpticsStorage = DenseStorage<OpticsDevice, 128, 2>;
+    using ProfileStorage = DenseStorage<ProfileDevice, 128, 2>;
+    using ActorStorage = DenseStorage<ActorDevice, 128, 2>;
+    using CameraStorage = DenseStorage<CameraDevice, 128, 2>;
+    using ViewportStorage = DenseStorage<ViewportDevice, 128, 2>;
+    using EnvironmentStorage = DenseStorage<EnvironmentDevice, 128, 2>;
+    using SceneStorage = DenseStorage<SceneDevice, 128, 2>;
 
     ModelResourceStorage& model_resource_storage();
     const ModelResourceStorage& model_resource_storage() const;
@@ -222,6 +426,88 @@ class SharedDataHub {
     SceneStorage& scene_storage();
     const SceneStorage& scene_storage() const;
 
+    /**
+     * @brief 设置存储的预留容量与增长方式，并立即预留 config.capacity 个对象
+     * @param name 存储名称，与 corona_storage_objects 指标的 storage 标签一致（如 "model_transform"）
+     * @return 名称未知时返回 false
+     */
+    bool configure_storage(std::string_view name, const StorageConfig& config);
+
+    /**
+     * @brief 为存储预留容量，关卡加载前调用可避免在帧中途增长
+     * @return 名称未知时返回 false
+     */
+    bool reserve_storage(std::string_view name, std::size_t count);
+
+    /**
+     * @brief 从文本文件读取各存储的配置，通常在 Engine::initialize() 之前调用
+     *
+     * 每行配置一个存储，未给出的字段保持当前值，# 之后为注释：
+     * @code
+     * model_transform capacity=200000 growth=geometric step=4096
+     * scene capacity=4
+     * @endcode
+     * growth 取 incremental、geometric 或 linear。
+     *
+     * @return 文件无法打开或存在无法解析的行时返回 false（可解析的行仍然生效）
+     */
+    bool load_storage_config(const std::filesystem::path& path);
+
+    /**
+     * @brief 发布力学系统的插值状态（力学线程调用）
+     */
+    void publish_physics_interpolation(const PhysicsInterpolation& interpolation);
+
+    /**
+     * @brief 读取最近发布的插值状态（渲染线程调用）
+     */
+    [[nodiscard]] PhysicsInterpolation physics_interpolation() const;
+
+    /**
+     * @brief 取得一块可写的刚体位姿缓冲区（力学线程调用），填充后以 publish_physics_poses 发布
+     */
+    [[nodiscard]] std::shared_ptr<PhysicsPoseSnapshot> acquire_physics_poses();
+
+    /**
+     * @brief 发布最近一步的刚体位姿及其插值状态（力学线程调用）
+     *
+     * 二者在同一把锁内替换，发布变换快照时总能读到属于同一步的一对。
+     */
+    void publish_physics_poses(std::shared_ptr<PhysicsPoseSnapshot> poses, const PhysicsInterpolation& interpolation);
+
+    /**
+     * @brief 发布力学物体的空间索引快照（力学线程调用）
+     */
+    void publish_spatial_index(std::shared_ptr<const Systems::SpatialIndex> index);
+
+    /**
+     * @brief 获取最近发布的空间索引快照，尚未发布时为空
+     */
+    [[nodiscard]] std::shared_ptr<const Systems::SpatialIndex> spatial_index() const;
+
+    /**
+     * @brief 发布各系统的更新频率与预算状态（主循环在每次评估更新预算后调用）
+     */
+    void publish_system_rates(std::vector<SystemRate> rates);
+
+    /**
+     * @brief 最近发布的各系统更新频率与预算状态，供无法访问 Engine 的脚本读取
+     */
+    [[nodiscard]] std::vector<SystemRate> system_rates() const;
+
+    /**
+     * @brief 将当前全部模型变换复制到后台缓冲区并发布为新快照（主循环在帧末调用）
+     * @param frame 帧号
+     */
+    void publish_model_transforms(std::uint64_t frame);
+
+    /**
+     * @brief 获取最近发布的模型变换快照，尚未发布时为空
+     *
+     * 快照不可变，持有期间可以无锁读取；写入方在下一次发布时写入另一块缓冲区。
+     */
+    [[nodiscard]] std::shared_ptr<const TransformSnapshot> model_transform_snapshot() const;
+
    private:
     ModelResourceStorage model_resource_storage_;
     GeometryStorage geometry_storage_;
@@ -236,6 +522,22 @@ class SharedDataHub {
     CameraStorage camera_storage_;
     ViewportStorage viewport_storage_;
     SceneStorage scene_storage_;
+
+    mutable std::mutex physics_interpolation_mutex_;
+    PhysicsInterpolation physics_interpolation_;
+    SnapshotBuffer<PhysicsPoseSnapshot> physics_poses_;  ///< 与 physics_interpolation_ 在同一把锁内发布
+
+    mutable std::mutex spatial_index_mutex_;
+    std::shared_ptr<const Systems::SpatialIndex> spatial_index_;
+
+    mutable std::mutex system_rates_mutex_;
+    std::vector<SystemRate> system_rates_;
+
+    std::mutex model_transform_publish_mutex_;
+    TransformStore model_transform_cache_;  ///< 按紧凑句柄顺序缓存局部矩阵，帧间复用
+    TransformHierarchy model_transform_hierarchy_;  ///< 与 model_transform_cache_ 下标一致，无父子关系时为空
+    std::vector<std::uint32_t> model_transform_changed_;
+    SnapshotBuffer<TransformSnapshot> model_transform_snapshots_;
 };
 
 }  // namespace Corona
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace Corona {
+
+/**
+ * @brief 多缓冲的不可变快照发布器
+ *
+ * 写入方通过 acquire_back() 取得一块当前没有读者持有的后台缓冲区，
+ * 填充完毕后调用 publish() 交换前台指针使其成为最新快照；
+ * 读者通过 snapshot() 取得 shared_ptr<const T>，只在复制该指针时短暂加锁，
+ * 此后读取快照内容不再需要任何锁，快照在最后一个读者释放之前保持不变。
+ *
+ * 内部轮换 Buffers 块缓冲区（默认三块：一块已发布、一块可能仍被读者持有、一块供写入），
+ * 稳态下不分配内存；所有缓冲区都被读者持有时才分配新的缓冲区顶替。
+ * 写入方之间以互斥锁串行；填充缓冲区时不持有任何读者可见的锁。
+ */
+template <typename T, std::size_t Buffers = 3>
+class SnapshotBuffer {
+    static_assert(Buffers >= 2, "SnapshotBuffer needs at least two buffers");
+
+   public:
+    /**
+     * @brief 取得一块可写的后台缓冲区
+     *
+     * 缓冲区保留其上一次发布时的内容与容量，调用方负责完整覆盖。
+     * 返回的缓冲区在 publish() 之前不会被读者看到。
+     */
+    [[nodiscard]] std::shared_ptr<T> acquire_back() {
+        std::lock_guard lock(writer_mutex_);
+        const T* front = snapshot().get();
+
+        // 只有本对象持有引用（use_count == 1）的缓冲区既未发布也没有读者
+        for (auto& buffer : buffers_) {
+            if (buffer && buffer.get() != front && buffer.use_count() == 1) {
+                return buffer;
+            }
+        }
+        for (auto& buffer : buffers_) {
+            if (!buffer) {
+                buffer = std::make_shared<T>();
+                return buffer;
+            }
+        }
+
+        // 读者持有了全部旧缓冲区：轮流顶替一块非前台的缓冲区，旧对象随最后一个读者释放
+        for (std::size_t i = 0; i < Buffers; ++i) {
+            auto& victim = buffers_[(next_victim_ + i) % Buffers];
+            if (victim.get() != front) {
+                next_victim_ = (next_victim_ + i + 1) % Buffers;
+                victim = std::make_shared<T>();
+                return victim;
+            }
+        }
+        return std::make_shared<T>();
+    }
+
+    /**
+     * @brief 将填充完毕的后台缓冲区发布为最新快照
+     * @param back 由 acquire_back() 返回的缓冲区
+     */
+    void publish(std::shared_ptr<T> back) {
+        std::lock_guard lock(writer_mutex_);
+        {
+            std::lock_guard front_lock(front_mutex_);
+            front_ = std::move(back);
+        }
+        generation_.fetch_add(1, std::memory_order_release);
+    }
+
+    /**
+     * @brief 获取最近发布的快照，尚未发布时为空
+     */
+    [[nodiscard]] std::shared_ptr<const T> snapshot() const {
+        std::lock_guard lock(front_mutex_);
+        return front_;
+    }
+
+    /**
+     * @brief 已发布的快照数量
+     */
+    [[nodiscard]] std::uint64_t generation() const {
+        return generation_.load(std::memory_order_acquire);
+    }
+
+   private:
+    std::mutex writer_mutex_;
+    std::array<std::shared_ptr<T>, Buffers> buffers_;
+    std::size_t next_victim_ = 0;
+    mutable std::mutex front_mutex_;
+    std::shared_ptr<const T> front_;
+    std::atomic<std::uint64_t> generation_{0};
+};
+
+}  // namespace Corona
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <corona/events/acoustics_system_events.h>
+#include <corona/frame_graph.h>
 #include <corona/kernel/event/i_event_bus.h>
 #include <corona/kernel/event/i_event_stream.h>
 #include <corona/kernel/system/system_base.h>
@@ -18,7 +19,7 @@ namespace Corona::Systems {
 class AcousticsSystem : public Kernel::SystemBase {
    public:
     AcousticsSystem() {
-        set_target_fps(60);  // 声学系统运行在 60 FPS
+        set_target_fps(kDefaultTargetFps);
     }
 
     ~AcousticsSystem() override = default;
@@ -35,6 +36,18 @@ class AcousticsSystem : public Kernel::SystemBase {
         return 70;  // 中等优先级
     }
 
+    /**
+     * @brief 声明的目标帧率，过载时引擎可能临时降低（见 UpdateBudget）
+     */
+    static constexpr int kDefaultTargetFps = 60;
+
+    /**
+     * @brief 帧图模式下本系统读写的共享数据
+     */
+    static StorageAccess storage_access() {
+        return StorageAccess{}.read(StorageId::ModelTransform).read(StorageId::Geometry).read(StorageId::Acoustics);
+    }
+
     /**
      * @brief 初始化声学系统
      * @param ctx 系统上下文
@@ -49,6 +62,14 @@ class AcousticsSystem : public Kernel::SystemBase {
      */
     void update() override;
 
+    /**
+     * @brief 按给定的经过时间推进声音播放与混音
+     *
+     * update() 以框架提供的帧时间调用本函数；帧图模式与 run_frames() 下由引擎直接传入帧时间。
+     * @param elapsed 距上次推进经过的时间（秒）
+     */
+    void advance(float elapsed);
+
     /**
      * @brief 关闭声学系统
      *
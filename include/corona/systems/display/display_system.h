@@ -1,6 +1,7 @@
 #pragma once
 
 #include <corona/events/display_system_events.h>
+#include <corona/frame_graph.h>
 #include <corona/kernel/event/i_event_bus.h>
 #include <corona/kernel/event/i_event_stream.h>
 #include <corona/kernel/system/system_base.h>
@@ -18,7 +19,7 @@ namespace Corona::Systems {
 class DisplaySystem : public Kernel::SystemBase {
    public:
     DisplaySystem() {
-        set_target_fps(120);  // 显示系统高刷新率以提升响应速度
+        set_target_fps(kDefaultTargetFps);
     }
 
     ~DisplaySystem() override = default;
@@ -35,6 +36,20 @@ class DisplaySystem : public Kernel::SystemBase {
         return 100;  // 最高优先级，最先初始化
     }
 
+    /**
+     * @brief 声明的目标帧率，过载时引擎可能临时降低（见 UpdateBudget）
+     */
+    static constexpr int kDefaultTargetFps = 120;
+
+    /**
+     * @brief 帧图模式下本系统读写的共享数据
+     *
+     * 窗口与输入事件需在主线程处理
+     */
+    static StorageAccess storage_access() {
+        return StorageAccess{}.on_main_thread();
+    }
+
     /**
      * @brief 初始化显示系统
      * @param ctx 系统上下文
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <corona/events/geometry_system_events.h>
+#include <corona/frame_graph.h>
 #include <corona/kernel/event/i_event_bus.h>
 #include <corona/kernel/event/i_event_stream.h>
 #include <corona/kernel/system/system_base.h>
@@ -18,7 +19,7 @@ namespace Corona::Systems {
 class GeometrySystem : public Kernel::SystemBase {
    public:
     GeometrySystem() {
-        set_target_fps(60);  // 几何系统运行在 60 FPS
+        set_target_fps(kDefaultTargetFps);
     }
 
     ~GeometrySystem() override = default;
@@ -35,6 +36,18 @@ class GeometrySystem : public Kernel::SystemBase {
         return 85;  // 高优先级，在动画系统之后
     }
 
+    /**
+     * @brief 声明的目标帧率，过载时引擎可能临时降低（见 UpdateBudget）
+     */
+    static constexpr int kDefaultTargetFps = 60;
+
+    /**
+     * @brief 帧图模式下本系统读写的共享数据
+     */
+    static StorageAccess storage_access() {
+        return StorageAccess{}.read(StorageId::ModelResource).write(StorageId::Geometry);
+    }
+
     /**
      * @brief 初始化几何系统
      * @param ctx 系统上下文
@@ -49,6 +62,14 @@ class GeometrySystem : public Kernel::SystemBase {
      */
     void update() override;
 
+    /**
+     * @brief 按给定的经过时间更新几何
+     *
+     * update() 以框架提供的帧时间调用本函数；帧图模式与 run_frames() 下由引擎直接传入帧时间。
+     * @param elapsed 距上次更新经过的时间（秒）
+     */
+    void advance(float elapsed);
+
     /**
      * @brief 关闭几何系统
      *
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <corona/events/kinematics_system_events.h>
+#include <corona/frame_graph.h>
 #include <corona/kernel/event/i_event_bus.h>
 #include <corona/kernel/event/i_event_stream.h>
 #include <corona/kernel/system/system_base.h>
@@ -19,7 +20,7 @@ namespace Corona::Systems {
 class KinematicsSystem : public Kernel::SystemBase {
    public:
     KinematicsSystem() {
-        set_target_fps(60);  // 动画系统运行在 60 FPS
+        set_target_fps(kDefaultTargetFps);
     }
 
     ~KinematicsSystem() override = default;
@@ -36,6 +37,18 @@ class KinematicsSystem : public Kernel::SystemBase {
         return 80;  // 高优先级，在渲染前更新
     }
 
+    /**
+     * @brief 声明的目标帧率，过载时引擎可能临时降低（见 UpdateBudget）
+     */
+    static constexpr int kDefaultTargetFps = 60;
+
+    /**
+     * @brief 帧图模式下本系统读写的共享数据
+     */
+    static StorageAccess storage_access() {
+        return StorageAccess{}.read(StorageId::Geometry).write(StorageId::Kinematics).write(StorageId::ModelTransform);
+    }
+
     /**
      * @brief 初始化动画系统
      * @param ctx 系统上下文
@@ -50,6 +63,14 @@ class KinematicsSystem : public Kernel::SystemBase {
      */
     void update() override;
 
+    /**
+     * @brief 按给定的经过时间推进动画
+     *
+     * update() 以框架提供的帧时间调用本函数；帧图模式与 run_frames() 下由引擎直接传入帧时间。
+     * @param elapsed 距上次推进经过的时间（秒）
+     */
+    void advance(float elapsed);
+
     /**
      * @brief 关闭动画系统
      *
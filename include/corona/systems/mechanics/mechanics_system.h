@@ -1,27 +1,30 @@
 #pragma once
 
 #include <corona/events/mechanics_system_events.h>
+#include <corona/frame_graph.h>
 #include <corona/kernel/event/i_event_bus.h>
 #include <corona/kernel/event/i_event_stream.h>
 #include <corona/kernel/system/system_base.h>
 
+#include <atomic>
+#include <cstddef>
 #include <memory>
 
 namespace Corona::Systems {
 
+// 前向声明力学系统帧间状态
+struct MechanicsWorld;
+
 /**
  * @brief 力学系统 (Mechanics System)
  *
  * 负责物理模拟、刚体动力学、碰撞检测和响应。
- * 运行在独立线程，以 60 FPS 更新物理状态。
+ * 运行在独立线程，以 60 FPS 更新，每次更新按固定步长推进物理状态。
  */
 class MechanicsSystem : public Kernel::SystemBase {
    public:
-    MechanicsSystem() {
-        set_target_fps(60);  // 力学系统运行在 60 FPS
-    }
-
-    ~MechanicsSystem() override = default;
+    MechanicsSystem();
+    ~MechanicsSystem() override;
 
     // ========================================
     // ISystem 接口实现
@@ -35,6 +38,18 @@ class MechanicsSystem : public Kernel::SystemBase {
         return 75;  // 中高优先级，在几何系统之后
     }
 
+    /**
+     * @brief 声明的目标帧率，过载时引擎可能临时降低（见 UpdateBudget）
+     */
+    static constexpr int kDefaultTargetFps = 60;
+
+    /**
+     * @brief 帧图模式下本系统读写的共享数据
+     */
+    static StorageAccess storage_access() {
+        return StorageAccess{}.read(StorageId::Geometry).write(StorageId::Mechanics).write(StorageId::ModelTransform);
+    }
+
     /**
      * @brief 初始化力学系统
      * @param ctx 系统上下文
@@ -49,6 +64,14 @@ class MechanicsSystem : public Kernel::SystemBase {
      */
     void update() override;
 
+    /**
+     * @brief 按给定的经过时间推进物理
+     *
+     * update() 以框架提供的帧时间调用本函数；帧图模式下由引擎直接传入主循环的帧时间。
+     * @param elapsed 距上次推进经过的真实时间（秒）
+     */
+    void advance(float elapsed);
+
     /**
      * @brief 关闭力学系统
      *
@@ -56,9 +79,127 @@ class MechanicsSystem : public Kernel::SystemBase {
      */
     void shutdown() override;
 
+    // ========================================
+    // 并行配置
+    // ========================================
+
+    /**
+     * @brief 设置力学工作线程数量（包含力学系统线程本身）
+     *
+     * 在下一次物理更新时生效。模拟结果与线程数量无关。
+     * @param count 线程数量，0 表示自动选择（见 set_auto_worker_count）
+     */
+    void set_worker_count(std::size_t count);
+
+    /**
+     * @brief 设置自动选择时的力学工作线程数量
+     *
+     * 帧图模式与 run_frames() 下引擎按帧线程池未占用的核心数设置，两个线程池合计不超过核心数；
+     * set_worker_count() 显式设置的数量优先。
+     * @param count 线程数量，0 表示使用 WorkStealingPool::default_thread_count()
+     */
+    void set_auto_worker_count(std::size_t count);
+
+    /**
+     * @brief 获取当前生效的力学工作线程数量
+     */
+    [[nodiscard]] std::size_t worker_count() const;
+
+    // ========================================
+    // 宽阶段
+    // ========================================
+
+    /**
+     * @brief 设置宽阶段网格单元的边长
+     *
+     * 宽阶段把排序轴以外的两轴划分为均匀网格，只在同一单元内扫描重叠。
+     * 单元约为常见物体尺寸的数倍时比较次数最少；在下一次物理更新时生效，不影响模拟结果。
+     * @param size 边长（米），小于等于 0 表示按物体平均尺寸自动选择
+     */
+    void set_broadphase_cell_size(float size);
+    [[nodiscard]] float broadphase_cell_size() const;
+
+    // ========================================
+    // 固定步长
+    // ========================================
+
+    static constexpr float kDefaultFixedTimeStep = 1.0f / 60.0f;
+    static constexpr int kDefaultMaxSubsteps = 4;
+
+    /**
+     * @brief 设置物理模拟的固定步长
+     *
+     * 每次更新按真实经过的时间推进若干个固定步，模拟速度与系统更新频率无关。
+     * @param seconds 步长（秒），例如 1/120
+     */
+    void set_fixed_time_step(float seconds);
+    [[nodiscard]] float fixed_time_step() const;
+
+    /**
+     * @brief 设置每次更新最多执行的固定步数量
+     *
+     * 超出部分的时间被丢弃，避免单步耗时过长时积压越来越多（死亡螺旋）。
+     */
+    void set_max_substeps(int count);
+    [[nodiscard]] int max_substeps() const;
+
+    /**
+     * @brief 上一次更新后的插值系数 [0, 1)
+     *
+     * 即剩余累积时间与步长之比。渲染端应使用 SharedDataHub::physics_interpolation()，
+     * 它会按发布后经过的时间继续推算。
+     */
+    [[nodiscard]] float interpolation_alpha() const;
+
+    // ========================================
+    // 运行统计
+    // ========================================
+
+    /**
+     * @brief 上一次物理更新中参与求解的动态物体数量
+     */
+    [[nodiscard]] std::size_t active_body_count() const;
+
+    /**
+     * @brief 上一次物理更新结束时处于休眠的动态物体数量
+     */
+    [[nodiscard]] std::size_t sleeping_body_count() const;
+
    private:
     // 力学系统私有成员
     void update_physics();
+
+    /**
+     * @brief 收集本帧所有物体并计算世界包围盒
+     *
+     * 每个物体只读取一次存储并计算一次世界矩阵，结果写入 SoA 缓存
+     */
+    void gather_bodies();
+
+    /**
+     * @brief 按配置创建或重建工作线程池
+     */
+    void ensure_worker_pool();
+
+    /**
+     * @brief 划分岛并唤醒与活动物体接触的休眠岛
+     */
+    void wake_islands();
+
+    /**
+     * @brief 根据本次更新结束时的物体包围盒发布空间索引快照
+     */
+    void publish_spatial_index();
+
+    std::unique_ptr<MechanicsWorld> world_;
+    std::atomic<std::size_t> requested_worker_count_{0};  ///< 0 表示自动选择
+    std::atomic<std::size_t> auto_worker_count_{0};       ///< 自动选择的数量，0 表示取默认值
+    std::atomic<float> broadphase_cell_size_{0.0f};       ///< 0 表示自动选择
+    std::atomic<float> fixed_time_step_{kDefaultFixedTimeStep};
+    std::atomic<int> max_substeps_{kDefaultMaxSubsteps};
+    std::atomic<float> interpolation_alpha_{0.0f};
+    std::atomic<std::size_t> active_body_count_{0};
+    std::atomic<std::size_t> sleeping_body_count_{0};
 };
 
 }  // namespace Corona::Systems
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <ktm/ktm.h>
+
+namespace Corona::Systems {
+
+/**
+ * @brief 空间查询命中的物体
+ */
+struct QueryBody {
+    std::uintptr_t mechanics_handle{};
+    std::uintptr_t geometry_handle{};
+};
+
+/**
+ * @brief 射线查询
+ */
+struct QueryRay {
+    ktm::fvec3 origin;
+    ktm::fvec3 direction;  ///< 无需归一化，命中距离按归一化后的方向计算
+    float max_distance{1e30f};
+};
+
+/**
+ * @brief 球体重叠查询
+ */
+struct QuerySphere {
+    ktm::fvec3 center;
+    float radius{0.0f};
+};
+
+/**
+ * @brief 包围盒重叠查询
+ */
+struct QueryBox {
+    ktm::fvec3 min;
+    ktm::fvec3 max;
+};
+
+/**
+ * @brief 射线命中结果
+ */
+struct RayHit {
+    QueryBody body;
+    float distance{0.0f};  ///< 从射线起点到命中点的距离
+    ktm::fvec3 point;      ///< 命中点（世界空间）
+    ktm::fvec3 normal;     ///< 命中面的法线（坐标轴方向）
+};
+
+/**
+ * @brief 批量重叠查询的结果
+ *
+ * 第 i 个查询的命中物体为 bodies[offsets[i], offsets[i + 1])。
+ */
+struct OverlapResults {
+    std::vector<std::uint32_t> offsets;
+    std::vector<QueryBody> bodies;
+
+    [[nodiscard]] std::span<const QueryBody> at(std::size_t query) const {
+        return {bodies.data() + offsets[query], offsets[query + 1] - offsets[query]};
+    }
+};
+
+/**
+ * @brief 力学物体世界包围盒的只读空间索引（BVH）
+ *
+ * 由力学系统在每次更新后根据最新的世界包围盒生成快照，通过 SharedDataHub 发布给其他线程。
+ * 快照不可变，查询可在任意线程并发执行。BVH 在第一次查询时才构建，没有查询时不产生开销。
+ */
+class SpatialIndex {
+   public:
+    struct Entry {
+        ktm::fvec3 min;
+        ktm::fvec3 max;
+        QueryBody body;
+    };
+
+    explicit SpatialIndex(std::vector<Entry> entries);
+
+    SpatialIndex(const SpatialIndex&) = delete;
+    SpatialIndex& operator=(const SpatialIndex&) = delete;
+
+    [[nodiscard]] std::size_t size() const {
+        return entries_.size();
+    }
+
+    /**
+     * @brief 取出条目缓冲区（已清空，保留容量），供下一份快照复用
+     *
+     * 只能由快照的创建者在没有其他持有者时调用，之后本快照为空。
+     */
+    [[nodiscard]] std::vector<Entry> take_entries();
+
+    /**
+     * @brief 最近命中
+     */
+    [[nodiscard]] std::optional<RayHit> raycast(const QueryRay& ray) const;
+
+    /**
+     * @brief 批量射线查询，hits[i] 为第 i 条射线的最近命中，未命中时 body.mechanics_handle 为 0
+     */
+    void raycast(std::span<const QueryRay> rays, std::span<RayHit> hits) const;
+
+    /**
+     * @brief 与球体重叠的物体（按包围盒判断）
+     */
+    [[nodiscard]] std::vector<QueryBody> overlap_sphere(const QuerySphere& sphere) const;
+    void overlap_sphere(std::span<const QuerySphere> spheres, OverlapResults& results) const;
+
+    /**
+     * @brief 与包围盒重叠的物体
+     */
+    [[nodiscard]] std::vector<QueryBody> overlap_box(const QueryBox& box) const;
+    void overlap_box(std::span<const QueryBox> boxes, OverlapResults& results) const;
+
+   private:
+    static constexpr std::uint32_t kLeafSize = 4;
+
+    struct Node {
+        ktm::fvec3 min;
+        ktm::fvec3 max;
+        std::uint32_t first;  ///< 叶节点：entries_ 起始下标；内部节点：右子节点下标（左子节点紧随其后）
+        std::uint32_t count;  ///< 叶节点中的物体数量，0 表示内部节点
+    };
+
+    void ensure_built() const;
+    std::uint32_t build_node(std::uint32_t first, std::uint32_t count) const;
+
+    template <typename Overlaps>
+    void collect(const Overlaps& overlaps, std::vector<QueryBody>& out) const;
+
+    mutable std::vector<Entry> entries_;  ///< 构建时按 BVH 叶节点顺序重排
+    mutable std::vector<Node> nodes_;
+    mutable std::once_flag built_;
+};
+
+}  // namespace Corona::Systems
@@ -2,6 +2,7 @@
 
 #include <CabbageHardware.h>
 #include <corona/events/optics_system_events.h>
+#include <corona/frame_graph.h>
 #include <corona/kernel/event/i_event_bus.h>
 #include <corona/kernel/event/i_event_stream.h>
 #include <corona/kernel/system/system_base.h>
@@ -36,6 +37,28 @@ class OpticsSystem : public Kernel::SystemBase {
         return 90;  // 高优先级，在显示系统之后初始化
     }
 
+    /**
+     * @brief 声明的目标帧率，过载时引擎可能临时降低（见 UpdateBudget）
+     */
+    static constexpr int kDefaultTargetFps = 120;
+
+    /**
+     * @brief 帧图模式下本系统读写的共享数据
+     *
+     * 模型变换通过 SharedDataHub::model_transform_snapshot() 读取上一帧末发布的快照，
+     * 不声明对 ModelTransform 的读取，因此可与写入变换的系统并行执行。
+     */
+    static StorageAccess storage_access() {
+        return StorageAccess{}
+            .read(StorageId::ModelResource)
+            .read(StorageId::Geometry)
+            .read(StorageId::Optics)
+            .read(StorageId::Camera)
+            .read(StorageId::Viewport)
+            .read(StorageId::Environment)
+            .read(StorageId::Scene);
+    }
+
     /**
      * @brief 初始化光学系统
      * @param ctx 系统上下文
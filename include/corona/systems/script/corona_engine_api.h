@@ -1,10 +1,13 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace Corona {
 class Model;
@@ -27,11 +30,19 @@ class Geometry {
     void set_rotation(const std::array<float, 3>& euler);
     void set_scale(const std::array<float, 3>& size);
 
+    /**
+     * @brief 挂接到父几何体，此后位置、旋转与缩放均相对于父变换
+     * @param parent 父几何体，nullptr 表示取消挂接
+     * @return 是否挂接成功；已挂载刚体（Mechanics）的几何体不能挂接到父几何体
+     */
+    bool set_parent(const Geometry* parent);
+
     [[nodiscard]] std::array<float, 3> get_position() const;
     [[nodiscard]] std::array<float, 3> get_rotation() const;
     [[nodiscard]] std::array<float, 3> get_scale() const;
 
    private:
+    friend class Actor;
     friend class Mechanics;
     friend class Optics;
     friend class Acoustics;
@@ -53,9 +64,46 @@ class Geometry {
 // ============================================================================
 class Mechanics {
    public:
+    using Bounds = std::array<float, 3>;
+
+    /**
+     * @brief 创建力学组件，模型资源不提供包围盒，需调用 set_bounds 后才会创建刚体
+     */
     explicit Mechanics(Geometry& geo);
+
+    /**
+     * @brief 以模型空间包围盒创建刚体，包围盒没有体积或几何体挂接了父几何体时不创建
+     */
+    Mechanics(Geometry& geo, const Bounds& min_xyz, const Bounds& max_xyz);
     ~Mechanics();
 
+    /**
+     * @brief 设置模型空间包围盒（碰撞形状与质量属性均由其近似），尚无刚体时创建刚体
+     * @return 包围盒没有体积、几何体挂接了父几何体或无法写入时返回 false
+     */
+    bool set_bounds(const Bounds& min_xyz, const Bounds& max_xyz);
+    [[nodiscard]] bool has_body() const;
+
+    // 刚体参数，质量为 0 表示静态物体
+    void set_mass(float mass);
+    void set_restitution(float restitution);
+    void set_friction(float friction);
+    void set_gravity_scale(float scale);
+    void set_linear_velocity(const std::array<float, 3>& velocity);
+    void set_angular_velocity(const std::array<float, 3>& velocity);
+
+    // 高速物体（子弹、投掷物）开启连续碰撞检测，避免穿过薄物体
+    void set_continuous_collision(bool enabled);
+    [[nodiscard]] bool is_continuous_collision() const;
+
+    // 休眠物体不再读取变换，直接修改 Geometry 的变换后需调用 wake_up
+    void wake_up();
+    [[nodiscard]] bool is_sleeping() const;
+
+    [[nodiscard]] float get_mass() const;
+    [[nodiscard]] std::array<float, 3> get_linear_velocity() const;
+    [[nodiscard]] std::array<float, 3> get_angular_velocity() const;
+
    private:
     friend class Actor;
 
@@ -228,7 +276,8 @@ class Viewport {
     void set_viewport_rect(int x, int y, int width, int height);
 
     // ========== 交互功能 ==========
-    void pick_actor_at_pixel(int x, int y) const;
+    // 沿相机射线拾取最近的 Actor（按力学包围盒判断），未命中返回 nullptr
+    [[nodiscard]] Actor* pick_actor_at_pixel(int x, int y) const;
     void save_screenshot(const std::string& path) const;
 
    private:
@@ -302,6 +351,47 @@ class Scene {
     std::vector<Viewport*> viewports_;
 };
 
+// ============================================================================
+// Physics queries: 基于力学系统发布的空间索引，按包围盒判断
+// ============================================================================
+struct RaycastHit {
+    Actor* actor{nullptr};  // 命中的 Geometry 未加入任何 Actor 时为 nullptr
+    float distance{0.0f};
+    std::array<float, 3> point{};
+    std::array<float, 3> normal{};
+};
+
+[[nodiscard]] std::optional<RaycastHit> raycast(const std::array<float, 3>& origin,
+                                                const std::array<float, 3>& direction,
+                                                float max_distance = 1e30f);
+[[nodiscard]] std::vector<std::optional<RaycastHit>> raycast_batch(const std::vector<std::array<float, 3>>& origins,
+                                                                   const std::vector<std::array<float, 3>>& directions,
+                                                                   float max_distance = 1e30f);
+[[nodiscard]] std::vector<Actor*> overlap_sphere(const std::array<float, 3>& center, float radius);
+[[nodiscard]] std::vector<Actor*> overlap_box(const std::array<float, 3>& min, const std::array<float, 3>& max);
+
+// ============================================================================
+// Metrics: 引擎指标注册表的当前值
+// ============================================================================
+[[nodiscard]] std::unordered_map<std::string, double> metrics();
+
+// 各系统的更新频率与预算状态，effective_fps 低于 nominal_fps 表示该系统正被降级
+struct SystemRate {
+    std::string name;
+    int priority{0};
+    int nominal_fps{0};
+    int effective_fps{0};
+    float budget_ms{0.0f};
+    float average_ms{0.0f};
+    std::uint64_t overruns{0};
+    bool sheddable{false};
+};
+
+[[nodiscard]] std::vector<SystemRate> system_rates();
+
+// 脚本本次运行的帧时间（秒）；run_frames() 期间恒为固定步长，脚本应以它而不是墙钟时间推进自身状态
+[[nodiscard]] float delta_time();
+
 // ============================================================================
 // Scene I/O utilities
 // ============================================================================
@@ -1,11 +1,13 @@
 #pragma once
 
 #include <corona/events/display_system_events.h>
+#include <corona/frame_graph.h>
 #include <corona/kernel/event/i_event_bus.h>
 #include <corona/kernel/event/i_event_stream.h>
 #include <corona/kernel/system/system_base.h>
 #include <corona/systems/script/python_api.h>
 
+#include <atomic>
 #include <memory>
 
 namespace Corona::Systems {
@@ -19,7 +21,7 @@ namespace Corona::Systems {
 class ScriptSystem : public Kernel::SystemBase {
 public:
     ScriptSystem() {
-        set_target_fps(60);  // 显示系统高刷新率以提升响应速度
+        set_target_fps(kDefaultTargetFps);
     }
 
     ~ScriptSystem() override = default;
@@ -36,6 +38,20 @@ public:
         return 60;  // 最高优先级，最先初始化
     }
 
+    /**
+     * @brief 声明的目标帧率，过载时引擎可能临时降低（见 UpdateBudget）
+     */
+    static constexpr int kDefaultTargetFps = 60;
+
+    /**
+     * @brief 帧图模式下本系统读写的共享数据
+     *
+     * 脚本可访问全部数据，Python 解释器状态绑定在主线程
+     */
+    static StorageAccess storage_access() {
+        return StorageAccess::all().on_main_thread();
+    }
+
     /**
      * @brief 初始化显示系统
      * @param ctx 系统上下文
@@ -50,6 +66,20 @@ public:
      */
     void update() override;
 
+    /**
+     * @brief 以给定的帧时间运行一次脚本
+     *
+     * update() 以框架提供的帧时间调用本函数；帧图模式与 run_frames() 下由引擎直接传入帧时间。
+     * 脚本通过 delta_time() 读取该值，run_frames() 期间恒为固定步长，脚本据此推进的状态可以重放。
+     * @param elapsed 距上次运行经过的时间（秒）
+     */
+    void advance(float elapsed);
+
+    /**
+     * @brief 脚本本次运行收到的帧时间（秒），供 Python 绑定读取
+     */
+    [[nodiscard]] static float frame_delta_time();
+
     /**
      * @brief 关闭显示系统
      *
@@ -59,6 +89,8 @@ public:
 
 private:
     Script::Python::PythonAPI python_api_;
+
+    static std::atomic<float> frame_delta_time_;
 };
 
 }  // namespace Corona::Systems
\ No newline at end of file
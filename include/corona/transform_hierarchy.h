@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <ktm/ktm.h>
+
+namespace Corona {
+
+/**
+ * @brief 父子变换层级，按深度优先顺序存放世界矩阵
+ *
+ * 节点以 [0, size()) 的下标标识，局部矩阵按节点下标写入；世界矩阵按深度优先顺序存放，
+ * 父节点总在子节点之前，且每个节点的子树占据一段连续区间 [position, subtree_end)。
+ * 因此一次顺序扫描即可传播世界矩阵：world = parent_world * local。
+ *
+ * set_local() 只标记该节点的子树，update() 按位置排序脏节点后逐段重算，
+ * 已被祖先覆盖的子树跳过；只有 set_parent() / resize() 改变结构时才重建顺序并全部重算。
+ * 父链成环的节点在重建时被断开并作为根节点处理。
+ *
+ * 不是线程安全的，由调用方串行访问。
+ */
+class TransformHierarchy {
+   public:
+    static constexpr std::uint32_t kNoParent = 0xFFFFFFFFu;
+
+    /**
+     * @brief 节点数量
+     */
+    [[nodiscard]] std::size_t size() const {
+        return parent_.size();
+    }
+
+    /**
+     * @brief 调整节点数量，新增节点为根节点、局部矩阵为单位矩阵；父节点被移除的节点成为根节点
+     */
+    void resize(std::size_t count);
+
+    /**
+     * @brief 设置父节点
+     * @param node 节点下标
+     * @param parent 父节点下标，kNoParent 表示根节点；越界或指向自身时视为根节点
+     */
+    void set_parent(std::size_t node, std::uint32_t parent);
+
+    [[nodiscard]] std::uint32_t parent(std::size_t node) const {
+        return parent_[node];
+    }
+
+    /**
+     * @brief 写入局部矩阵，并标记该节点的子树在下一次 update() 时重算
+     */
+    void set_local(std::size_t node, const ktm::fmat4x4& local);
+
+    [[nodiscard]] const ktm::fmat4x4& local(std::size_t node) const {
+        return local_[node];
+    }
+
+    /**
+     * @brief 传播世界矩阵
+     * @return 重算的节点数量
+     */
+    std::size_t update();
+
+    /**
+     * @brief 节点的世界矩阵，在最近一次 update() 之后有效
+     */
+    [[nodiscard]] const ktm::fmat4x4& world(std::size_t node) const {
+        return world_[position_[node]];
+    }
+
+    /**
+     * @brief 节点在深度优先顺序中的位置，在最近一次 update() 之后有效
+     */
+    [[nodiscard]] std::uint32_t position(std::size_t node) const {
+        return position_[node];
+    }
+
+    /**
+     * @brief 结构变化后是否需要在 update() 中重建顺序
+     */
+    [[nodiscard]] bool layout_dirty() const {
+        return layout_dirty_;
+    }
+
+   private:
+    void rebuild_layout();
+    void propagate(std::uint32_t begin, std::uint32_t end);
+
+    // 按节点下标
+    std::vector<std::uint32_t> parent_;
+    std::vector<ktm::fmat4x4> local_;
+    std::vector<std::uint32_t> position_;
+    std::vector<std::uint8_t> dirty_;
+    std::vector<std::uint32_t> dirty_list_;
+
+    // 按深度优先位置
+    std::vector<std::uint32_t> node_at_;
+    std::vector<std::uint32_t> parent_position_;  ///< 根节点为 kNoParent
+    std::vector<std::uint32_t> subtree_end_;      ///< 子树区间的结束位置（不含）
+    std::vector<ktm::fmat4x4> world_;
+
+    // 重建顺序时复用的临时数组
+    std::vector<std::uint32_t> child_offsets_;
+    std::vector<std::uint32_t> children_;
+    std::vector<std::uint32_t> stack_;
+    std::vector<std::uint32_t> dirty_positions_;
+
+    bool layout_dirty_ = false;
+};
+
+}  // namespace Corona
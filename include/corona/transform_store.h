@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <ktm/ktm.h>
+
+namespace Corona {
+
+/**
+ * @brief 结构数组（SoA）布局的变换缓存，按条目缓存世界矩阵
+ *
+ * 位置、欧拉角与缩放的各分量连续存放；set() 只在数值改变时把条目标记为脏，
+ * update_world_matrices() 每帧一次性重算所有脏条目的世界矩阵（SSE2 一次处理 4 个），
+ * 其余条目直接复用缓存。世界矩阵与 ModelTransform::compute_matrix 一致：
+ * 平移 * 旋转（Z * Y * X）* 缩放。
+ *
+ * 容器在帧间复用，条目数量稳定后不再分配内存。不是线程安全的，由调用方串行访问。
+ */
+class TransformStore {
+   public:
+    /**
+     * @brief 条目数量
+     */
+    [[nodiscard]] std::size_t size() const {
+        return world_.size();
+    }
+
+    /**
+     * @brief 调整条目数量，新增条目为单位变换并标记为脏
+     */
+    void resize(std::size_t count);
+
+    /**
+     * @brief 预留容量
+     */
+    void reserve(std::size_t count);
+
+    /**
+     * @brief 写入条目的局部变换，与缓存值不同时标记为脏
+     * @return 条目是否因此变脏
+     */
+    bool set(std::size_t index, const ktm::fvec3& position, const ktm::fvec3& euler_rotation,
+             const ktm::fvec3& scale);
+
+    /**
+     * @brief 强制条目在下一次 update_world_matrices() 时重算
+     */
+    void mark_dirty(std::size_t index);
+
+    [[nodiscard]] bool is_dirty(std::size_t index) const {
+        return dirty_[index] != 0;
+    }
+
+    /**
+     * @brief 当前脏条目数量
+     */
+    [[nodiscard]] std::size_t dirty_count() const {
+        return dirty_list_.size();
+    }
+
+    /**
+     * @brief 批量重算所有脏条目的世界矩阵并清除脏标记
+     * @return 重算的条目数量
+     */
+    std::size_t update_world_matrices();
+
+    /**
+     * @brief update_world_matrices 的标量版本，作为向量实现的参考
+     */
+    std::size_t update_world_matrices_scalar();
+
+    /**
+     * @brief 条目的缓存世界矩阵，条目为脏时是上一次重算的结果
+     */
+    [[nodiscard]] const ktm::fmat4x4& world_matrix(std::size_t index) const {
+        return world_[index];
+    }
+
+    [[nodiscard]] const std::vector<ktm::fmat4x4>& world_matrices() const {
+        return world_;
+    }
+
+    /**
+     * @brief 当前编译目标使用的向量宽度（SSE2 = 4，标量 = 1）
+     */
+    [[nodiscard]] static std::size_t lane_width();
+
+   private:
+    // 取出本帧需要重算的条目（剔除 resize 缩小后越界的下标）并清除脏标记
+    std::size_t collect_dirty();
+
+    std::vector<float> position_x_;
+    std::vector<float> position_y_;
+    std::vector<float> position_z_;
+    std::vector<float> rotation_x_;
+    std::vector<float> rotation_y_;
+    std::vector<float> rotation_z_;
+    std::vector<float> scale_x_;
+    std::vector<float> scale_y_;
+    std::vector<float> scale_z_;
+
+    std::vector<std::uint8_t> dirty_;
+    std::vector<std::uint32_t> dirty_list_;  ///< 脏条目下标，按变脏的先后顺序
+    std::vector<ktm::fmat4x4> world_;
+};
+
+}  // namespace Corona
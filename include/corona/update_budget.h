@@ -0,0 +1,115 @@
+#pragma once
+
+#include <corona/frame_sync.h>
+#include <corona/metrics.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Corona {
+
+/**
+ * @brief 系统更新频率与预算的当前状态
+ */
+struct SystemRate {
+    std::string name;
+    int priority = 0;
+    int nominal_fps = 0;        ///< 系统声明的目标帧率
+    int effective_fps = 0;      ///< 当前实际使用的目标帧率
+    float budget_ms = 0.0f;     ///< 单次更新的耗时预算
+    float average_ms = 0.0f;    ///< 最近的平均更新耗时
+    std::uint64_t overruns = 0; ///< 平均耗时超出预算的评估次数
+    bool sheddable = false;     ///< 过载时是否允许降低帧率
+};
+
+/**
+ * @brief 系统更新预算控制器
+ *
+ * 每个系统有一个单次更新的耗时预算（默认为其目标帧率对应的帧间隔）。引擎定期用 FrameSync
+ * 统计的平均耗时进行评估：
+ * - 高优先级系统超出预算，或可降级系统自身超出预算时，将优先级最低、仍可降低的系统帧率减半；
+ * - 所有系统连续若干次评估都明显低于预算后，逐个把被降低的系统恢复为原帧率。
+ *
+ * 优先级低于 shed_priority 的系统才会被降低帧率，其余系统始终按声明的帧率运行。
+ * 评估只在主循环线程调用，有效帧率可在任意线程读取。
+ *
+ * 每个系统以 system 标签登记指标：corona_system_nominal_fps、corona_system_effective_fps、
+ * corona_system_budget_ms 与 corona_system_budget_overruns_total，有效帧率低于声明帧率即表示该系统正被降级。
+ */
+class UpdateBudget {
+   public:
+    static constexpr int kDefaultShedPriority = 75;  ///< 默认只降低优先级低于力学系统的系统
+    static constexpr int kMaxReduction = 8;          ///< 帧率最多降低为声明值的 1/8
+
+    /**
+     * @brief 注册系统，返回其编号；编号需与 FrameSync 中的参与者编号一致
+     */
+    std::size_t add_system(std::string name, int priority, int nominal_fps);
+
+    /**
+     * @brief 设置系统的单次更新预算
+     * @param budget_ms 预算（毫秒），小于等于 0 时恢复为默认的帧间隔
+     * @return 找到该系统返回 true
+     */
+    bool set_budget(std::string_view name, float budget_ms);
+
+    /**
+     * @brief 设置可降级的优先级阈值，优先级低于该值的系统允许被降低帧率
+     */
+    void set_shed_priority(int priority);
+
+    /**
+     * @brief 开启或关闭自动降级；关闭时所有系统立即恢复声明的帧率
+     */
+    void set_adaptive(bool enabled);
+    [[nodiscard]] bool adaptive() const;
+
+    /**
+     * @brief 系统当前的有效帧率
+     */
+    [[nodiscard]] int effective_fps(std::size_t system) const {
+        return systems_[system]->effective_fps.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 根据最近的更新耗时评估一次，按需调整有效帧率
+     * @param timings FrameSync::timings() 的结果，下标与系统编号一致
+     */
+    void evaluate(std::span<const FrameSync::SystemTiming> timings);
+
+    [[nodiscard]] std::vector<SystemRate> rates() const;
+
+   private:
+    struct System {
+        std::string name;
+        int priority = 0;
+        int nominal_fps = 0;
+        std::atomic<int> effective_fps{0};
+        float budget_ms = 0.0f;  ///< 0 表示使用默认预算
+        float average_ms = 0.0f;
+        std::uint64_t overruns = 0;
+        Gauge* effective_fps_metric = nullptr;
+        Gauge* budget_metric = nullptr;
+        Counter* overruns_metric = nullptr;
+    };
+
+    void evaluate_locked(std::span<const FrameSync::SystemTiming> timings);
+    void update_metrics(const System& system) const;
+    [[nodiscard]] float budget_of(const System& system) const;
+    [[nodiscard]] bool sheddable(const System& system) const;
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<System>> systems_;
+    int shed_priority_ = kDefaultShedPriority;
+    bool adaptive_ = true;
+    int calm_evaluations_ = 0;  ///< 连续未超预算的评估次数
+};
+
+}  // namespace Corona
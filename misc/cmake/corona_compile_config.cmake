@@ -76,6 +76,11 @@ if(CORONA_BUILD_VISION)
     add_compile_definitions(CORONA_ENABLE_VISION)
 endif()
 
+# Profiler zones compile to nothing when disabled
+if(CORONA_BUILD_PROFILER)
+    add_compile_definitions(CORONA_ENABLE_PROFILER)
+endif()
+
 # Enable Python API macros only when building the editor
 if(BUILD_CORONA_EDITOR)
     add_compile_definitions(CORONA_ENABLE_PYTHON_API)
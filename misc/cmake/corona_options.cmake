@@ -25,6 +25,7 @@ option(BUILD_CORONA_TESTING "Build Corona test suite" ${PROJECT_IS_TOP_LEVEL})
 option(BUILD_CORONA_EXAMPLES "Build example programs" ${PROJECT_IS_TOP_LEVEL})
 option(CORONA_BUILD_HARDWARE "Build Corona Hardware features" ON)
 option(CORONA_BUILD_VISION "Build Corona Vision features" OFF)
+option(CORONA_BUILD_PROFILER "Build built-in CPU profiler zones" ON)
 message(STATUS "[Options] CORONA_AUTO_INSTALL_PY_DEPS             = ${CORONA_AUTO_INSTALL_PY_DEPS}")
 message(STATUS "[Options] BUILD_SHARED_LIBS                       = ${BUILD_SHARED_LIBS}")
 message(STATUS "[Options] BUILD_CORONA_EDITOR                     = ${BUILD_CORONA_EDITOR}")
@@ -33,3 +34,4 @@ message(STATUS "[Options] BUILD_CORONA_TESTING                    = ${BUILD_CORO
 message(STATUS "[Options] BUILD_CORONA_EXAMPLES                   = ${BUILD_CORONA_EXAMPLES}")
 message(STATUS "[Options] CORONA_BUILD_HARDWARE                   = ${CORONA_BUILD_HARDWARE}")
 message(STATUS "[Options] CORONA_BUILD_VISION                     = ${CORONA_BUILD_VISION}")
+message(STATUS "[Options] CORONA_BUILD_PROFILER                   = ${CORONA_BUILD_PROFILER}")
@@ -69,6 +69,13 @@ FetchContent_Declare(CoronaFramework
     EXCLUDE_FROM_ALL
 )
 
+FetchContent_Declare(benchmark
+    GIT_REPOSITORY https://github.com/google/benchmark.git
+    GIT_TAG v1.9.1
+    GIT_SHALLOW TRUE
+    EXCLUDE_FROM_ALL
+)
+
 
 # ------------------------------------------------------------------------------
 # Fetch and enable dependencies
@@ -99,6 +106,15 @@ if(CORONA_BUILD_HARDWARE)
     message(STATUS "[3rdparty] CabbageHardware module enabled")
 endif()
 
+if(BUILD_CORONA_TESTING)
+    set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+    set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+    set(BENCHMARK_INSTALL_DOCS OFF CACHE BOOL "" FORCE)
+    set(BENCHMARK_ENABLE_WERROR OFF CACHE BOOL "" FORCE)
+    FetchContent_MakeAvailable(benchmark)
+    message(STATUS "[3rdparty] benchmark module enabled")
+endif()
+
 if(CORONA_BUILD_VISION)
     set(SDL_SHARED ON CACHE BOOL "" FORCE)
     set(VISION_BUILD_VULKAN OFF CACHE BOOL "" FORCE)
@@ -1,6 +1,11 @@
 #include "corona/engine.h"
 
 #include <corona/events/engine_events.h>
+#include <corona/frame_arena.h>
+#include <corona/job_pool.h>
+#include <corona/metrics.h>
+#include <corona/profiler.h>
+#include <corona/shared_data_hub.h>
 #include <corona/systems/acoustics/acoustics_system.h>
 #include <corona/systems/display/display_system.h>
 #include <corona/systems/geometry/geometry_system.h>
@@ -9,18 +14,198 @@
 #include <corona/systems/optics/optics_system.h>
 #include <corona/systems/script/script_system.h>
 #include <corona/kernel/core/i_logger.h>
+#include <corona/kernel/event/i_event_stream.h>
 
 #include <corona/resource/resource_manager.h>
 #include <corona/resource/types/text.h>
 #include <corona/resource/types/scene.h>
 #include <corona/resource/types/image.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <cstdlib>
 #include <memory>
 #include <thread>
+#include <utility>
 
 namespace Corona {
 
+namespace {
+
+/**
+ * @brief 为系统附加帧同步与更新预算
+ *
+ * 记录每次更新的耗时并计入指标注册表；锁步模式下每帧恰好更新一次；按 UpdateBudget 给出的有效帧率调整系统的目标帧率。
+ * 提供 advance(float) 的系统在锁步与帧图模式下以引擎的帧时间推进，而不是自身线程测得的时间；
+ * 无头模式注册的系统都提供 advance(float)，run_frames() 因此以固定步长推进每个系统。
+ * 每次更新外包裹一个 FrameArenaScope，系统在更新中从 frame_memory_resource() 分配的临时数据在更新结束时整体回收。
+ */
+template <typename T>
+class SyncedSystem final : public T {
+   public:
+    static constexpr bool kAdvances = requires(T& s, float dt) { s.advance(dt); };
+
+    SyncedSystem(FrameSync& sync, UpdateBudget& budget, const std::atomic<bool>& every_frame)
+        : sync_(sync),
+          budget_(budget),
+          every_frame_(every_frame),
+          participant_(sync.add_participant(std::string(T::get_name()))),
+          update_seconds_(MetricsRegistry::instance().histogram("corona_system_update_seconds",
+                                                                "Time spent in one system update",
+                                                                {{"system", std::string(T::get_name())}})),
+          applied_fps_(T::kDefaultTargetFps) {
+        budget.add_system(std::string(T::get_name()), T::get_priority(), T::kDefaultTargetFps);
+    }
+
+    void update() override {
+        // 线程模式下由系统自身的线程调用，以系统名称标记该线程
+        if (!thread_named_) {
+            CORONA_PROFILE_THREAD(std::string(T::get_name()));
+            thread_named_ = true;
+        }
+        run_update();
+    }
+
+    void advance(float delta_time)
+        requires kAdvances
+    {
+        CORONA_PROFILE_SCOPE(T::get_name());
+        const FrameArenaScope scratch;
+        const auto start = FrameSync::Clock::now();
+        T::advance(delta_time);
+        finish(start);
+    }
+
+    /**
+     * @brief 帧图中的一帧：按有效帧率决定本帧是否执行
+     *
+     * 有效帧率低于主循环帧率时隔帧执行，跳过的帧时间累计后一并交给 advance。
+     * run_frames() 期间每帧都以该帧的时间执行，模拟结果不随负载变化。
+     */
+    void step(float delta_time) {
+        if (every_frame_.load(std::memory_order_relaxed)) {
+            // 丢弃之前主循环中累计、尚未执行的时间，每帧恰好推进 delta_time
+            pending_time_ = delta_time;
+        } else {
+            pending_time_ += delta_time;
+            const int fps = budget_.effective_fps(participant_);
+            if (pending_time_ + 0.5f * delta_time < 1.0f / static_cast<float>(fps)) {
+                return;
+            }
+        }
+
+        const float elapsed = std::exchange(pending_time_, 0.0f);
+        if constexpr (kAdvances) {
+            advance(elapsed);
+        } else {
+            run_update();
+        }
+    }
+
+   private:
+    void run_update() {
+        // 在系统自身的线程上应用预算控制器调整后的帧率
+        const int fps = budget_.effective_fps(participant_);
+        if (fps != applied_fps_) {
+            this->set_target_fps(fps);
+            applied_fps_ = fps;
+        }
+
+        const auto ticket = sync_.enter(participant_);
+        CORONA_PROFILE_SCOPE(T::get_name());
+        const FrameArenaScope scratch;
+        const auto start = FrameSync::Clock::now();
+        if constexpr (kAdvances) {
+            if (ticket) {
+                T::advance(ticket->delta_time);
+            } else {
+                T::update();
+            }
+        } else {
+            T::update();
+        }
+        finish(start);
+    }
+
+    void finish(FrameSync::Clock::time_point start) {
+        const auto elapsed = FrameSync::Clock::now() - start;
+        sync_.leave(participant_, elapsed);
+        update_seconds_.record(elapsed);
+    }
+
+    FrameSync& sync_;
+    UpdateBudget& budget_;
+    const std::atomic<bool>& every_frame_;
+    std::size_t participant_;
+    LatencyHistogram& update_seconds_;
+    int applied_fps_;
+    float pending_time_ = 0.0f;
+    bool thread_named_ = false;
+};
+
+/**
+ * @brief 向系统管理器注册系统，同时加入帧同步、更新预算并按其读写声明加入帧图
+ */
+template <typename T>
+std::shared_ptr<SyncedSystem<T>> register_system(Kernel::ISystemManager& sys_mgr, FrameGraph& graph, FrameSync& sync,
+                                                 UpdateBudget& budget, const std::atomic<bool>& every_frame) {
+    auto system = std::make_shared<SyncedSystem<T>>(sync, budget, every_frame);
+    graph.add_node(std::string(system->get_name()), T::storage_access(),
+                   [system](float delta_time) { system->step(delta_time); });
+    sys_mgr.register_system(system);
+    return system;
+}
+
+constexpr auto kLockStepTimeout = std::chrono::milliseconds(1000);    ///< 锁步模式下等待系统完成一帧的上限
+constexpr auto kBudgetEvaluationInterval = std::chrono::milliseconds(500);  ///< 更新预算的评估间隔
+constexpr auto kMetricsFlushInterval = std::chrono::seconds(5);           ///< 指标文件的写入间隔
+
+constexpr std::uint64_t kFrameStatsLogInterval = 1200;  ///< 每隔多少帧输出一次帧时间统计
+
+void log_frame_time_stats(const FramePacer& pacer) {
+    const auto stats = pacer.stats();
+    CFW_LOG_DEBUG("Frame time (target {:.1f} FPS): p50 {:.2f} ms, p90 {:.2f} ms, p99 {:.2f} ms, max {:.2f} ms",
+                  pacer.target_rate(), stats.p50_ms, stats.p90_ms, stats.p99_ms, stats.max_ms);
+}
+
+/**
+ * @brief 以导出时求值的仪表登记各共享存储中的对象数量
+ */
+void register_storage_metrics() {
+    auto& registry = MetricsRegistry::instance();
+    auto& hub = SharedDataHub::instance();
+    const auto add = [&registry](const char* name, const auto& storage) {
+        registry.gauge_callback("corona_storage_objects", "Live objects per SharedDataHub storage",
+                                {{"storage", name}},
+                                [&storage] { return static_cast<double>(storage.size()); });
+    };
+
+    add("model_resource", hub.model_resource_storage());
+    add("model_transform", hub.model_transform_storage());
+    add("geometry", hub.geometry_storage());
+    add("kinematics", hub.kinematics_storage());
+    add("mechanics", hub.mechanics_storage());
+    add("acoustics", hub.acoustics_storage());
+    add("optics", hub.optics_storage());
+    add("profile", hub.profile_storage());
+    add("actor", hub.actor_storage());
+    add("camera", hub.camera_storage());
+    add("viewport", hub.viewport_storage());
+    add("environment", hub.environment_storage());
+    add("scene", hub.scene_storage());
+}
+
+bool flush_metrics(const std::filesystem::path& path) {
+    if (!MetricsRegistry::instance().write_prometheus(path)) {
+        CFW_LOG_WARNING("Failed to write metrics to {}", path.string());
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
 // ============================================================================
 // 构造与析构
 // ============================================================================
@@ -31,7 +216,12 @@ Engine::Engine()
       running_(false),
       exit_requested_(false),
       frame_number_(0),
-      last_frame_time_(0.0f) {
+      last_frame_time_(0.0f),
+      lock_step_delta_time_(0.0f),
+      every_frame_(false),
+      headless_(false),
+      execution_mode_(ExecutionMode::SystemThreads),
+      mechanics_system_(nullptr) {
 }
 
 Engine::~Engine() {
@@ -59,6 +249,15 @@ bool Engine::initialize() {
     CFW_LOG_NOTICE("CoronaEngine Initializing...");
     CFW_LOG_NOTICE("====================================");
 
+    // 设置了 CORONA_STORAGE_CONFIG 时在系统分配对象之前按文件配置各存储的预留容量与增长方式
+    if (const char* storage_config = std::getenv("CORONA_STORAGE_CONFIG"); storage_config && *storage_config) {
+        if (SharedDataHub::instance().load_storage_config(storage_config)) {
+            CFW_LOG_NOTICE("Storage configuration loaded from {}", storage_config);
+        } else {
+            CFW_LOG_WARNING("Storage configuration {} could not be fully applied", storage_config);
+        }
+    }
+
     // 2. 注册核心系统
     if (!register_systems()) {
         CFW_LOG_CRITICAL("Failed to register systems");
@@ -77,8 +276,27 @@ bool Engine::initialize() {
         return false;
     }
 
+    register_storage_metrics();
+    SharedDataHub::instance().publish_system_rates(update_budget_.rates());
+
+    // 设置了 CORONA_METRICS_FILE 时主循环定期以 Prometheus 文本格式写入指标
+    if (const char* metrics_file = std::getenv("CORONA_METRICS_FILE"); metrics_file && *metrics_file) {
+        metrics_file_ = metrics_file;
+        CFW_LOG_NOTICE("Metrics will be written to {} every {} s", metrics_file_.string(),
+                       std::chrono::duration_cast<std::chrono::seconds>(kMetricsFlushInterval).count());
+    }
+
     initialized_.store(true);
 
+#if defined(CORONA_ENABLE_PROFILER)
+    // 设置了 CORONA_TRACE_FILE 时从启动开始记录，关闭时写入该文件
+    if (const char* trace_file = std::getenv("CORONA_TRACE_FILE"); trace_file && *trace_file) {
+        trace_file_ = trace_file;
+        Profiler::instance().start();
+        CFW_LOG_NOTICE("Profiler capturing, trace will be written to {}", trace_file_.string());
+    }
+#endif
+
     CFW_LOG_NOTICE("====================================");
     CFW_LOG_NOTICE("CoronaEngine Initialized Successfully");
     CFW_LOG_NOTICE("====================================");
@@ -104,22 +322,33 @@ void Engine::run() {
     CFW_LOG_NOTICE("CoronaEngine Starting Main Loop");
     CFW_LOG_NOTICE("====================================");
 
-    // 启动所有系统线程
+    // 线程模式下启动所有系统线程；帧图模式下由主循环每帧调度系统更新
     auto* sys_mgr = kernel_.system_manager();
-    if (sys_mgr) {
+    if (execution_mode_ == ExecutionMode::FrameGraph) {
+        start_frame_pool();
+        CFW_LOG_NOTICE("Frame graph mode: {} systems on {} workers ({} for mechanics), critical path {}",
+                       frame_graph_.size(), frame_pool_->thread_count(),
+                       mechanics_system_ ? mechanics_system_->worker_count() : 0, frame_graph_.critical_path_length());
+    } else if (sys_mgr) {
         sys_mgr->start_all();
     }
 
+    CORONA_PROFILE_THREAD("Main");
+
     // 主循环
-    auto last_time = std::chrono::high_resolution_clock::now();
-    constexpr auto target_frame_duration = std::chrono::microseconds(8333);  // 120 FPS
+    auto last_time = std::chrono::steady_clock::now();
+    auto last_budget_evaluation = last_time;
+    auto last_metrics_flush = last_time;
+    auto& frame_seconds = MetricsRegistry::instance().histogram("corona_frame_seconds", "Main loop frame time");
+    frame_pacer_.reset();
 
     while (!exit_requested_.load()) {
-        auto frame_start_time = std::chrono::high_resolution_clock::now();
+        auto frame_start_time = std::chrono::steady_clock::now();
 
-        // 计算帧时间
+        // 计算帧时间；锁步时使用固定步长，使系统的推进与实测帧时间的抖动无关
         std::chrono::duration<float> delta_duration = frame_start_time - last_time;
-        last_frame_time_ = delta_duration.count();
+        last_frame_time_ = frame_sync_.lock_step() ? lock_step_delta_time() : delta_duration.count();
+        frame_seconds.record(frame_start_time - last_time);
         last_time = frame_start_time;
 
         // 执行一帧
@@ -129,17 +358,38 @@ void Engine::run() {
         // 帧号递增
         frame_number_++;
 
-        // 帧率控制（120 FPS）
-        auto frame_end_time = std::chrono::high_resolution_clock::now();
-        auto frame_elapsed = frame_end_time - frame_start_time;
+        // 帧率控制
+        frame_pacer_.wait();
+
+        // 定期评估各系统的更新预算，过载时降低低优先级系统的帧率；锁步时各系统每帧都需执行，不做调整。
+        // 评估后（锁步时也）把各系统的状态发布到 SharedDataHub，供脚本读取
+        const auto now = std::chrono::steady_clock::now();
+        if (now - last_budget_evaluation >= kBudgetEvaluationInterval) {
+            if (!frame_sync_.lock_step()) {
+                update_budget_.evaluate(frame_sync_.timings());
+            }
+            SharedDataHub::instance().publish_system_rates(update_budget_.rates());
+            last_budget_evaluation = now;
+        }
+
+        if (!metrics_file_.empty() && now - last_metrics_flush >= kMetricsFlushInterval) {
+            flush_metrics(metrics_file_);
+            last_metrics_flush = now;
+        }
 
-        // 计算剩余时间并 sleep
-        if (frame_elapsed < target_frame_duration) {
-            auto sleep_duration = target_frame_duration - frame_elapsed;
-            std::this_thread::sleep_for(sleep_duration);
+        if (frame_number_ % kFrameStatsLogInterval == 0) {
+            log_frame_time_stats(frame_pacer_);
         }
     }
 
+    // 唤醒锁步中等待下一帧的系统线程，使其能够被正常停止
+    frame_sync_.release();
+    stop_frame_pool();
+
+    const auto stats = frame_pacer_.stats();
+    CFW_LOG_NOTICE("Frame time over last {} frames: avg {:.2f} ms, p50 {:.2f} ms, p90 {:.2f} ms, p99 {:.2f} ms, max {:.2f} ms",
+                   stats.samples, stats.average_ms, stats.p50_ms, stats.p90_ms, stats.p99_ms, stats.max_ms);
+
     CFW_LOG_NOTICE("====================================");
     CFW_LOG_NOTICE("CoronaEngine Main Loop Exited");
     CFW_LOG_NOTICE("====================================");
@@ -147,6 +397,70 @@ void Engine::run() {
     running_.store(false);
 }
 
+BatchRunStats Engine::run_frames(std::uint64_t frames, float fixed_dt, double time_scale) {
+    BatchRunStats stats;
+
+    if (!initialized_.load()) {
+        CFW_LOG_CRITICAL("Cannot run frames: engine not initialized");
+        return stats;
+    }
+
+    if (running_.load()) {
+        CFW_LOG_WARNING("Engine is already running");
+        return stats;
+    }
+
+    if (fixed_dt <= 0.0f) {
+        CFW_LOG_WARNING("run_frames requires a positive fixed_dt, got {}", fixed_dt);
+        return stats;
+    }
+
+    running_.store(true);
+    exit_requested_.store(false);
+    every_frame_.store(true);
+
+    // 与帧图模式相同，由调用线程在线程池上驱动所有系统
+    start_frame_pool();
+    CFW_LOG_NOTICE("Running {} frames at dt {} s ({}): {} systems on {} workers", frames, fixed_dt,
+                   time_scale > 0.0 ? "paced" : "uncapped", frame_graph_.size(), frame_pool_->thread_count());
+
+    // 按倍速运行时使用独立的帧率控制器，不影响主循环的设置
+    FramePacer pacer;
+    pacer.set_target_rate(time_scale > 0.0 ? time_scale / fixed_dt : 0.0);
+
+    CORONA_PROFILE_THREAD("Main");
+    const auto start_time = std::chrono::steady_clock::now();
+    pacer.reset();
+
+    while (stats.frames < frames && !exit_requested_.load()) {
+        last_frame_time_ = fixed_dt;
+        tick();
+        frame_number_++;
+        stats.frames++;
+
+        if (time_scale > 0.0) {
+            pacer.wait();
+        }
+    }
+
+    const std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start_time;
+    stop_frame_pool();
+    every_frame_.store(false);
+
+    stats.simulated_seconds = static_cast<double>(stats.frames) * fixed_dt;
+    stats.wall_seconds = wall.count();
+    if (stats.wall_seconds > 0.0) {
+        stats.frames_per_second = static_cast<double>(stats.frames) / stats.wall_seconds;
+        stats.realtime_factor = stats.simulated_seconds / stats.wall_seconds;
+    }
+
+    CFW_LOG_NOTICE("Ran {} frames ({:.3f} s simulated) in {:.3f} s: {:.1f} frames/s, {:.2f}x real time", stats.frames,
+                   stats.simulated_seconds, stats.wall_seconds, stats.frames_per_second, stats.realtime_factor);
+
+    running_.store(false);
+    return stats;
+}
+
 void Engine::request_exit() {
     exit_requested_.store(true);
 
@@ -168,15 +482,136 @@ void Engine::shutdown() {
     CFW_LOG_NOTICE("CoronaEngine Shutting Down...");
     CFW_LOG_NOTICE("====================================");
 
+    if (!trace_file_.empty()) {
+        Profiler::instance().stop();
+        if (Profiler::instance().write_chrome_trace(trace_file_)) {
+            CFW_LOG_NOTICE("Profiler trace written to {}", trace_file_.string());
+        } else {
+            CFW_LOG_WARNING("Failed to write profiler trace to {}", trace_file_.string());
+        }
+        trace_file_.clear();
+    }
+
+    if (!metrics_file_.empty()) {
+        if (flush_metrics(metrics_file_)) {
+            CFW_LOG_NOTICE("Metrics written to {}", metrics_file_.string());
+        }
+        metrics_file_.clear();
+    }
+
     // 关闭内核（SystemManager 的析构函数会自动调用 shutdown_all() 和 stop_all()）
     // 注意：kernel_.shutdown() 会重置 logger，所以之后不能再使用 logger 指针
     kernel_.shutdown();
+    mechanics_system_ = nullptr;
 
     initialized_.store(false);
 
     // 不要在 kernel_.shutdown() 之后使用 logger，因为它已经被释放
 }
 
+// ============================================================================
+// 执行方式
+// ============================================================================
+
+void Engine::set_headless(bool headless) {
+    if (initialized_.load()) {
+        CFW_LOG_WARNING("Cannot change headless mode after the engine is initialized");
+        return;
+    }
+    headless_ = headless;
+}
+
+bool Engine::is_headless() const {
+    return headless_;
+}
+
+void Engine::set_execution_mode(ExecutionMode mode) {
+    if (running_.load()) {
+        CFW_LOG_WARNING("Cannot change execution mode while the engine is running");
+        return;
+    }
+    execution_mode_ = mode;
+}
+
+ExecutionMode Engine::execution_mode() const {
+    return execution_mode_;
+}
+
+const FrameGraph& Engine::frame_graph() const {
+    return frame_graph_;
+}
+
+void Engine::start_frame_pool() {
+    // 帧图最多同时执行全部节点，帧线程数不超过节点数；力学节点所在的帧线程同时是力学线程池的 0 号参与者，
+    // 因此力学线程池取剩余核心数加一，两个线程池合计不超过硬件线程数
+    const std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t frame_workers = std::clamp<std::size_t>(frame_graph_.size(), 1, hardware);
+    frame_pool_ = std::make_unique<WorkStealingPool>(frame_workers);
+    if (mechanics_system_) {
+        mechanics_system_->set_auto_worker_count(hardware - frame_workers + 1);
+    }
+}
+
+void Engine::stop_frame_pool() {
+    frame_pool_.reset();
+    if (mechanics_system_) {
+        mechanics_system_->set_auto_worker_count(0);
+    }
+}
+
+// ============================================================================
+// 帧率控制
+// ============================================================================
+
+FramePacer& Engine::frame_pacer() {
+    return frame_pacer_;
+}
+
+const FramePacer& Engine::frame_pacer() const {
+    return frame_pacer_;
+}
+
+// ============================================================================
+// 帧同步
+// ============================================================================
+
+void Engine::set_lock_step(bool enabled) {
+    frame_sync_.set_lock_step(enabled);
+}
+
+bool Engine::is_lock_step() const {
+    return frame_sync_.lock_step();
+}
+
+void Engine::set_lock_step_delta_time(float delta_time) {
+    lock_step_delta_time_.store(delta_time);
+}
+
+float Engine::lock_step_delta_time() const {
+    const float delta_time = lock_step_delta_time_.load();
+    if (delta_time > 0.0f) {
+        return delta_time;
+    }
+    const double rate = frame_pacer_.target_rate();
+    return static_cast<float>(1.0 / (rate > 0.0 ? rate : FramePacer::kDefaultTargetRate));
+}
+
+std::vector<FrameSync::SystemTiming> Engine::system_timings() const {
+    return frame_sync_.timings();
+}
+
+// ============================================================================
+// 更新预算
+// ============================================================================
+
+UpdateBudget& Engine::update_budget() {
+    return update_budget_;
+}
+
+std::vector<SystemRate> Engine::system_rates() const {
+    return update_budget_.rates();
+}
+
 // ============================================================================
 // 状态查询
 // ============================================================================
@@ -225,31 +660,36 @@ bool Engine::register_systems() {
 
     CFW_LOG_INFO("Registering core systems...");
 
-    // Display System - 最高优先级
-    sys_mgr->register_system(std::make_shared<Systems::DisplaySystem>());
-    CFW_LOG_INFO("  - DisplaySystem registered (priority 100)");
-
-    // Optics System (光学系统)
-    sys_mgr->register_system(std::make_shared<Systems::OpticsSystem>());
-    CFW_LOG_INFO("  - OpticsSystem registered (priority 90)");
+    // 无头模式下不需要窗口与 GPU，跳过显示与光学系统
+    if (headless_) {
+        CFW_LOG_INFO("  - Headless mode: DisplaySystem and OpticsSystem skipped");
+    } else {
+        // Display System - 最高优先级
+        register_system<Systems::DisplaySystem>(*sys_mgr, frame_graph_, frame_sync_, update_budget_, every_frame_);
+        CFW_LOG_INFO("  - DisplaySystem registered (priority 100)");
+
+        // Optics System (光学系统)
+        register_system<Systems::OpticsSystem>(*sys_mgr, frame_graph_, frame_sync_, update_budget_, every_frame_);
+        CFW_LOG_INFO("  - OpticsSystem registered (priority 90)");
+    }
 
     // Geometry System (几何系统)
-    sys_mgr->register_system(std::make_shared<Systems::GeometrySystem>());
+    register_system<Systems::GeometrySystem>(*sys_mgr, frame_graph_, frame_sync_, update_budget_, every_frame_);
     CFW_LOG_INFO("  - GeometrySystem registered (priority 85)");
 
     // Animation System (动画系统)
-    sys_mgr->register_system(std::make_shared<Systems::KinematicsSystem>());
+    register_system<Systems::KinematicsSystem>(*sys_mgr, frame_graph_, frame_sync_, update_budget_, every_frame_);
     CFW_LOG_INFO("  - AnimationSystem registered (priority 80)");
 
     // Mechanics System (力学系统)
-    sys_mgr->register_system(std::make_shared<Systems::MechanicsSystem>());
+    mechanics_system_ = register_system<Systems::MechanicsSystem>(*sys_mgr, frame_graph_, frame_sync_, update_budget_, every_frame_);
     CFW_LOG_INFO("  - MechanicsSystem registered (priority 75)");
 
     // Acoustics System (声学系统)
-    sys_mgr->register_system(std::make_shared<Systems::AcousticsSystem>());
+    register_system<Systems::AcousticsSystem>(*sys_mgr, frame_graph_, frame_sync_, update_budget_, every_frame_);
     CFW_LOG_INFO("  - AcousticsSystem registered (priority 70)");
 
-    sys_mgr->register_system(std::make_shared<Systems::ScriptSystem>());
+    register_system<Systems::ScriptSystem>(*sys_mgr, frame_graph_, frame_sync_, update_budget_, every_frame_);
     CFW_LOG_INFO("  - ScriptSystem registered (priority 60)");
 
     CFW_LOG_NOTICE("All core systems registered successfully");
@@ -258,13 +698,36 @@ bool Engine::register_systems() {
 }
 
 void Engine::tick() {
-    // 4. 更新系统上下文的帧信息
-    // 系统通过 SystemBase 的 delta_time() 和 frame_number() 访问帧信息
+    CORONA_PROFILE_SCOPE("Engine::tick");
+    const auto tick_start = std::chrono::steady_clock::now();
+    auto* stream = kernel_.event_stream();
 
-    // 5. 同步所有系统（可选）
-    // 系统在各自的线程中运行，主循环可以在这里进行跨系统的同步
+    // 1. 广播帧开始
+    if (stream) {
+        stream->get_stream<Events::FrameBeginEvent>()->publish(Events::FrameBeginEvent{frame_number_, last_frame_time_});
+    }
 
-    // 6. 收集性能统计
+    if (frame_pool_) {
+        // 2. 帧图模式或 run_frames()：按数据依赖并行执行本帧的系统更新，返回时全部完成
+        frame_graph_.execute(last_frame_time_, *frame_pool_);
+    } else {
+        // 2. 线程模式：锁步时放行各系统线程执行本帧，并等待全部完成
+        frame_sync_.begin_frame(frame_number_, last_frame_time_);
+        if (!frame_sync_.end_frame(kLockStepTimeout)) {
+            CFW_LOG_WARNING("Lock-step frame {} timed out waiting for systems", frame_number_);
+        }
+    }
+
+    // 3. 发布本帧结束时的变换快照，供渲染无锁读取；无头模式下没有读者
+    if (!headless_) {
+        SharedDataHub::instance().publish_model_transforms(frame_number_);
+    }
+
+    // 4. 广播帧结束
+    if (stream) {
+        const std::chrono::duration<float> frame_time = std::chrono::steady_clock::now() - tick_start;
+        stream->get_stream<Events::FrameEndEvent>()->publish(Events::FrameEndEvent{frame_number_, frame_time.count()});
+    }
 }
 
 }  // namespace Corona
\ No newline at end of file
@@ -0,0 +1,53 @@
+#include <corona/frame_arena.h>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace Corona {
+
+FrameArena::FrameArena(std::size_t block_size) : block_size_(std::max<std::size_t>(block_size, 1)) {}
+
+FrameArena& FrameArena::current() {
+    thread_local FrameArena arena;
+    return arena;
+}
+
+void* FrameArena::allocate(std::size_t bytes, std::size_t alignment) {
+    // 从当前块开始查找放得下的块，跳过的块末尾留到下次回卷后再用
+    for (; block_ < blocks_.size(); ++block_, offset_ = 0) {
+        const Block& block = blocks_[block_];
+        const auto base = reinterpret_cast<std::uintptr_t>(block.data.get());
+        const auto aligned = (base + offset_ + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+        const std::size_t end = aligned - base + bytes;
+        if (end <= block.size) {
+            offset_ = end;
+            return reinterpret_cast<void*>(aligned);
+        }
+    }
+
+    // new 只保证默认对齐，额外预留 alignment 字节用于对齐
+    const std::size_t size = std::max(block_size_, bytes + alignment);
+    blocks_.push_back({std::make_unique_for_overwrite<std::byte[]>(size), size});
+    const auto base = reinterpret_cast<std::uintptr_t>(blocks_.back().data.get());
+    const auto aligned = (base + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+    offset_ = aligned - base + bytes;
+    return reinterpret_cast<void*>(aligned);
+}
+
+std::size_t FrameArena::used() const {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < block_ && i < blocks_.size(); ++i) {
+        total += blocks_[i].size;
+    }
+    return total + offset_;
+}
+
+std::size_t FrameArena::capacity() const {
+    std::size_t total = 0;
+    for (const auto& block : blocks_) {
+        total += block.size;
+    }
+    return total;
+}
+
+}  // namespace Corona
@@ -0,0 +1,116 @@
+#include <corona/frame_graph.h>
+#include <corona/job_pool.h>
+#include <corona/profiler.h>
+
+#include <algorithm>
+#include <chrono>
+
+namespace Corona {
+
+std::size_t FrameGraph::add_node(std::string name, const StorageAccess& access, Task task) {
+    const auto index = static_cast<std::uint32_t>(nodes_.size());
+
+    NodeInfo info;
+    info.name = std::move(name);
+    info.access = access;
+
+    // 与之前注册的节点访问冲突时，按注册顺序先执行之前的节点
+    for (std::uint32_t earlier = 0; earlier < index; ++earlier) {
+        if (info_[earlier].access.conflicts_with(access)) {
+            info.dependencies.push_back(earlier);
+            nodes_[earlier].successors.push_back(index);
+        }
+    }
+
+    Node node;
+    node.task = std::move(task);
+    node.predecessor_count = static_cast<std::uint32_t>(info.dependencies.size());
+
+    nodes_.push_back(std::move(node));
+    info_.push_back(std::move(info));
+    return index;
+}
+
+std::size_t FrameGraph::critical_path_length() const {
+    // 节点按注册顺序拓扑有序，依赖总是指向更早的节点
+    std::vector<std::size_t> depth(info_.size(), 1);
+    std::size_t longest = 0;
+    for (std::size_t i = 0; i < info_.size(); ++i) {
+        for (const std::uint32_t dependency : info_[i].dependencies) {
+            depth[i] = std::max(depth[i], depth[dependency] + 1);
+        }
+        longest = std::max(longest, depth[i]);
+    }
+    return longest;
+}
+
+void FrameGraph::execute(float delta_time, WorkStealingPool& pool) {
+    if (nodes_.empty()) {
+        return;
+    }
+
+    CORONA_PROFILE_SCOPE("FrameGraph::execute");
+
+    {
+        std::lock_guard lock(mutex_);
+        ready_.clear();
+        pending_.resize(nodes_.size());
+        for (std::uint32_t i = 0; i < nodes_.size(); ++i) {
+            pending_[i] = nodes_[i].predecessor_count;
+            if (pending_[i] == 0) {
+                ready_.push_back(i);
+            }
+        }
+        completed_ = 0;
+    }
+
+    // 每个参与者领取一个区间，在区间内持续领取就绪节点直到整帧完成。
+    // 调用线程是 0 号参与者，且其他参与者在整帧完成前不会返回去窃取，因此 0 号区间必由调用线程执行。
+    pool.parallel_for(pool.thread_count(), 1, [this, delta_time](const JobRange& range) {
+        std::uint32_t index = 0;
+        while (take_ready(range.worker, index)) {
+            run_node(index, delta_time);
+        }
+    });
+}
+
+bool FrameGraph::take_ready(std::size_t worker, std::uint32_t& out) {
+    std::unique_lock lock(mutex_);
+    while (true) {
+        if (completed_ == nodes_.size()) {
+            return false;
+        }
+
+        // 非主线程参与者跳过只能在主线程执行的节点
+        const auto it = std::find_if(ready_.begin(), ready_.end(), [this, worker](std::uint32_t index) {
+            return worker == 0 || !info_[index].access.main_thread;
+        });
+        if (it != ready_.end()) {
+            out = *it;
+            ready_.erase(it);
+            return true;
+        }
+
+        ready_cv_.wait(lock);
+    }
+}
+
+void FrameGraph::run_node(std::uint32_t index, float delta_time) {
+    const auto start = std::chrono::steady_clock::now();
+    nodes_[index].task(delta_time);
+    const std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    {
+        std::lock_guard lock(mutex_);
+        info_[index].last_duration_ms = elapsed.count();
+        for (const std::uint32_t successor : nodes_[index].successors) {
+            if (--pending_[successor] == 0) {
+                ready_.push_back(successor);
+            }
+        }
+        ++completed_;
+    }
+    ready_cv_.notify_all();
+}
+
+}  // namespace Corona
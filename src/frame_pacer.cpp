@@ -0,0 +1,164 @@
+#include <corona/frame_pacer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <ctime>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+namespace Corona {
+
+namespace {
+
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+/**
+ * @brief 睡眠到绝对截止时间
+ */
+void sleep_until(std::chrono::steady_clock::time_point deadline) {
+#if defined(__linux__)
+    // libstdc++ 与 libc++ 的 steady_clock 在 Linux 上均基于 CLOCK_MONOTONIC，时间点可直接换算
+    const auto since_epoch = deadline.time_since_epoch();
+    const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+    timespec ts{};
+    ts.tv_sec = static_cast<time_t>(seconds.count());
+    ts.tv_nsec = static_cast<long>(std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch - seconds).count());
+    // 被信号打断时以同一截止时间继续睡眠
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+    }
+#else
+    std::this_thread::sleep_until(deadline);
+#endif
+}
+
+}  // namespace
+
+void FramePacer::set_target_rate(double frames_per_second) {
+    target_rate_.store(frames_per_second, std::memory_order_relaxed);
+}
+
+double FramePacer::target_rate() const {
+    return target_rate_.load(std::memory_order_relaxed);
+}
+
+void FramePacer::set_mode(PacingMode mode) {
+    mode_.store(mode, std::memory_order_relaxed);
+}
+
+PacingMode FramePacer::mode() const {
+    return mode_.load(std::memory_order_relaxed);
+}
+
+void FramePacer::set_spin_threshold(std::chrono::microseconds threshold) {
+    spin_threshold_us_.store(std::max<std::int64_t>(0, threshold.count()), std::memory_order_relaxed);
+}
+
+std::chrono::microseconds FramePacer::spin_threshold() const {
+    return std::chrono::microseconds(spin_threshold_us_.load(std::memory_order_relaxed));
+}
+
+void FramePacer::reset() {
+    started_ = true;
+    last_frame_ = Clock::now();
+    next_deadline_ = last_frame_;
+
+    std::lock_guard lock(stats_mutex_);
+    frame_count_ = 0;
+}
+
+void FramePacer::wait() {
+    if (!started_) {
+        reset();
+    }
+
+    const PacingMode mode = this->mode();
+    const double rate = target_rate();
+
+    if (mode != PacingMode::Uncapped && rate > 0.0) {
+        const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rate));
+        Clock::time_point deadline = next_deadline_ + period;
+
+        // 落后超过一帧时放弃追赶，从当前时间重新开始
+        const auto now = Clock::now();
+        if (now > deadline + period) {
+            deadline = now;
+        }
+
+        if (mode == PacingMode::Hybrid) {
+            const auto spin = spin_threshold();
+            if (deadline - now > spin) {
+                sleep_until(deadline - spin);
+            }
+            while (Clock::now() < deadline) {
+                cpu_relax();
+            }
+        } else if (now < deadline) {
+            sleep_until(deadline);
+        }
+
+        next_deadline_ = deadline;
+    }
+
+    const auto frame_end = Clock::now();
+    if (mode == PacingMode::Uncapped || rate <= 0.0) {
+        next_deadline_ = frame_end;
+    }
+    record(frame_end - last_frame_);
+    last_frame_ = frame_end;
+}
+
+void FramePacer::record(Clock::duration frame_time) {
+    const std::chrono::duration<float, std::milli> ms = frame_time;
+
+    std::lock_guard lock(stats_mutex_);
+    frame_times_ms_[frame_count_ % kStatsWindow] = ms.count();
+    ++frame_count_;
+}
+
+FrameTimeStats FramePacer::stats() const {
+    std::vector<float> samples;
+    {
+        std::lock_guard lock(stats_mutex_);
+        const std::size_t count = std::min(frame_count_, kStatsWindow);
+        samples.assign(frame_times_ms_.begin(), frame_times_ms_.begin() + static_cast<std::ptrdiff_t>(count));
+    }
+
+    FrameTimeStats result;
+    result.samples = samples.size();
+    if (samples.empty()) {
+        return result;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    const auto percentile = [&samples](double p) {
+        const auto rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(samples.size())));
+        return static_cast<double>(samples[std::clamp<std::size_t>(rank, 1, samples.size()) - 1]);
+    };
+
+    double sum = 0.0;
+    for (const float sample : samples) {
+        sum += sample;
+    }
+    result.average_ms = sum / static_cast<double>(samples.size());
+    result.p50_ms = percentile(0.50);
+    result.p90_ms = percentile(0.90);
+    result.p99_ms = percentile(0.99);
+    result.max_ms = samples.back();
+    return result;
+}
+
+}  // namespace Corona
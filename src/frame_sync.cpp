@@ -0,0 +1,112 @@
+#include <corona/frame_sync.h>
+
+#include <algorithm>
+
+namespace Corona {
+
+namespace {
+
+constexpr float kAverageWeight = 0.1f;  ///< 滑动平均中最新一次更新的权重
+
+}  // namespace
+
+std::size_t FrameSync::add_participant(std::string name) {
+    std::lock_guard lock(mutex_);
+    auto participant = std::make_unique<Participant>();
+    participant->timing.name = std::move(name);
+    participants_.push_back(std::move(participant));
+    return participants_.size() - 1;
+}
+
+void FrameSync::set_lock_step(bool enabled) {
+    std::lock_guard lock(mutex_);
+    requested_ = enabled;
+}
+
+bool FrameSync::lock_step() const {
+    std::lock_guard lock(mutex_);
+    return requested_;
+}
+
+std::optional<FrameSync::Ticket> FrameSync::enter(std::size_t participant) {
+    std::unique_lock lock(mutex_);
+    Participant& self = *participants_[participant];
+
+    // 等待引擎开始本参与者尚未处理过的一帧
+    frame_cv_.wait(lock, [this, &self] { return !active_ || self.generation != generation_; });
+    if (!active_) {
+        return std::nullopt;
+    }
+
+    self.generation = generation_;
+    self.in_frame = true;
+    return current_;
+}
+
+void FrameSync::leave(std::size_t participant, Clock::duration elapsed) {
+    const std::chrono::duration<float, std::milli> ms = elapsed;
+
+    bool arrived = false;
+    {
+        std::lock_guard lock(mutex_);
+        Participant& self = *participants_[participant];
+
+        SystemTiming& timing = self.timing;
+        timing.last_ms = ms.count();
+        timing.average_ms =
+            timing.updates == 0 ? ms.count() : timing.average_ms + (ms.count() - timing.average_ms) * kAverageWeight;
+        timing.max_ms = std::max(timing.max_ms, ms.count());
+        ++timing.updates;
+
+        // 超时后才完成的旧帧不计入当前帧
+        if (self.in_frame) {
+            self.in_frame = false;
+            if (active_ && self.generation == generation_) {
+                arrived = ++arrived_ == participants_.size();
+            }
+        }
+    }
+    if (arrived) {
+        done_cv_.notify_one();
+    }
+}
+
+void FrameSync::begin_frame(std::uint64_t frame_number, float delta_time) {
+    {
+        std::lock_guard lock(mutex_);
+        if (!requested_ && !active_) {
+            return;
+        }
+        active_ = requested_ && !participants_.empty();
+        current_ = Ticket{frame_number, delta_time};
+        ++generation_;
+        arrived_ = 0;
+    }
+    frame_cv_.notify_all();
+}
+
+bool FrameSync::end_frame(std::chrono::milliseconds timeout) {
+    std::unique_lock lock(mutex_);
+    return done_cv_.wait_for(lock, timeout, [this] { return !active_ || arrived_ == participants_.size(); });
+}
+
+void FrameSync::release() {
+    {
+        std::lock_guard lock(mutex_);
+        active_ = false;
+    }
+    frame_cv_.notify_all();
+    done_cv_.notify_all();
+}
+
+std::vector<FrameSync::SystemTiming> FrameSync::timings() const {
+    std::lock_guard lock(mutex_);
+    std::vector<SystemTiming> result;
+    result.reserve(participants_.size());
+    for (const auto& participant : participants_) {
+        result.push_back(participant->timing);
+    }
+    return result;
+}
+
+}  // namespace Corona
@@ -0,0 +1,142 @@
+#include <corona/job_pool.h>
+
+#include <algorithm>
+
+namespace Corona {
+
+std::size_t WorkStealingPool::default_thread_count() {
+    // 其余系统各占一个线程，这里保留一半硬件线程给它们
+    const std::size_t hardware = std::thread::hardware_concurrency();
+    return std::max<std::size_t>(1, hardware / 2);
+}
+
+WorkStealingPool::WorkStealingPool(std::size_t thread_count) {
+    if (thread_count == 0) {
+        thread_count = default_thread_count();
+    }
+
+    queues_.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+
+    // 0 号参与者为调用线程，只需为其余参与者创建线程
+    threads_.reserve(thread_count - 1);
+    for (std::size_t i = 1; i < thread_count; ++i) {
+        threads_.emplace_back([this, i] { worker_loop(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard lock(state_mutex_);
+        stopping_ = true;
+    }
+    wake_cv_.notify_all();
+
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+void WorkStealingPool::parallel_for(std::size_t count, std::size_t grain, const RangeFn& fn) {
+    if (count == 0) {
+        return;
+    }
+    grain = std::max<std::size_t>(1, grain);
+
+    const std::size_t chunks = chunk_count(count, grain);
+
+    // 单线程或只有一个区间时直接在调用线程执行，避免唤醒开销
+    if (threads_.empty() || chunks == 1) {
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+            const std::size_t begin = chunk * grain;
+            fn(JobRange{chunk, begin, std::min(count, begin + grain), 0});
+        }
+        return;
+    }
+
+    job_ = &fn;
+    remaining_.store(chunks, std::memory_order_release);
+
+    // 连续区间轮流分配到各队列，初始负载大致均衡，不均部分由窃取弥补
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        const std::size_t begin = chunk * grain;
+        auto& queue = *queues_[chunk % queues_.size()];
+        std::lock_guard lock(queue.mutex);
+        queue.ranges.push_back(JobRange{chunk, begin, std::min(count, begin + grain), 0});
+    }
+
+    {
+        std::lock_guard lock(state_mutex_);
+        ++generation_;
+    }
+    wake_cv_.notify_all();
+
+    run_ranges(0);
+
+    {
+        std::unique_lock lock(state_mutex_);
+        done_cv_.wait(lock, [this] { return remaining_.load(std::memory_order_acquire) == 0; });
+    }
+    job_ = nullptr;
+}
+
+void WorkStealingPool::worker_loop(std::size_t index) {
+    std::uint64_t seen_generation = 0;
+    while (true) {
+        {
+            std::unique_lock lock(state_mutex_);
+            wake_cv_.wait(lock, [&] { return stopping_ || generation_ != seen_generation; });
+            if (stopping_) {
+                return;
+            }
+            seen_generation = generation_;
+        }
+        run_ranges(index);
+    }
+}
+
+void WorkStealingPool::run_ranges(std::size_t index) {
+    JobRange range{};
+    while (pop_or_steal(index, range)) {
+        range.worker = index;
+        (*job_)(range);
+
+        if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard lock(state_mutex_);
+            done_cv_.notify_all();
+        }
+    }
+}
+
+bool WorkStealingPool::pop_or_steal(std::size_t index, JobRange& out) {
+    // 先处理自己的队列（队尾）
+    {
+        auto& own = *queues_[index];
+        std::lock_guard lock(own.mutex);
+        if (!own.ranges.empty()) {
+            out = own.ranges.back();
+            own.ranges.pop_back();
+            return true;
+        }
+    }
+
+    // 再依次从其他队列的队首窃取
+    const std::size_t count = queues_.size();
+    for (std::size_t offset = 1; offset < count; ++offset) {
+        auto& victim = *queues_[(index + offset) % count];
+        std::lock_guard lock(victim.mutex);
+        if (!victim.ranges.empty()) {
+            out = victim.ranges.front();
+            victim.ranges.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+}  // namespace Corona
@@ -0,0 +1,254 @@
+#include <corona/metrics.h>
+
+#include <corona/kernel/core/i_logger.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <system_error>
+
+namespace Corona {
+
+namespace {
+
+constexpr std::array<double, 3> kQuantiles{0.5, 0.9, 0.99};
+
+const char* type_name(MetricsRegistry::Type type) {
+    switch (type) {
+        case MetricsRegistry::Type::Counter:
+            return "counter";
+        case MetricsRegistry::Type::Gauge:
+            return "gauge";
+        case MetricsRegistry::Type::Histogram:
+            return "summary";
+    }
+    return "untyped";
+}
+
+/**
+ * @brief 序列化为 {k="v",...}，可附加一个额外标签
+ */
+std::string format_labels(const MetricLabels& labels, const char* extra_key = nullptr, const std::string& extra_value = {}) {
+    if (labels.empty() && !extra_key) {
+        return {};
+    }
+
+    std::string result = "{";
+    const auto append = [&result](const std::string& key, const std::string& value) {
+        if (result.size() > 1) {
+            result += ',';
+        }
+        result += key;
+        result += "=\"";
+        for (const char c : value) {
+            if (c == '\\' || c == '"') {
+                result += '\\';
+                result += c;
+            } else if (c == '\n') {
+                result += "\\n";
+            } else {
+                result += c;
+            }
+        }
+        result += '"';
+    };
+    for (const auto& [key, value] : labels) {
+        append(key, value);
+    }
+    if (extra_key) {
+        append(extra_key, extra_value);
+    }
+    result += '}';
+    return result;
+}
+
+}  // namespace
+
+// ============================================================================
+// LatencyHistogram
+// ============================================================================
+
+std::size_t LatencyHistogram::bucket_of(std::uint64_t value) noexcept {
+    // 小于子桶数的值线性分桶，其余按最高位所在的 2 的幂区间再细分
+    if (value < kSubBuckets) {
+        return static_cast<std::size_t>(value);
+    }
+    const unsigned exponent = static_cast<unsigned>(std::bit_width(value)) - 1;
+    const unsigned shift = exponent - kSubBucketBits;
+    const std::size_t sub = static_cast<std::size_t>(value >> shift) & (kSubBuckets - 1);
+    return (shift + 1) * kSubBuckets + sub;
+}
+
+double LatencyHistogram::bucket_midpoint(std::size_t bucket) noexcept {
+    if (bucket < kSubBuckets) {
+        return static_cast<double>(bucket);
+    }
+    const std::size_t shift = bucket / kSubBuckets - 1;
+    const std::size_t sub = bucket % kSubBuckets;
+    const double lower = std::ldexp(static_cast<double>(kSubBuckets + sub), static_cast<int>(shift));
+    const double width = std::ldexp(1.0, static_cast<int>(shift));
+    return lower + width * 0.5;
+}
+
+double LatencyHistogram::quantile_seconds(double q) const noexcept {
+    const std::uint64_t total = count();
+    if (total == 0) {
+        return 0.0;
+    }
+
+    const auto target = static_cast<std::uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(total)));
+    std::uint64_t seen = 0;
+    for (std::size_t bucket = 0; bucket < kBucketCount; ++bucket) {
+        seen += buckets_[bucket].load(std::memory_order_relaxed);
+        if (seen >= std::max<std::uint64_t>(target, 1)) {
+            return bucket_midpoint(bucket) * 1e-9;
+        }
+    }
+    return bucket_midpoint(kBucketCount - 1) * 1e-9;
+}
+
+// ============================================================================
+// MetricsRegistry
+// ============================================================================
+
+MetricsRegistry& MetricsRegistry::instance() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+MetricsRegistry::Entry& MetricsRegistry::find_or_add(Type type, const std::string& name, const std::string& help,
+                                                     const MetricLabels& labels) {
+    auto [it, inserted] = entries_.try_emplace({name, format_labels(labels)});
+    Entry& entry = it->second;
+    if (inserted) {
+        entry.type = type;
+        entry.help = help;
+        entry.labels = labels;
+    } else if (entry.type != type) {
+        CFW_LOG_ERROR("Metric {} registered as {} but requested as {}", name, type_name(entry.type), type_name(type));
+    }
+    return entry;
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help, const MetricLabels& labels) {
+    std::lock_guard lock(mutex_);
+    Entry& entry = find_or_add(Type::Counter, name, help, labels);
+    if (!entry.counter) {
+        entry.counter = std::make_unique<Counter>();
+    }
+    return *entry.counter;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help, const MetricLabels& labels) {
+    std::lock_guard lock(mutex_);
+    Entry& entry = find_or_add(Type::Gauge, name, help, labels);
+    if (!entry.gauge) {
+        entry.gauge = std::make_unique<Gauge>();
+    }
+    return *entry.gauge;
+}
+
+LatencyHistogram& MetricsRegistry::histogram(const std::string& name, const std::string& help,
+                                             const MetricLabels& labels) {
+    std::lock_guard lock(mutex_);
+    Entry& entry = find_or_add(Type::Histogram, name, help, labels);
+    if (!entry.histogram) {
+        entry.histogram = std::make_unique<LatencyHistogram>();
+    }
+    return *entry.histogram;
+}
+
+void MetricsRegistry::gauge_callback(const std::string& name, const std::string& help, const MetricLabels& labels,
+                                     std::function<double()> read) {
+    std::lock_guard lock(mutex_);
+    Entry& entry = find_or_add(Type::Gauge, name, help, labels);
+    entry.read = std::move(read);
+}
+
+std::vector<MetricsRegistry::Series> MetricsRegistry::collect() const {
+    std::lock_guard lock(mutex_);
+    std::vector<Series> result;
+    result.reserve(entries_.size());
+
+    for (const auto& [key, entry] : entries_) {
+        const std::string& name = key.first;
+        const std::string& labels = key.second;
+        switch (entry.type) {
+            case Type::Counter:
+                result.push_back({&entry, name, name + labels,
+                                  entry.counter ? static_cast<double>(entry.counter->value()) : 0.0});
+                break;
+            case Type::Gauge:
+                result.push_back({&entry, name, name + labels,
+                                  entry.read ? entry.read() : (entry.gauge ? entry.gauge->value() : 0.0)});
+                break;
+            case Type::Histogram:
+                if (!entry.histogram) {
+                    break;
+                }
+                for (const double q : kQuantiles) {
+                    std::ostringstream quantile;
+                    quantile << q;
+                    result.push_back({&entry, name, name + format_labels(entry.labels, "quantile", quantile.str()),
+                                      entry.histogram->quantile_seconds(q)});
+                }
+                result.push_back({&entry, name, name + "_sum" + labels, entry.histogram->sum_seconds()});
+                result.push_back({&entry, name, name + "_count" + labels, static_cast<double>(entry.histogram->count())});
+                break;
+        }
+    }
+    return result;
+}
+
+std::vector<std::pair<std::string, double>> MetricsRegistry::series() const {
+    std::vector<std::pair<std::string, double>> result;
+    for (auto& sample : collect()) {
+        result.emplace_back(std::move(sample.series), sample.value);
+    }
+    return result;
+}
+
+void MetricsRegistry::write_prometheus(std::ostream& out) const {
+    const std::ios_base::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+    out << std::setprecision(17);
+
+    // 注册表按名称排序，同名序列连续输出，名称变化时写出说明与类型
+    const std::string* current = nullptr;
+    const auto samples = collect();
+    for (const auto& sample : samples) {
+        if (!current || *current != sample.name) {
+            out << "# HELP " << sample.name << ' ' << sample.entry->help << '\n';
+            out << "# TYPE " << sample.name << ' ' << type_name(sample.entry->type) << '\n';
+            current = &sample.name;
+        }
+        out << sample.series << ' ' << sample.value << '\n';
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+bool MetricsRegistry::write_prometheus(const std::filesystem::path& path) const {
+    std::filesystem::path temp = path;
+    temp += ".tmp";
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+        write_prometheus(file);
+        if (!file) {
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp, path, ec);
+    return !ec;
+}
+
+}  // namespace Corona
@@ -0,0 +1,175 @@
+#include <corona/profiler.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+namespace Corona {
+
+namespace {
+
+void write_json_string(std::ostream& out, std::string_view text) {
+    out << '"';
+    for (const char c : text) {
+        switch (c) {
+            case '"':
+                out << "\\\"";
+                break;
+            case '\\':
+                out << "\\\\";
+                break;
+            case '\n':
+                out << "\\n";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) >= 0x20) {
+                    out << c;
+                }
+                break;
+        }
+    }
+    out << '"';
+}
+
+}  // namespace
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler()
+    : epoch_(Clock::now()) {
+}
+
+void Profiler::start() {
+    {
+        std::lock_guard lock(mutex_);
+        for (const auto& buffer : buffers_) {
+            buffer->start.store(buffer->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+        }
+    }
+    active_.store(true, std::memory_order_relaxed);
+}
+
+void Profiler::stop() {
+    active_.store(false, std::memory_order_relaxed);
+}
+
+void Profiler::set_thread_name(std::string name) {
+    ThreadBuffer& buffer = local_buffer();
+    std::lock_guard lock(mutex_);
+    buffer.name = std::move(name);
+}
+
+void Profiler::record(std::string_view name, Clock::time_point begin, Clock::time_point end) {
+    ThreadBuffer& buffer = local_buffer();
+    const std::uint64_t index = buffer.head.load(std::memory_order_relaxed);
+
+    Slot& slot = buffer.events[index & (kThreadCapacity - 1)];
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name_data.store(name.data(), std::memory_order_relaxed);
+    slot.name_size.store(name.size(), std::memory_order_relaxed);
+    slot.begin_ns.store(std::chrono::duration_cast<std::chrono::nanoseconds>(begin - epoch_).count(),
+                        std::memory_order_relaxed);
+    slot.end_ns.store(std::chrono::duration_cast<std::chrono::nanoseconds>(end - epoch_).count(),
+                      std::memory_order_relaxed);
+    slot.sequence.store(index + 1, std::memory_order_release);
+
+    buffer.head.store(index + 1, std::memory_order_release);
+}
+
+Profiler::ThreadBuffer& Profiler::local_buffer() {
+    thread_local ThreadBuffer* local = nullptr;
+    if (local) {
+        return *local;
+    }
+
+    // 缓冲区由分析器持有，线程退出后其记录仍可导出
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->events = std::make_unique<Slot[]>(kThreadCapacity);
+
+    std::lock_guard lock(mutex_);
+    buffer->thread_id = static_cast<std::uint32_t>(buffers_.size() + 1);
+    local = buffer.get();
+    buffers_.push_back(std::move(buffer));
+    return *buffers_.back();
+}
+
+void Profiler::write_chrome_trace(std::ostream& out) const {
+    std::lock_guard lock(mutex_);
+
+    // 时间戳以微秒输出，保留到纳秒
+    const std::ios_base::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    const auto separator = [&out, &first] {
+        if (!first) {
+            out << ",\n";
+        }
+        first = false;
+    };
+
+    std::vector<Event> events;
+    for (const auto& buffer : buffers_) {
+        if (!buffer->name.empty()) {
+            separator();
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->thread_id
+                << ",\"args\":{\"name\":";
+            write_json_string(out, buffer->name);
+            out << "}}";
+        }
+
+        const std::uint64_t head = buffer->head.load(std::memory_order_acquire);
+        const std::uint64_t oldest = head > kThreadCapacity ? head - kThreadCapacity : 0;
+        const std::uint64_t begin = std::max(oldest, buffer->start.load(std::memory_order_relaxed));
+
+        // 复制期间所属线程可能继续写入，只采用复制前后序号一致且属于该位置的记录
+        events.clear();
+        for (std::uint64_t index = begin; index < head; ++index) {
+            const Slot& slot = buffer->events[index & (kThreadCapacity - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != index + 1) {
+                continue;
+            }
+            Event event;
+            const char* name_data = slot.name_data.load(std::memory_order_relaxed);
+            const std::size_t name_size = slot.name_size.load(std::memory_order_relaxed);
+            event.begin_ns = slot.begin_ns.load(std::memory_order_relaxed);
+            event.end_ns = slot.end_ns.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != index + 1) {
+                continue;
+            }
+            event.name = std::string_view(name_data, name_size);
+            events.push_back(event);
+        }
+
+        for (const Event& event : events) {
+            separator();
+            out << "{\"name\":";
+            write_json_string(out, event.name);
+            out << ",\"cat\":\"corona\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->thread_id
+                << ",\"ts\":" << static_cast<double>(event.begin_ns) / 1000.0
+                << ",\"dur\":" << static_cast<double>(event.end_ns - event.begin_ns) / 1000.0 << "}";
+        }
+    }
+
+    out << "]}\n";
+    out.flags(flags);
+    out.precision(precision);
+}
+
+bool Profiler::write_chrome_trace(const std::filesystem::path& path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    write_chrome_trace(file);
+    return static_cast<bool>(file);
+}
+
+}  // namespace Corona
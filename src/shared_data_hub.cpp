@@ -1,7 +1,70 @@
 #include <corona/shared_data_hub.h>
 
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <string>
+
 namespace Corona {
 
+namespace {
+
+// 按名称（与 corona_storage_objects 指标的 storage 标签一致）分派到对应的存储
+template <typename Visitor>
+bool visit_storage(SharedDataHub& hub, std::string_view name, Visitor&& visitor) {
+    if (name == "model_resource") {
+        visitor(hub.model_resource_storage());
+    } else if (name == "model_transform") {
+        visitor(hub.model_transform_storage());
+    } else if (name == "geometry") {
+        visitor(hub.geometry_storage());
+    } else if (name == "kinematics") {
+        visitor(hub.kinematics_storage());
+    } else if (name == "mechanics") {
+        visitor(hub.mechanics_storage());
+    } else if (name == "acoustics") {
+        visitor(hub.acoustics_storage());
+    } else if (name == "optics") {
+        visitor(hub.optics_storage());
+    } else if (name == "profile") {
+        visitor(hub.profile_storage());
+    } else if (name == "actor") {
+        visitor(hub.actor_storage());
+    } else if (name == "camera") {
+        visitor(hub.camera_storage());
+    } else if (name == "viewport") {
+        visitor(hub.viewport_storage());
+    } else if (name == "environment") {
+        visitor(hub.environment_storage());
+    } else if (name == "scene") {
+        visitor(hub.scene_storage());
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool parse_size(std::string_view text, std::size_t& out) {
+    const auto* end = text.data() + text.size();
+    const auto [ptr, ec] = std::from_chars(text.data(), end, out);
+    return ec == std::errc{} && ptr == end;
+}
+
+bool parse_growth(std::string_view text, StorageGrowth& out) {
+    if (text == "incremental") {
+        out = StorageGrowth::Incremental;
+    } else if (text == "geometric") {
+        out = StorageGrowth::Geometric;
+    } else if (text == "linear") {
+        out = StorageGrowth::Linear;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
 SharedDataHub& SharedDataHub::instance() {
     static SharedDataHub instance;
     return instance;
@@ -48,4 +111,234 @@ const SharedDataHub::EnvironmentStorage& SharedDataHub::environment_storage() co
 SharedDataHub::SceneStorage& SharedDataHub::scene_storage() { return scene_storage_; }
 const SharedDataHub::SceneStorage& SharedDataHub::scene_storage() const { return scene_storage_; }
 
+bool SharedDataHub::configure_storage(std::string_view name, const StorageConfig& config) {
+    if (!visit_storage(*this, name, [&config](auto& storage) { storage.configure(config); })) {
+        return false;
+    }
+    if (name == "model_transform") {
+        std::lock_guard lock(model_transform_publish_mutex_);
+        model_transform_cache_.reserve(config.capacity);
+    }
+    return true;
+}
+
+bool SharedDataHub::reserve_storage(std::string_view name, std::size_t count) {
+    if (!visit_storage(*this, name, [count](auto& storage) { storage.reserve(count); })) {
+        return false;
+    }
+    if (name == "model_transform") {
+        std::lock_guard lock(model_transform_publish_mutex_);
+        model_transform_cache_.reserve(count);
+    }
+    return true;
+}
+
+bool SharedDataHub::load_storage_config(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+
+    bool ok = true;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (const auto comment = line.find('#'); comment != std::string::npos) {
+            line.erase(comment);
+        }
+        std::istringstream fields(line);
+        std::string name;
+        if (!(fields >> name)) {
+            continue;
+        }
+
+        StorageConfig config;
+        if (!visit_storage(*this, name, [&config](const auto& storage) { config = storage.config(); })) {
+            ok = false;
+            continue;
+        }
+
+        bool line_ok = true;
+        std::string field;
+        while (fields >> field) {
+            const auto equals = field.find('=');
+            const std::string_view key = std::string_view(field).substr(0, equals);
+            const std::string_view value =
+                equals == std::string::npos ? std::string_view{} : std::string_view(field).substr(equals + 1);
+            if (key == "capacity") {
+                line_ok = line_ok && parse_size(value, config.capacity);
+            } else if (key == "growth") {
+                line_ok = line_ok && parse_growth(value, config.growth);
+            } else if (key == "step") {
+                line_ok = line_ok && parse_size(value, config.growth_step);
+            } else {
+                line_ok = false;
+            }
+        }
+        if (!line_ok) {
+            ok = false;
+            continue;
+        }
+        configure_storage(name, config);
+    }
+    return ok;
+}
+
+void SharedDataHub::publish_physics_interpolation(const PhysicsInterpolation& interpolation) {
+    std::lock_guard lock(physics_interpolation_mutex_);
+    physics_interpolation_ = interpolation;
+}
+
+PhysicsInterpolation SharedDataHub::physics_interpolation() const {
+    std::lock_guard lock(physics_interpolation_mutex_);
+    return physics_interpolation_;
+}
+
+std::shared_ptr<PhysicsPoseSnapshot> SharedDataHub::acquire_physics_poses() {
+    return physics_poses_.acquire_back();
+}
+
+void SharedDataHub::publish_physics_poses(std::shared_ptr<PhysicsPoseSnapshot> poses,
+                                          const PhysicsInterpolation& interpolation) {
+    std::lock_guard lock(physics_interpolation_mutex_);
+    physics_poses_.publish(std::move(poses));
+    physics_interpolation_ = interpolation;
+}
+
+void SharedDataHub::publish_spatial_index(std::shared_ptr<const Systems::SpatialIndex> index) {
+    std::lock_guard lock(spatial_index_mutex_);
+    spatial_index_ = std::move(index);
+}
+
+std::shared_ptr<const Systems::SpatialIndex> SharedDataHub::spatial_index() const {
+    std::lock_guard lock(spatial_index_mutex_);
+    return spatial_index_;
+}
+
+void SharedDataHub::publish_system_rates(std::vector<SystemRate> rates) {
+    std::lock_guard lock(system_rates_mutex_);
+    system_rates_ = std::move(rates);
+}
+
+std::vector<SystemRate> SharedDataHub::system_rates() const {
+    std::lock_guard lock(system_rates_mutex_);
+    return system_rates_;
+}
+
+void TransformSnapshot::rebuild_index() {
+    // 装载率不超过 1/2，线性探测的平均探测长度保持在常数级
+    std::size_t capacity = 16;
+    while (capacity < handles.size() * 2) {
+        capacity *= 2;
+    }
+    slots.assign(capacity, 0);
+
+    const std::size_t mask = capacity - 1;
+    for (std::size_t i = 0; i < handles.size(); ++i) {
+        std::size_t slot = slot_of(handles[i]) & mask;
+        while (slots[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = static_cast<std::uint32_t>(i + 1);
+    }
+}
+
+void SharedDataHub::publish_model_transforms(std::uint64_t frame) {
+    std::lock_guard lock(model_transform_publish_mutex_);
+    auto back = model_transform_snapshots_.acquire_back();
+    back->frame = frame;
+
+    // 插值状态与刚体位姿成对读取，二者属于同一步
+    std::shared_ptr<const PhysicsPoseSnapshot> poses;
+    {
+        std::lock_guard lock(physics_interpolation_mutex_);
+        back->interpolation = physics_interpolation_;
+        poses = physics_poses_.snapshot();
+    }
+
+    // 复用后台缓冲区的容量；复制期间被释放的句柄直接剔除
+    model_transform_storage_.snapshot_handles(back->handles);
+    back->transforms.resize(back->handles.size());
+
+    std::size_t count = 0;
+    for (const auto handle : back->handles) {
+        if (auto transform = model_transform_storage_.acquire_read(handle)) {
+            back->handles[count] = handle;
+            back->transforms[count] = *transform;
+            ++count;
+        }
+    }
+    back->handles.resize(count);
+    back->transforms.resize(count);
+    back->rebuild_index();
+
+    // 力学线程可能正在写回下一步：刚体改用与插值状态同一步的位姿
+    if (poses && poses->step == back->interpolation.step) {
+        for (const auto& pose : poses->poses) {
+            const std::size_t index = back->index_of(pose.transform_handle);
+            if (index == TransformSnapshot::kNotFound) {
+                continue;
+            }
+            auto& transform = back->transforms[index];
+            transform.position = pose.position;
+            transform.euler_rotation = pose.euler_rotation;
+            transform.previous_position = pose.previous_position;
+            transform.previous_euler_rotation = pose.previous_euler_rotation;
+            transform.physics_step = poses->step;
+        }
+    }
+
+    // 缓存按紧凑顺序对齐：下标处的位姿未变（包括句柄被 swap-remove 换位但数值相同）时复用矩阵
+    const std::size_t cached = model_transform_cache_.size();
+    model_transform_cache_.resize(count);
+    model_transform_changed_.clear();
+    bool has_parents = false;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& transform = back->transforms[i];
+        if (model_transform_cache_.set(i, transform.position, transform.euler_rotation, transform.scale) || i >= cached) {
+            model_transform_changed_.push_back(static_cast<std::uint32_t>(i));
+        }
+        has_parents = has_parents || transform.parent_handle != 0;
+    }
+    model_transform_cache_.update_world_matrices();
+
+    if (!has_parents) {
+        // 全部为根节点时局部矩阵即世界矩阵
+        model_transform_hierarchy_.resize(0);
+        back->world_matrices.assign(model_transform_cache_.world_matrices().begin(),
+                                    model_transform_cache_.world_matrices().end());
+    } else {
+        // 层级刚建立或节点数变化时重新写入全部局部矩阵，否则只写入变化过的
+        const bool rebuilt = model_transform_hierarchy_.size() != count;
+        model_transform_hierarchy_.resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            // 父句柄失效（父变换已释放）时按根节点处理
+            const std::uintptr_t parent_handle = back->transforms[i].parent_handle;
+            const std::size_t parent = parent_handle != 0 ? back->index_of(parent_handle) : TransformSnapshot::kNotFound;
+            model_transform_hierarchy_.set_parent(
+                i, parent == TransformSnapshot::kNotFound ? TransformHierarchy::kNoParent : static_cast<std::uint32_t>(parent));
+        }
+        if (rebuilt) {
+            for (std::size_t i = 0; i < count; ++i) {
+                model_transform_hierarchy_.set_local(i, model_transform_cache_.world_matrix(i));
+            }
+        } else {
+            for (const auto i : model_transform_changed_) {
+                model_transform_hierarchy_.set_local(i, model_transform_cache_.world_matrix(i));
+            }
+        }
+        model_transform_hierarchy_.update();
+
+        back->world_matrices.resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            back->world_matrices[i] = model_transform_hierarchy_.world(i);
+        }
+    }
+
+    model_transform_snapshots_.publish(std::move(back));
+}
+
+std::shared_ptr<const TransformSnapshot> SharedDataHub::model_transform_snapshot() const {
+    return model_transform_snapshots_.snapshot();
+}
+
 }  // namespace Corona
\ No newline at end of file
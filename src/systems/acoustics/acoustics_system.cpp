@@ -13,6 +13,10 @@ bool AcousticsSystem::initialize(Kernel::ISystemContext* ctx) {
 }
 
 void AcousticsSystem::update() {
+    advance(delta_time());
+}
+
+void AcousticsSystem::advance(float elapsed) {
 }
 
 void AcousticsSystem::shutdown() {
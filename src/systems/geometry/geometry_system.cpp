@@ -13,6 +13,10 @@ bool GeometrySystem::initialize(Kernel::ISystemContext* ctx) {
 }
 
 void GeometrySystem::update() {
+    advance(delta_time());
+}
+
+void GeometrySystem::advance(float elapsed) {
 }
 
 void GeometrySystem::shutdown() {
@@ -14,6 +14,10 @@ bool KinematicsSystem::initialize(Kernel::ISystemContext* ctx) {
 }
 
 void KinematicsSystem::update() {
+    advance(delta_time());
+}
+
+void KinematicsSystem::advance(float elapsed) {
 }
 
 void KinematicsSystem::shutdown() {
@@ -0,0 +1,239 @@
+#include "aabb_kernels.h"
+
+#include <atomic>
+#include <bit>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+// AVX2 内核不依赖 -mavx2 或 /arch:AVX2：GCC/Clang 通过 target 属性只为该函数生成 AVX2 指令，
+// MSVC 的内建函数不受 /arch 限制；是否调用由运行时检测决定
+#define CORONA_AABB_AVX2 1
+#if defined(__GNUC__) || defined(__clang__)
+#define CORONA_AABB_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CORONA_AABB_TARGET_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CORONA_AABB_SSE2 1
+#endif
+#endif
+
+namespace Corona::Systems {
+
+namespace {
+
+// 将比较掩码中置位的通道展开为下标
+inline std::size_t emit_lanes(unsigned mask, std::size_t base, std::uint32_t* out) {
+    std::size_t written = 0;
+    while (mask != 0) {
+        const int lane = std::countr_zero(mask);
+        out[written++] = static_cast<std::uint32_t>(base + static_cast<std::size_t>(lane));
+        mask &= mask - 1;
+    }
+    return written;
+}
+
+#if defined(CORONA_AABB_AVX2)
+// CPU 支持 AVX2，且操作系统在上下文切换时保存 YMM 寄存器
+bool cpu_supports_avx2() {
+#if defined(_MSC_VER)
+    int info[4] = {};
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+CORONA_AABB_TARGET_AVX2 std::size_t overlap_range_avx2(const AabbQuery& query, const AabbSoA& bounds,
+                                                       std::size_t begin, std::size_t end, std::uint32_t* out) {
+    std::size_t i = begin;
+    std::size_t written = 0;
+
+    const float* min_x = bounds.min_x.data();
+    const float* min_y = bounds.min_y.data();
+    const float* min_z = bounds.min_z.data();
+    const float* max_x = bounds.max_x.data();
+    const float* max_y = bounds.max_y.data();
+    const float* max_z = bounds.max_z.data();
+
+    const __m256 q_min_x = _mm256_set1_ps(query.min_x);
+    const __m256 q_min_y = _mm256_set1_ps(query.min_y);
+    const __m256 q_min_z = _mm256_set1_ps(query.min_z);
+    const __m256 q_max_x = _mm256_set1_ps(query.max_x);
+    const __m256 q_max_y = _mm256_set1_ps(query.max_y);
+    const __m256 q_max_z = _mm256_set1_ps(query.max_z);
+
+    for (; i + 8 <= end; i += 8) {
+        // b.min <= q.max && q.min <= b.max，三轴同时成立
+        __m256 mask = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(min_x + i), q_max_x, _CMP_LE_OQ),
+                                    _mm256_cmp_ps(q_min_x, _mm256_loadu_ps(max_x + i), _CMP_LE_OQ));
+        mask = _mm256_and_ps(mask, _mm256_cmp_ps(_mm256_loadu_ps(min_y + i), q_max_y, _CMP_LE_OQ));
+        mask = _mm256_and_ps(mask, _mm256_cmp_ps(q_min_y, _mm256_loadu_ps(max_y + i), _CMP_LE_OQ));
+        mask = _mm256_and_ps(mask, _mm256_cmp_ps(_mm256_loadu_ps(min_z + i), q_max_z, _CMP_LE_OQ));
+        mask = _mm256_and_ps(mask, _mm256_cmp_ps(q_min_z, _mm256_loadu_ps(max_z + i), _CMP_LE_OQ));
+
+        written += emit_lanes(static_cast<unsigned>(_mm256_movemask_ps(mask)), i, out + written);
+    }
+
+    // 剩余不足一个向量宽度的部分使用标量实现
+    written += aabb_overlap_range_scalar(query, bounds, i, end, out + written);
+    return written;
+}
+#endif
+
+#if defined(CORONA_AABB_SSE2)
+std::size_t overlap_range_sse2(const AabbQuery& query, const AabbSoA& bounds,
+                               std::size_t begin, std::size_t end, std::uint32_t* out) {
+    std::size_t i = begin;
+    std::size_t written = 0;
+
+    const float* min_x = bounds.min_x.data();
+    const float* min_y = bounds.min_y.data();
+    const float* min_z = bounds.min_z.data();
+    const float* max_x = bounds.max_x.data();
+    const float* max_y = bounds.max_y.data();
+    const float* max_z = bounds.max_z.data();
+
+    const __m128 q_min_x = _mm_set1_ps(query.min_x);
+    const __m128 q_min_y = _mm_set1_ps(query.min_y);
+    const __m128 q_min_z = _mm_set1_ps(query.min_z);
+    const __m128 q_max_x = _mm_set1_ps(query.max_x);
+    const __m128 q_max_y = _mm_set1_ps(query.max_y);
+    const __m128 q_max_z = _mm_set1_ps(query.max_z);
+
+    for (; i + 4 <= end; i += 4) {
+        // b.min <= q.max && q.min <= b.max，三轴同时成立
+        __m128 mask = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(min_x + i), q_max_x),
+                                 _mm_cmple_ps(q_min_x, _mm_loadu_ps(max_x + i)));
+        mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_loadu_ps(min_y + i), q_max_y));
+        mask = _mm_and_ps(mask, _mm_cmple_ps(q_min_y, _mm_loadu_ps(max_y + i)));
+        mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_loadu_ps(min_z + i), q_max_z));
+        mask = _mm_and_ps(mask, _mm_cmple_ps(q_min_z, _mm_loadu_ps(max_z + i)));
+
+        written += emit_lanes(static_cast<unsigned>(_mm_movemask_ps(mask)), i, out + written);
+    }
+
+    // 剩余不足一个向量宽度的部分使用标量实现
+    written += aabb_overlap_range_scalar(query, bounds, i, end, out + written);
+    return written;
+}
+#endif
+
+// 支持的最宽实现
+AabbKernel best_supported_kernel() {
+    if (aabb_kernel_supported(AabbKernel::Avx2)) {
+        return AabbKernel::Avx2;
+    }
+    if (aabb_kernel_supported(AabbKernel::Sse2)) {
+        return AabbKernel::Sse2;
+    }
+    return AabbKernel::Scalar;
+}
+
+// 首次使用时检测一次 CPU；set_aabb_overlap_kernel 可随后覆盖
+std::atomic<AabbKernel>& active_kernel() {
+    static std::atomic<AabbKernel> kernel{best_supported_kernel()};
+    return kernel;
+}
+
+}  // namespace
+
+const char* aabb_kernel_name(AabbKernel kernel) {
+    switch (kernel) {
+        case AabbKernel::Avx2:
+            return "avx2";
+        case AabbKernel::Sse2:
+            return "sse2";
+        case AabbKernel::Scalar:
+            break;
+    }
+    return "scalar";
+}
+
+bool aabb_kernel_supported(AabbKernel kernel) {
+    switch (kernel) {
+        case AabbKernel::Avx2:
+#if defined(CORONA_AABB_AVX2)
+            return cpu_supports_avx2();
+#else
+            return false;
+#endif
+        case AabbKernel::Sse2:
+#if defined(CORONA_AABB_SSE2)
+            return true;
+#else
+            return false;
+#endif
+        case AabbKernel::Scalar:
+            break;
+    }
+    return true;
+}
+
+AabbKernel aabb_overlap_kernel() {
+    return active_kernel().load(std::memory_order_relaxed);
+}
+
+bool set_aabb_overlap_kernel(AabbKernel kernel) {
+    if (!aabb_kernel_supported(kernel)) {
+        return false;
+    }
+    active_kernel().store(kernel, std::memory_order_relaxed);
+    return true;
+}
+
+std::size_t aabb_overlap_lane_width() {
+    switch (aabb_overlap_kernel()) {
+        case AabbKernel::Avx2:
+            return 8;
+        case AabbKernel::Sse2:
+            return 4;
+        case AabbKernel::Scalar:
+            break;
+    }
+    return 1;
+}
+
+std::size_t aabb_overlap_range_scalar(const AabbQuery& query, const AabbSoA& bounds,
+                                      std::size_t begin, std::size_t end, std::uint32_t* out) {
+    std::size_t written = 0;
+    for (std::size_t i = begin; i < end; ++i) {
+        if (aabb_overlap(query, aabb_at(bounds, i))) {
+            out[written++] = static_cast<std::uint32_t>(i);
+        }
+    }
+    return written;
+}
+
+std::size_t aabb_overlap_range(const AabbQuery& query, const AabbSoA& bounds,
+                               std::size_t begin, std::size_t end, std::uint32_t* out) {
+    switch (aabb_overlap_kernel()) {
+#if defined(CORONA_AABB_AVX2)
+        case AabbKernel::Avx2:
+            return overlap_range_avx2(query, bounds, begin, end, out);
+#endif
+#if defined(CORONA_AABB_SSE2)
+        case AabbKernel::Sse2:
+            return overlap_range_sse2(query, bounds, begin, end, out);
+#endif
+        default:
+            break;
+    }
+    return aabb_overlap_range_scalar(query, bounds, begin, end, out);
+}
+
+}  // namespace Corona::Systems
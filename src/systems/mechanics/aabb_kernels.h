@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "aabb_soa.h"
+
+namespace Corona::Systems {
+
+/**
+ * @brief 单个包围盒（查询盒）
+ */
+struct AabbQuery {
+    float min_x, min_y, min_z;
+    float max_x, max_y, max_z;
+};
+
+/**
+ * @brief 从 SoA 缓存中取出第 index 个包围盒
+ */
+[[nodiscard]] inline AabbQuery aabb_at(const AabbSoA& bounds, std::size_t index) {
+    return {bounds.min_x[index], bounds.min_y[index], bounds.min_z[index],
+            bounds.max_x[index], bounds.max_y[index], bounds.max_z[index]};
+}
+
+/**
+ * @brief 标量参考实现：两个包围盒是否重叠（边界接触视为重叠）
+ */
+[[nodiscard]] inline bool aabb_overlap(const AabbQuery& lhs, const AabbQuery& rhs) {
+    return lhs.min_x <= rhs.max_x && rhs.min_x <= lhs.max_x &&
+           lhs.min_y <= rhs.max_y && rhs.min_y <= lhs.max_y &&
+           lhs.min_z <= rhs.max_z && rhs.min_z <= lhs.max_z;
+}
+
+/**
+ * @brief aabb_overlap_range 的实现
+ */
+enum class AabbKernel : std::uint8_t {
+    Scalar,
+    Sse2,
+    Avx2,
+};
+
+/**
+ * @brief 实现名称（"scalar" / "sse2" / "avx2"）
+ */
+[[nodiscard]] const char* aabb_kernel_name(AabbKernel kernel);
+
+/**
+ * @brief 当前编译目标与 CPU 是否支持该实现
+ *
+ * SSE2 由编译目标决定；AVX2 不依赖编译选项，在运行时检测 CPU 与操作系统是否支持。
+ */
+[[nodiscard]] bool aabb_kernel_supported(AabbKernel kernel);
+
+/**
+ * @brief 当前使用的实现，默认取支持的最宽实现
+ */
+[[nodiscard]] AabbKernel aabb_overlap_kernel();
+
+/**
+ * @brief 强制使用指定实现（用于检查与基准测试）
+ *
+ * @return 不支持该实现时返回 false，当前实现保持不变
+ */
+bool set_aabb_overlap_kernel(AabbKernel kernel);
+
+/**
+ * @brief 当前实现的向量宽度（AVX2 = 8，SSE2 = 4，标量 = 1）
+ */
+[[nodiscard]] std::size_t aabb_overlap_lane_width();
+
+/**
+ * @brief 测试查询盒与 bounds 中连续区间 [begin, end) 的重叠
+ *
+ * 按 aabb_overlap_kernel() 分派：AVX2 / SSE2 一次比较 8 / 4 个包围盒，其余情况退回标量实现。
+ *
+ * @param query 查询盒
+ * @param bounds SoA 包围盒缓存
+ * @param begin 区间起始下标
+ * @param end 区间结束下标（不含）
+ * @param out 输出重叠盒的下标，容量至少为 end - begin，按升序写入
+ * @return 重叠盒数量
+ */
+std::size_t aabb_overlap_range(const AabbQuery& query, const AabbSoA& bounds,
+                               std::size_t begin, std::size_t end, std::uint32_t* out);
+
+/**
+ * @brief aabb_overlap_range 的标量版本，作为向量实现的参考
+ */
+std::size_t aabb_overlap_range_scalar(const AabbQuery& query, const AabbSoA& bounds,
+                                      std::size_t begin, std::size_t end, std::uint32_t* out);
+
+}  // namespace Corona::Systems
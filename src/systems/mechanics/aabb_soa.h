@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace Corona::Systems {
+
+/**
+ * @brief 结构数组（SoA）布局的世界空间包围盒缓存
+ *
+ * 每帧由力学系统为每个物体计算一次，之后宽阶段与碰撞检测只读取这里的数据。
+ * 各分量连续存放，便于顺序扫描和向量化；容器在帧间复用，稳定后不再分配内存。
+ */
+struct AabbSoA {
+    std::vector<float> min_x;
+    std::vector<float> min_y;
+    std::vector<float> min_z;
+    std::vector<float> max_x;
+    std::vector<float> max_y;
+    std::vector<float> max_z;
+
+    [[nodiscard]] std::size_t size() const {
+        return min_x.size();
+    }
+
+    [[nodiscard]] bool empty() const {
+        return min_x.empty();
+    }
+
+    void clear() {
+        min_x.clear();
+        min_y.clear();
+        min_z.clear();
+        max_x.clear();
+        max_y.clear();
+        max_z.clear();
+    }
+
+    void reserve(std::size_t count) {
+        min_x.reserve(count);
+        min_y.reserve(count);
+        min_z.reserve(count);
+        max_x.reserve(count);
+        max_y.reserve(count);
+        max_z.reserve(count);
+    }
+
+    void resize(std::size_t count) {
+        min_x.resize(count);
+        min_y.resize(count);
+        min_z.resize(count);
+        max_x.resize(count);
+        max_y.resize(count);
+        max_z.resize(count);
+    }
+
+    void set(std::size_t index, float mnx, float mny, float mnz, float mxx, float mxy, float mxz) {
+        min_x[index] = mnx;
+        min_y[index] = mny;
+        min_z[index] = mnz;
+        max_x[index] = mxx;
+        max_y[index] = mxy;
+        max_z[index] = mxz;
+    }
+
+    void push_back(float mnx, float mny, float mnz, float mxx, float mxy, float mxz) {
+        min_x.push_back(mnx);
+        min_y.push_back(mny);
+        min_z.push_back(mnz);
+        max_x.push_back(mxx);
+        max_y.push_back(mxy);
+        max_z.push_back(mxz);
+    }
+
+    /**
+     * @brief 按轴取最小值数组 (0 = x, 1 = y, 2 = z)
+     */
+    [[nodiscard]] const float* min_axis(int axis) const {
+        return axis == 0 ? min_x.data() : (axis == 1 ? min_y.data() : min_z.data());
+    }
+
+    /**
+     * @brief 按轴取最大值数组 (0 = x, 1 = y, 2 = z)
+     */
+    [[nodiscard]] const float* max_axis(int axis) const {
+        return axis == 0 ? max_x.data() : (axis == 1 ? max_y.data() : max_z.data());
+    }
+};
+
+}  // namespace Corona::Systems
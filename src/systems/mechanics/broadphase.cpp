@@ -0,0 +1,375 @@
+#include "broadphase.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+namespace Corona::Systems {
+
+namespace {
+
+// 插入排序的移动预算（相对物体数量），超出则认为场景变化剧烈，改为完整排序
+constexpr std::size_t kMaxInsertionMovesPerBody = 8;
+
+// 并行扫描时每个任务区间包含的条目数量
+constexpr std::size_t kParallelSweepGrain = 512;
+
+// 单元内扫描时一次测试的候选数量，与最宽的向量实现一致
+constexpr std::size_t kSweepWindow = 8;
+
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+// 单元数量上限（相对物体数量），避免少数巨大物体或稀疏场景产生过多空单元
+constexpr std::size_t kMaxCellsPerBody = 4;
+
+// 浮点数按数值大小映射为可直接比较的无符号整数，-0.0 与 0.0 映射为同一值
+std::uint64_t sortable_bits(float value) {
+    const auto bits = std::bit_cast<std::uint32_t>(value + 0.0f);
+    return (bits & 0x80000000u) != 0 ? ~bits : (bits | 0x80000000u);
+}
+
+// 按字节的 LSD 基数排序，跳过所有关键字都相同的字节；scratch 为同样大小的临时缓冲
+void radix_sort(std::vector<std::uint64_t>& keys, std::vector<std::uint64_t>& scratch) {
+    std::uint64_t any = 0;
+    std::uint64_t all = ~std::uint64_t{0};
+    for (const std::uint64_t key : keys) {
+        any |= key;
+        all &= key;
+    }
+
+    scratch.resize(keys.size());
+    const std::uint64_t varying = any ^ all;
+    for (int shift = 0; shift < 64; shift += 8) {
+        if (((varying >> shift) & 0xff) == 0) {
+            continue;
+        }
+
+        std::size_t offsets[256] = {};
+        for (const std::uint64_t key : keys) {
+            ++offsets[(key >> shift) & 0xff];
+        }
+        std::size_t sum = 0;
+        for (std::size_t& offset : offsets) {
+            sum += std::exchange(offset, sum);
+        }
+        for (const std::uint64_t key : keys) {
+            scratch[offsets[(key >> shift) & 0xff]++] = key;
+        }
+        keys.swap(scratch);
+    }
+}
+
+// 按轴取 AabbQuery 的最小值、最大值成员 (0 = x, 1 = y, 2 = z)
+constexpr float AabbQuery::*min_member(int axis) {
+    return axis == 0 ? &AabbQuery::min_x : (axis == 1 ? &AabbQuery::min_y : &AabbQuery::min_z);
+}
+
+constexpr float AabbQuery::*max_member(int axis) {
+    return axis == 0 ? &AabbQuery::max_x : (axis == 1 ? &AabbQuery::max_y : &AabbQuery::max_z);
+}
+
+// 坐标所在的单元，超出网格或为 NaN 时截断到边缘单元
+std::int32_t cell_of(float value, float origin, float inv_cell, std::int32_t cells) {
+    const float cell = (value - origin) * inv_cell;
+    if (!(cell > 0.0f)) {
+        return 0;
+    }
+    return cell < static_cast<float>(cells) ? std::min(static_cast<std::int32_t>(cell), cells - 1) : cells - 1;
+}
+
+}  // namespace
+
+void SweepAndPrune::reset() {
+    order_.clear();
+    sort_keys_.clear();
+    axis_changed_ = true;
+    stats_ = {};
+}
+
+void SweepAndPrune::select_axis(const AabbSoA& bounds) {
+    // 选择包围盒中心方差最大的轴，使扫描区间尽量稀疏
+    const std::size_t count = bounds.size();
+    const double n = static_cast<double>(count);
+    int best_axis = axis_;
+    double best_variance = -1.0;
+
+    for (int axis = 0; axis < 3; ++axis) {
+        const float* mins = bounds.min_axis(axis);
+        const float* maxs = bounds.max_axis(axis);
+        double sum = 0.0;
+        double sum_sq = 0.0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const double c = 0.5 * (static_cast<double>(mins[i]) + maxs[i]);
+            sum += c;
+            sum_sq += c * c;
+        }
+
+        const double variance = sum_sq / n - (sum / n) * (sum / n);
+        // 仅在明显更优时切换轴，避免相近方差导致每帧重排
+        const double bias = (axis == axis_) ? 1.25 : 1.0;
+        if (variance * bias > best_variance) {
+            best_variance = variance * bias;
+            best_axis = axis;
+        }
+    }
+
+    axis_changed_ = axis_changed_ || (best_axis != axis_);
+    axis_ = best_axis;
+}
+
+void SweepAndPrune::sort_order(const AabbSoA& bounds) {
+    const auto count = static_cast<std::uint32_t>(bounds.size());
+    const float* mins = bounds.min_axis(axis_);
+
+    stats_.sort_moves = 0;
+    stats_.full_resort = false;
+
+    // 关键字与下标打包为一个整数，以下标作为次关键字，保证相同输入得到相同顺序；
+    // 排序直接在连续的关键字数组上进行，比较时不必再按下标读取包围盒
+    if (axis_changed_ || order_.size() != count) {
+        sort_keys_.resize(count);
+        for (std::uint32_t i = 0; i < count; ++i) {
+            sort_keys_[i] = (sortable_bits(mins[i]) << 32) | i;
+        }
+        radix_sort(sort_keys_, radix_scratch_);
+        stats_.full_resort = true;
+        axis_changed_ = false;
+    } else {
+        // 按上一帧的顺序刷新关键字后增量插入排序：物体运动连贯时几乎无需移动
+        for (std::uint32_t i = 0; i < count; ++i) {
+            sort_keys_[i] = (sortable_bits(mins[order_[i]]) << 32) | order_[i];
+        }
+
+        const std::size_t move_budget = static_cast<std::size_t>(count) * kMaxInsertionMovesPerBody;
+        for (std::uint32_t i = 1; i < count; ++i) {
+            const std::uint64_t value = sort_keys_[i];
+            std::uint32_t j = i;
+            while (j > 0 && value < sort_keys_[j - 1]) {
+                sort_keys_[j] = sort_keys_[j - 1];
+                --j;
+            }
+            sort_keys_[j] = value;
+            stats_.sort_moves += i - j;
+
+            if (stats_.sort_moves > move_budget) {
+                radix_sort(sort_keys_, radix_scratch_);
+                stats_.full_resort = true;
+                break;
+            }
+        }
+    }
+
+    order_.resize(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        order_[i] = static_cast<std::uint32_t>(sort_keys_[i]);
+    }
+}
+
+void SweepAndPrune::build_cells() {
+    // 网格划分排序轴以外的两轴
+    const int axis_u = (axis_ + 1) % 3;
+    const int axis_v = (axis_ + 2) % 3;
+    const float AabbQuery::*min_u = min_member(axis_u);
+    const float AabbQuery::*min_v = min_member(axis_v);
+    const float AabbQuery::*max_u = max_member(axis_u);
+    const float AabbQuery::*max_v = max_member(axis_v);
+
+    const std::size_t count = sorted_.size();
+    float lo_u = sorted_[0].bounds.*min_u;
+    float lo_v = sorted_[0].bounds.*min_v;
+    float hi_u = sorted_[0].bounds.*max_u;
+    float hi_v = sorted_[0].bounds.*max_v;
+    double extent_sum = 0.0;
+    for (const SortedBody& body : sorted_) {
+        const AabbQuery& box = body.bounds;
+        lo_u = std::min(lo_u, box.*min_u);
+        lo_v = std::min(lo_v, box.*min_v);
+        hi_u = std::max(hi_u, box.*max_u);
+        hi_v = std::max(hi_v, box.*max_v);
+        extent_sum += 0.5 * ((static_cast<double>(box.*max_u) - box.*min_u) + (static_cast<double>(box.*max_v) - box.*min_v));
+    }
+
+    const double range_u = static_cast<double>(hi_u) - lo_u;
+    const double range_v = static_cast<double>(hi_v) - lo_v;
+    double cell = cell_size_ > 0.0f ? cell_size_ : kAutoCellScale * extent_sum / static_cast<double>(count);
+
+    // 单元过小时放大，使单元数量不超过上限；范围无效（无穷大或 NaN）时退化为单个单元
+    const double max_cells = static_cast<double>(count * kMaxCellsPerBody);
+    if (!std::isfinite(range_u) || !std::isfinite(range_v) || !std::isfinite(cell)) {
+        cell = 0.0;
+    } else {
+        cell = std::max({cell, std::sqrt(range_u * range_v / max_cells), range_u / max_cells, range_v / max_cells});
+    }
+
+    cells_u_ = 1;
+    cells_v_ = 1;
+    if (cell > 0.0) {
+        cells_u_ = static_cast<std::int32_t>(std::clamp(std::ceil(range_u / cell), 1.0, max_cells));
+        cells_v_ = static_cast<std::int32_t>(
+            std::clamp(std::ceil(range_v / cell), 1.0, std::max(1.0, std::floor(max_cells / cells_u_))));
+    }
+    const std::size_t cell_count = static_cast<std::size_t>(cells_u_) * static_cast<std::size_t>(cells_v_);
+    const auto inv_cell = cell > 0.0 ? static_cast<float>(1.0 / cell) : 0.0f;
+    stats_.cell_count = cell_count;
+    stats_.cell_size = static_cast<float>(cell);
+
+    // 统计每个单元的物体数量
+    cell_hi_u_.resize(count);
+    cell_hi_v_.resize(count);
+    cell_start_.assign(cell_count + 1, 0);
+    for (std::size_t pos = 0; pos < count; ++pos) {
+        SortedBody& body = sorted_[pos];
+        body.lo_u = cell_of(body.bounds.*min_u, lo_u, inv_cell, cells_u_);
+        body.lo_v = cell_of(body.bounds.*min_v, lo_v, inv_cell, cells_v_);
+        cell_hi_u_[pos] = cell_of(body.bounds.*max_u, lo_u, inv_cell, cells_u_);
+        cell_hi_v_[pos] = cell_of(body.bounds.*max_v, lo_v, inv_cell, cells_v_);
+        for (std::int32_t v = body.lo_v; v <= cell_hi_v_[pos]; ++v) {
+            for (std::int32_t u = body.lo_u; u <= cell_hi_u_[pos]; ++u) {
+                ++cell_start_[static_cast<std::size_t>(v) * cells_u_ + u + 1];
+            }
+        }
+    }
+    std::partial_sum(cell_start_.begin(), cell_start_.end(), cell_start_.begin());
+
+    // 按排序位置顺序填充，每个单元内的物体保持排序轴上的顺序
+    stats_.entry_count = cell_start_.back();
+    cell_fill_.assign(cell_start_.begin(), cell_start_.end() - 1);
+    cell_entries_.resize(cell_start_.back());
+    for (std::size_t pos = 0; pos < count; ++pos) {
+        for (std::int32_t v = sorted_[pos].lo_v; v <= cell_hi_v_[pos]; ++v) {
+            for (std::int32_t u = sorted_[pos].lo_u; u <= cell_hi_u_[pos]; ++u) {
+                cell_entries_[cell_fill_[static_cast<std::size_t>(v) * cells_u_ + u]++] =
+                    static_cast<std::uint32_t>(pos);
+            }
+        }
+    }
+}
+
+std::size_t SweepAndPrune::sweep_cells(std::size_t begin, std::size_t end, CellScratch& scratch,
+                                       std::vector<BroadphasePair>& out) const {
+    std::size_t tests = 0;
+    for (std::size_t cell = begin; cell < end; ++cell) {
+        const std::size_t first = cell_start_[cell];
+        const std::size_t size = cell_start_[cell + 1] - first;
+        if (size < 2) {
+            continue;
+        }
+
+        // 把单元内的物体复制到连续的缓冲区，末尾补 kSweepWindow 个不与任何包围盒重叠的哨兵
+        scratch.bounds.resize(size + kSweepWindow);
+        scratch.pos.resize(size);
+        scratch.lo_u.resize(size);
+        scratch.lo_v.resize(size);
+        scratch.hits.resize(size + kSweepWindow);
+        for (std::size_t k = 0; k < size; ++k) {
+            const std::uint32_t pos = cell_entries_[first + k];
+            const SortedBody& body = sorted_[pos];
+            const AabbQuery& box = body.bounds;
+            scratch.bounds.set(k, box.min_x, box.min_y, box.min_z, box.max_x, box.max_y, box.max_z);
+            scratch.pos[k] = pos;
+            scratch.lo_u[k] = body.lo_u;
+            scratch.lo_v[k] = body.lo_v;
+        }
+        for (std::size_t k = size; k < size + kSweepWindow; ++k) {
+            scratch.bounds.set(k, kInfinity, kInfinity, kInfinity, -kInfinity, -kInfinity, -kInfinity);
+        }
+
+        const float* sweep_min = scratch.bounds.min_axis(axis_);
+        const float* sweep_max = scratch.bounds.max_axis(axis_);
+        for (std::size_t i = 0; i + 1 < size; ++i) {
+            // 扫描轴上最小值不超过当前最大值的物体构成连续候选区间。单元内的区间通常很短，
+            // 按固定宽度的窗口整体测试（重叠测试本身包含扫描轴），窗口末尾仍在区间内时才继续下一个窗口
+            const AabbQuery query = aabb_at(scratch.bounds, i);
+            std::size_t hit_count = 0;
+            for (std::size_t window = i + 1;; window += kSweepWindow) {
+                hit_count += aabb_overlap_range(query, scratch.bounds, window, window + kSweepWindow,
+                                                scratch.hits.data() + hit_count);
+                tests += kSweepWindow;
+                if (sweep_min[window + kSweepWindow - 1] > sweep_max[i]) {
+                    break;
+                }
+            }
+
+            for (std::size_t h = 0; h < hit_count; ++h) {
+                // 只在包围盒交集的最小角所在的单元输出，跨单元的候选对不会重复
+                const std::uint32_t j = scratch.hits[h];
+                const std::int32_t ref_u = std::max(scratch.lo_u[i], scratch.lo_u[j]);
+                const std::int32_t ref_v = std::max(scratch.lo_v[i], scratch.lo_v[j]);
+                if (static_cast<std::size_t>(ref_v) * cells_u_ + ref_u != cell) {
+                    continue;
+                }
+                const std::uint32_t a = order_[scratch.pos[i]];
+                const std::uint32_t b = order_[scratch.pos[j]];
+                out.push_back(a < b ? BroadphasePair{a, b} : BroadphasePair{b, a});
+            }
+        }
+    }
+    return tests;
+}
+
+void SweepAndPrune::update(const AabbSoA& bounds, std::vector<BroadphasePair>& pairs, WorkStealingPool* pool) {
+    pairs.clear();
+    stats_.body_count = bounds.size();
+    stats_.pair_tests = 0;
+    stats_.pair_count = 0;
+    stats_.cell_count = 0;
+    stats_.entry_count = 0;
+
+    if (bounds.size() < 2) {
+        order_.clear();
+        return;
+    }
+
+    select_axis(bounds);
+    sort_order(bounds);
+
+    // 按排序结果重排一份副本，之后各阶段按排序位置读取
+    const std::size_t count = order_.size();
+    sorted_.resize(count);
+    for (std::size_t pos = 0; pos < count; ++pos) {
+        sorted_[pos].bounds = aabb_at(bounds, order_[pos]);
+    }
+
+    build_cells();
+
+    const std::size_t cell_count = cell_start_.size() - 1;
+    const std::size_t entry_count = cell_entries_.size();
+    if (pool == nullptr || pool->thread_count() == 1 || entry_count < kParallelSweepGrain * 2) {
+        scratch_.resize(1);
+        stats_.pair_tests = sweep_cells(0, cell_count, scratch_[0], pairs);
+    } else {
+        // 单元按块并行扫描，每块平均约 kParallelSweepGrain 个物体，各块输出按块序号合并
+        const std::size_t grain = std::max<std::size_t>(1, kParallelSweepGrain * cell_count / entry_count);
+        const std::size_t chunks = WorkStealingPool::chunk_count(cell_count, grain);
+        scratch_.resize(pool->thread_count());
+        chunk_pairs_.resize(chunks);
+        chunk_tests_.assign(chunks, 0);
+
+        pool->parallel_for(cell_count, grain, [&](const JobRange& range) {
+            auto& out = chunk_pairs_[range.chunk];
+            out.clear();
+            chunk_tests_[range.chunk] = sweep_cells(range.begin, range.end, scratch_[range.worker], out);
+        });
+
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+            pairs.insert(pairs.end(), chunk_pairs_[chunk].begin(), chunk_pairs_[chunk].end());
+            stats_.pair_tests += chunk_tests_[chunk];
+        }
+    }
+
+    // 按 (a, b) 排序，输出顺序与网格划分、分块细节无关，保证后续碰撞响应的确定性
+    pair_keys_.resize(pairs.size());
+    for (std::size_t p = 0; p < pairs.size(); ++p) {
+        pair_keys_[p] = (static_cast<std::uint64_t>(pairs[p].a) << 32) | pairs[p].b;
+    }
+    radix_sort(pair_keys_, radix_scratch_);
+    for (std::size_t p = 0; p < pairs.size(); ++p) {
+        pairs[p] = {static_cast<std::uint32_t>(pair_keys_[p] >> 32), static_cast<std::uint32_t>(pair_keys_[p])};
+    }
+    stats_.pair_count = pairs.size();
+}
+
+}  // namespace Corona::Systems
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <corona/job_pool.h>
+
+#include "aabb_kernels.h"
+#include "aabb_soa.h"
+
+namespace Corona::Systems {
+
+/**
+ * @brief 宽阶段输出的候选碰撞对
+ *
+ * a、b 为物体在本帧物体数组中的下标，始终满足 a < b，每对只输出一次。
+ */
+struct BroadphasePair {
+    std::uint32_t a;
+    std::uint32_t b;
+};
+
+/**
+ * @brief 宽阶段统计信息（用于性能分析与基准测试）
+ */
+struct BroadphaseStats {
+    std::size_t body_count = 0;
+    std::size_t pair_tests = 0;      ///< 扫描阶段实际进行的包围盒比较次数
+    std::size_t pair_count = 0;      ///< 输出的候选对数量
+    std::size_t sort_moves = 0;      ///< 增量插入排序移动的元素次数
+    std::size_t cell_count = 0;      ///< 本帧划分的扫描单元数量
+    std::size_t entry_count = 0;     ///< 各单元中的物体总数，跨单元的物体计入多次
+    float cell_size = 0.0f;          ///< 本帧实际使用的单元边长
+    bool full_resort = false;        ///< 本帧是否退化为完整排序
+};
+
+/**
+ * @brief 增量式扫描-剪枝（Sweep and Prune）宽阶段
+ *
+ * 在方差最大的轴上按包围盒最小值排序，排序结果跨帧保留，物体运动连贯时插入排序接近 O(n)。
+ * 其余两轴划分为均匀网格，每个物体按排序顺序放入与其包围盒相交的各个单元，
+ * 再在每个单元内沿排序轴扫描区间重叠，候选数量只与单元内的密度有关，不随场景规模增长。
+ * 跨单元的候选对只在两者包围盒交集的最小角所在的单元输出一次。
+ * 扫描在按单元重排的 SoA 副本上进行，候选区间连续，由向量化核一次测试多个包围盒。
+ */
+class SweepAndPrune {
+   public:
+    /**
+     * @brief 自动选择单元边长时相对物体平均尺寸的倍数
+     */
+    static constexpr float kAutoCellScale = 2.0f;
+
+    /**
+     * @brief 设置网格单元边长
+     * @param size 边长，小于等于 0 时按物体平均尺寸自动选择；单元数量最多为物体数量的若干倍，过小时自动放大
+     */
+    void set_cell_size(float size) {
+        cell_size_ = size;
+    }
+
+    [[nodiscard]] float cell_size() const {
+        return cell_size_;
+    }
+
+    /**
+     * @brief 更新排序并生成候选对
+     * @param bounds 本帧所有物体的世界空间包围盒（SoA 布局）
+     * @param pairs 输出的候选对（会被清空），按 (a, b) 升序排列
+     * @param pool 可选的工作线程池，提供时扫描阶段按排序区间分块并行
+     */
+    void update(const AabbSoA& bounds, std::vector<BroadphasePair>& pairs, WorkStealingPool* pool = nullptr);
+
+    /**
+     * @brief 清空跨帧排序状态，下一帧将重新完整排序
+     */
+    void reset();
+
+    [[nodiscard]] const BroadphaseStats& stats() const {
+        return stats_;
+    }
+
+   private:
+    /**
+     * @brief 单元扫描时每个参与者的临时缓冲
+     */
+    struct CellScratch {
+        AabbSoA bounds;                    ///< 当前单元内物体的包围盒，按排序轴顺序
+        std::vector<std::uint32_t> pos;    ///< 与 bounds 对应的排序位置
+        std::vector<std::int32_t> lo_u;    ///< 与 bounds 对应的起始单元坐标，用于去重
+        std::vector<std::int32_t> lo_v;
+        std::vector<std::uint32_t> hits;   ///< 重叠测试输出（bounds 下标）
+    };
+
+    void select_axis(const AabbSoA& bounds);
+    void sort_order(const AabbSoA& bounds);
+    void build_cells();
+    std::size_t sweep_cells(std::size_t begin, std::size_t end, CellScratch& scratch,
+                            std::vector<BroadphasePair>& out) const;
+
+    std::vector<std::uint64_t> sort_keys_;  ///< 高 32 位为扫描轴最小值的可排序编码，低 32 位为物体下标
+    std::vector<std::uint32_t> order_;      ///< 按扫描轴最小值排序后的物体下标
+    std::vector<std::uint64_t> pair_keys_;  ///< 候选对排序用，高 32 位为 a，低 32 位为 b
+    std::vector<std::uint64_t> radix_scratch_;
+    /**
+     * @brief 按排序位置存放的物体，按单元收集时每个物体只读取一个缓存行
+     */
+    struct alignas(32) SortedBody {
+        AabbQuery bounds;
+        std::int32_t lo_u = 0;  ///< 覆盖的起始单元坐标
+        std::int32_t lo_v = 0;
+    };
+
+    std::vector<SortedBody> sorted_;  ///< 按 order_ 重排的物体
+
+    // 按排序位置记录各物体覆盖的最后一个单元（含）
+    std::vector<std::int32_t> cell_hi_u_;
+    std::vector<std::int32_t> cell_hi_v_;
+    std::vector<std::uint32_t> cell_start_;    ///< 各单元在 cell_entries_ 中的起始位置，末尾为总数
+    std::vector<std::uint32_t> cell_fill_;     ///< 填充单元时的写入位置
+    std::vector<std::uint32_t> cell_entries_;  ///< 按单元排列的排序位置，单元内按排序轴顺序
+    std::int32_t cells_u_ = 1;
+    std::int32_t cells_v_ = 1;
+
+    std::vector<CellScratch> scratch_;                      ///< 每个参与者一份
+    std::vector<std::vector<BroadphasePair>> chunk_pairs_;  ///< 并行扫描时每块的候选对
+    std::vector<std::size_t> chunk_tests_;                  ///< 并行扫描时每块的比较次数
+    float cell_size_ = 0.0f;            ///< 0 表示自动选择
+    int axis_ = 0;                      ///< 当前扫描轴 (0 = x, 1 = y, 2 = z)
+    bool axis_changed_ = true;
+    BroadphaseStats stats_;
+};
+
+}  // namespace Corona::Systems
@@ -0,0 +1,93 @@
+#include "island_builder.h"
+
+#include <numeric>
+
+namespace Corona::Systems {
+
+std::uint32_t IslandBuilder::find(std::uint32_t body) {
+    // 路径减半
+    while (parent_[body] != body) {
+        parent_[body] = parent_[parent_[body]];
+        body = parent_[body];
+    }
+    return body;
+}
+
+void IslandBuilder::unite(std::uint32_t a, std::uint32_t b) {
+    a = find(a);
+    b = find(b);
+    if (a == b) {
+        return;
+    }
+    // 以较小下标为根，使根即为岛内最小物体下标
+    if (a < b) {
+        parent_[b] = a;
+    } else {
+        parent_[a] = b;
+    }
+}
+
+void IslandBuilder::build(const std::vector<std::uint8_t>& dynamic, const std::vector<BroadphasePair>& pairs) {
+    const std::size_t body_count = dynamic.size();
+
+    parent_.resize(body_count);
+    std::iota(parent_.begin(), parent_.end(), std::uint32_t{0});
+
+    for (const auto& pair : pairs) {
+        if (dynamic[pair.a] && dynamic[pair.b]) {
+            unite(pair.a, pair.b);
+        }
+    }
+
+    // 按根的下标顺序为岛编号
+    island_of_.assign(body_count, kNoIsland);
+    body_offsets_.clear();
+    body_offsets_.push_back(0);
+    std::uint32_t islands = 0;
+    for (std::uint32_t body = 0; body < body_count; ++body) {
+        if (dynamic[body] && find(body) == body) {
+            island_of_[body] = islands++;
+            body_offsets_.push_back(0);
+        }
+    }
+    for (std::uint32_t body = 0; body < body_count; ++body) {
+        if (dynamic[body]) {
+            island_of_[body] = island_of_[find(body)];
+            ++body_offsets_[island_of_[body] + 1];
+        }
+    }
+
+    // 计数排序得到各岛的物体列表
+    std::partial_sum(body_offsets_.begin(), body_offsets_.end(), body_offsets_.begin());
+    body_list_.resize(body_offsets_.back());
+    cursor_.assign(body_offsets_.begin(), body_offsets_.end() - 1);
+    for (std::uint32_t body = 0; body < body_count; ++body) {
+        if (island_of_[body] != kNoIsland) {
+            body_list_[cursor_[island_of_[body]]++] = body;
+        }
+    }
+
+    // 碰撞对归属于其中动态物体所在的岛，两个静态物体之间的碰撞对不属于任何岛
+    const auto pair_island = [this](const BroadphasePair& pair) {
+        return island_of_[pair.a] != kNoIsland ? island_of_[pair.a] : island_of_[pair.b];
+    };
+
+    pair_offsets_.assign(islands + 1, 0);
+    for (const auto& pair : pairs) {
+        const std::uint32_t island = pair_island(pair);
+        if (island != kNoIsland) {
+            ++pair_offsets_[island + 1];
+        }
+    }
+    std::partial_sum(pair_offsets_.begin(), pair_offsets_.end(), pair_offsets_.begin());
+    pair_list_.resize(pair_offsets_.back());
+    cursor_.assign(pair_offsets_.begin(), pair_offsets_.end() - 1);
+    for (std::uint32_t p = 0; p < pairs.size(); ++p) {
+        const std::uint32_t island = pair_island(pairs[p]);
+        if (island != kNoIsland) {
+            pair_list_[cursor_[island]++] = p;
+        }
+    }
+}
+
+}  // namespace Corona::Systems
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "broadphase.h"
+
+namespace Corona::Systems {
+
+/**
+ * @brief 按接触关系把动态物体划分为互不相交的岛
+ *
+ * 以宽阶段候选对为边做并查集，静态物体不参与合并（它们不传递运动），
+ * 因此压在同一块地面上的两堆物体属于不同的岛，可以分别休眠、并行求解。
+ * 岛内物体与碰撞对都按原下标升序排列，岛的编号按其最小物体下标排序，结果与线程数量无关。
+ */
+class IslandBuilder {
+   public:
+    static constexpr std::uint32_t kNoIsland = ~std::uint32_t{0};
+
+    /**
+     * @brief 重新划分岛
+     * @param dynamic 每个物体是否为动态物体（非 0 为动态）
+     * @param pairs 宽阶段输出的候选对
+     */
+    void build(const std::vector<std::uint8_t>& dynamic, const std::vector<BroadphasePair>& pairs);
+
+    [[nodiscard]] std::size_t island_count() const {
+        return body_offsets_.empty() ? 0 : body_offsets_.size() - 1;
+    }
+
+    /**
+     * @brief 物体所属的岛，静态物体返回 kNoIsland
+     */
+    [[nodiscard]] std::uint32_t island_of(std::size_t body) const {
+        return island_of_[body];
+    }
+
+    /**
+     * @brief 岛内物体下标（升序）
+     */
+    [[nodiscard]] std::span<const std::uint32_t> bodies(std::size_t island) const {
+        return {body_list_.data() + body_offsets_[island], body_offsets_[island + 1] - body_offsets_[island]};
+    }
+
+    /**
+     * @brief 岛内碰撞对在 pairs 中的下标（升序），包含与静态物体的碰撞对
+     */
+    [[nodiscard]] std::span<const std::uint32_t> pairs(std::size_t island) const {
+        return {pair_list_.data() + pair_offsets_[island], pair_offsets_[island + 1] - pair_offsets_[island]};
+    }
+
+   private:
+    std::uint32_t find(std::uint32_t body);
+    void unite(std::uint32_t a, std::uint32_t b);
+
+    std::vector<std::uint32_t> parent_;
+    std::vector<std::uint32_t> island_of_;
+    std::vector<std::uint32_t> body_offsets_;
+    std::vector<std::uint32_t> body_list_;
+    std::vector<std::uint32_t> pair_offsets_;
+    std::vector<std::uint32_t> pair_list_;
+    std::vector<std::uint32_t> cursor_;
+};
+
+}  // namespace Corona::Systems
@@ -3,283 +3,574 @@
 #include <corona/kernel/core/i_logger.h>
 #include <corona/kernel/event/i_event_bus.h>
 #include <corona/kernel/event/i_event_stream.h>
+#include <corona/metrics.h>
+#include <corona/profiler.h>
 #include <corona/systems/mechanics/mechanics_system.h>
+#include <corona/systems/mechanics/spatial_index.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 
 #include "corona/shared_data_hub.h"
 #include "ktm/ktm.h"
+#include "mechanics_world.h"
 
 namespace {
-std::vector<ktm::fvec3> calculateVertices(const ktm::fvec3& startMin, const ktm::fvec3& startMax) {
-    std::vector<ktm::fvec3> vertices;
-    vertices.reserve(8);
-
-    vertices.push_back(startMin);
-
-    ktm::fvec3 v1;
-    v1.x = startMax.x;
-    v1.y = startMin.y;
-    v1.z = startMin.z;
-    vertices.push_back(v1);
-
-    ktm::fvec3 v2;
-    v2.x = startMin.x;
-    v2.y = startMax.y;
-    v2.z = startMin.z;
-    vertices.push_back(v2);
-
-    ktm::fvec3 v3;
-    v3.x = startMax.x;
-    v3.y = startMax.y;
-    v3.z = startMin.z;
-    vertices.push_back(v3);
-
-    ktm::fvec3 v4;
-    v4.x = startMin.x;
-    v4.y = startMin.y;
-    v4.z = startMax.z;
-    vertices.push_back(v4);
-
-    ktm::fvec3 v5;
-    v5.x = startMax.x;
-    v5.y = startMin.y;
-    v5.z = startMax.z;
-    vertices.push_back(v5);
-
-    ktm::fvec3 v6;
-    v6.x = startMin.x;
-    v6.y = startMax.y;
-    v6.z = startMax.z;
-    vertices.push_back(v6);
-
-    vertices.push_back(startMax);
-
-    return vertices;
+/**
+ * @brief 力学系统导出的指标，首次使用时注册
+ */
+struct MechanicsMetrics {
+    Corona::Gauge& manifolds;
+    Corona::Gauge& contacts;
+    Corona::Counter& contacts_total;
+    Corona::Gauge& active_bodies;
+    Corona::Gauge& sleeping_bodies;
+
+    static MechanicsMetrics& instance() {
+        auto& registry = Corona::MetricsRegistry::instance();
+        static MechanicsMetrics metrics{
+            registry.gauge("corona_mechanics_manifolds", "Contact manifolds in the last physics update"),
+            registry.gauge("corona_mechanics_contacts", "Contact points solved in the last physics update"),
+            registry.counter("corona_mechanics_contacts_total", "Contact points solved since startup"),
+            registry.gauge("corona_mechanics_active_bodies", "Awake dynamic bodies after the last physics update"),
+            registry.gauge("corona_mechanics_sleeping_bodies", "Sleeping dynamic bodies after the last physics update"),
+        };
+        return metrics;
+    }
+};
+
+/**
+ * @brief 将局部包围盒变换到世界空间
+ *
+ * 用中心点加三个半轴向量的绝对值之和求世界包围盒（Arvo 方法），
+ * 与变换 8 个顶点结果相同，但只需 4 次矩阵向量乘且不分配内存。
+ */
+void transform_bounds(const ktm::fmat4x4& matrix, const ktm::fvec3& local_min, const ktm::fvec3& local_max,
+                      ktm::fvec3& world_min, ktm::fvec3& world_max) {
+    ktm::fvec4 center;
+    center.x = (local_min.x + local_max.x) * 0.5f;
+    center.y = (local_min.y + local_max.y) * 0.5f;
+    center.z = (local_min.z + local_max.z) * 0.5f;
+    center.w = 1.0f;
+
+    // 三个局部半轴向量（w = 0，不受平移影响）
+    ktm::fvec4 axis_x;
+    axis_x.x = (local_max.x - local_min.x) * 0.5f;
+    axis_x.y = 0.0f;
+    axis_x.z = 0.0f;
+    axis_x.w = 0.0f;
+
+    ktm::fvec4 axis_y;
+    axis_y.x = 0.0f;
+    axis_y.y = (local_max.y - local_min.y) * 0.5f;
+    axis_y.z = 0.0f;
+    axis_y.w = 0.0f;
+
+    ktm::fvec4 axis_z;
+    axis_z.x = 0.0f;
+    axis_z.y = 0.0f;
+    axis_z.z = (local_max.z - local_min.z) * 0.5f;
+    axis_z.w = 0.0f;
+
+    const ktm::fvec4 world_center = matrix * center;
+    const ktm::fvec4 world_x = matrix * axis_x;
+    const ktm::fvec4 world_y = matrix * axis_y;
+    const ktm::fvec4 world_z = matrix * axis_z;
+
+    const float extent_x = std::fabs(world_x.x) + std::fabs(world_y.x) + std::fabs(world_z.x);
+    const float extent_y = std::fabs(world_x.y) + std::fabs(world_y.y) + std::fabs(world_z.y);
+    const float extent_z = std::fabs(world_x.z) + std::fabs(world_y.z) + std::fabs(world_z.z);
+
+    world_min.x = world_center.x - extent_x;
+    world_min.y = world_center.y - extent_y;
+    world_min.z = world_center.z - extent_z;
+    world_max.x = world_center.x + extent_x;
+    world_max.y = world_center.y + extent_y;
+    world_max.z = world_center.z + extent_z;
 }
+}  // namespace
+
+namespace Corona::Systems {
+namespace {
+/**
+ * @brief 读取第 index 个物体的状态与世界包围盒
+ *
+ * 物体处于休眠且 wake 为 false 时只读取 MechanicsDevice，使用入睡时缓存的包围盒；
+ * 否则读取几何与变换并重新计算世界包围盒。wake 为 true 时物体同时被唤醒。
+ * @return 无法获取访问权、局部包围盒为空或变换带父节点时返回 false
+ */
+bool load_body(MechanicsWorld& world, std::size_t index, std::uintptr_t handle, bool wake) {
+    auto& mechanics = SharedDataHub::instance().mechanics_storage();
+    auto& geometry = SharedDataHub::instance().geometry_storage();
+    auto& transforms = SharedDataHub::instance().model_transform_storage();
 
-bool checkCollision(const std::vector<ktm::fvec3>& vertices1, const std::vector<ktm::fvec3>& vertices2) {
-    // 计算vertices2的AABB
-    ktm::fvec3 min2 = vertices2[0], max2 = vertices2[0];
-    for (const auto& v : vertices2) {
-        min2 = ktm::min(min2, v);
-        max2 = ktm::max(max2, v);
+    auto m_accessor = mechanics.acquire_read(handle);
+    if (!m_accessor) {
+        return false;  // 无法获取访问权，跳过
+    }
+    if (!m_accessor->has_volume()) {
+        return false;  // 没有体积的物体无法计算质量属性与接触，不参与模拟
     }
 
-    // 检查vertices1的顶点是否在vertices2的AABB内
-    for (const auto& point : vertices1) {
-        if (point.x >= min2.x && point.x <= max2.x &&
-            point.y >= min2.y && point.y <= max2.y &&
-            point.z >= min2.z && point.z <= max2.z) {
-            return true;
-        }
+    auto& body = world.rigid_bodies[index];
+    world.bodies[index].mechanics_handle = handle;
+    world.bodies[index].geometry_handle = m_accessor->geometry_handle;
+    world.bodies[index].revision = m_accessor->revision;
+    body.was_sleeping = m_accessor->sleeping;
+    body.continuous = m_accessor->continuous;
+    body.rotated = false;
+
+    if (m_accessor->sleeping && !wake) {
+        const auto& sleep_min = m_accessor->sleep_min_xyz;
+        const auto& sleep_max = m_accessor->sleep_max_xyz;
+        world.bounds.set(index, sleep_min.x, sleep_min.y, sleep_min.z, sleep_max.x, sleep_max.y, sleep_max.z);
+
+        // 休眠物体只需参与宽阶段与岛划分，被唤醒时再完整读取
+        world.bodies[index].transform_handle = 0;
+        body.center = (sleep_min + sleep_max) * 0.5f;
+        body.inv_mass = m_accessor->mass > 0.0f ? 1.0f / m_accessor->mass : 0.0f;
+        body.sleeping = true;
+        body.sleep_timer = m_accessor->sleep_timer;
+        return true;
     }
 
-    // 计算vertices1的AABB
-    ktm::fvec3 min1 = vertices1[0], max1 = vertices1[0];
-    for (const auto& v : vertices1) {
-        min1 = ktm::min(min1, v);
-        max1 = ktm::max(max1, v);
+    auto geom_accessor = geometry.acquire_read(m_accessor->geometry_handle);
+    if (!geom_accessor) {
+        return false;
     }
 
-    // 检查vertices2的顶点是否在vertices1的AABB内
-    for (const auto& point : vertices2) {
-        if (point.x >= min1.x && point.x <= max1.x &&
-            point.y >= min1.y && point.y <= max1.y &&
-            point.z >= min1.z && point.z <= max1.z) {
-            return true;
-        }
+    auto transform_accessor = transforms.acquire_read(geom_accessor->transform_handle);
+    if (!transform_accessor) {
+        return false;
     }
+    if (transform_accessor->parent_handle != 0) {
+        return false;  // 带父节点的位姿在父空间中，而力学系统按世界空间求解，不参与模拟
+    }
+
+    // 从局部参数计算世界矩阵
+    const ktm::fmat4x4 world_matrix = transform_accessor->compute_matrix();
+
+    ktm::fvec3 world_min;
+    ktm::fvec3 world_max;
+    transform_bounds(world_matrix, m_accessor->min_xyz, m_accessor->max_xyz, world_min, world_max);
+
+    world.bodies[index].transform_handle = geom_accessor->transform_handle;
+    world.bounds.set(index, world_min.x, world_min.y, world_min.z, world_max.x, world_max.y, world_max.z);
+
+    // 刚体状态：质心取世界包围盒中心，质量属性按盒体近似
+    const auto& local_min = m_accessor->min_xyz;
+    const auto& local_max = m_accessor->max_xyz;
+    const auto& scale = transform_accessor->scale;
+
+    body.center = (world_min + world_max) * 0.5f;
+    body.center_offset.x = (local_min.x + local_max.x) * 0.5f * scale.x;
+    body.center_offset.y = (local_min.y + local_max.y) * 0.5f * scale.y;
+    body.center_offset.z = (local_min.z + local_max.z) * 0.5f * scale.z;
+    body.euler_rotation = transform_accessor->euler_rotation;
+    body.rotation = basis_from_euler(body.euler_rotation);
+    body.linear_velocity = m_accessor->linear_velocity;
+    body.angular_velocity = m_accessor->angular_velocity;
+    body.restitution = m_accessor->restitution;
+    body.friction = m_accessor->friction;
+    body.gravity_scale = m_accessor->gravity_scale;
+    body.sleeping = false;
+    body.sleep_timer = wake ? 0.0f : m_accessor->sleep_timer;
 
-    return false;
+    ktm::fvec3 half_extents;
+    half_extents.x = std::fabs((local_max.x - local_min.x) * 0.5f * scale.x);
+    half_extents.y = std::fabs((local_max.y - local_min.y) * 0.5f * scale.y);
+    half_extents.z = std::fabs((local_max.z - local_min.z) * 0.5f * scale.z);
+    set_box_mass(body, m_accessor->mass, half_extents);
+    return true;
 }
 }  // namespace
 
-namespace Corona::Systems {
+MechanicsSystem::MechanicsSystem()
+    : world_(std::make_unique<MechanicsWorld>()) {
+    set_target_fps(kDefaultTargetFps);
+}
+
+MechanicsSystem::~MechanicsSystem() = default;
+
 bool MechanicsSystem::initialize(Kernel::ISystemContext* ctx) {
     CFW_LOG_NOTICE("MechanicsSystem: Initializing...");
     return true;
 }
 
 void MechanicsSystem::update() {
-    update_physics();
+    advance(delta_time());
 }
 
-void MechanicsSystem::update_physics() {
+void MechanicsSystem::advance(float elapsed) {
+    auto& world = *world_;
+    const float step = fixed_time_step();
+    const int max_steps = max_substeps();
+
+    // 固定步长累加器：模拟速度只取决于真实经过的时间，与线程调度无关
+    world.accumulator += std::max(elapsed, 0.0f);
+    world.settings.time_step = step;
+
+    int steps = 0;
+    while (world.accumulator >= step && steps < max_steps) {
+        ++world.step_count;
+        update_physics();
+        world.accumulator -= step;
+        ++steps;
+    }
+
+    // 达到子步上限时丢弃积压时间，避免死亡螺旋
+    if (world.accumulator >= step) {
+        CFW_LOG_DEBUG("MechanicsSystem: Dropping {:.4f}s of simulation time after {} sub-steps",
+                      world.accumulator - std::fmod(world.accumulator, step), steps);
+        world.accumulator = std::fmod(world.accumulator, step);
+    }
+
+    if (steps > 0) {
+        publish_spatial_index();
+    }
+
+    const float alpha = world.accumulator / step;
+    interpolation_alpha_.store(alpha, std::memory_order_relaxed);
+
+    PhysicsInterpolation interpolation;
+    interpolation.step = world.step_count;
+    interpolation.time_step = step;
+    interpolation.accumulator = world.accumulator;
+    interpolation.published_at = std::chrono::steady_clock::now();
+
+    if (steps == 0) {
+        // 没有新的步，已发布的位姿仍属于 interpolation.step，只更新插值时刻
+        SharedDataHub::instance().publish_physics_interpolation(interpolation);
+        return;
+    }
+
+    // 发布最后一步写回的位姿：主循环复制变换时可能与下一步的写回交错，快照中的刚体以此为准
+    auto poses = SharedDataHub::instance().acquire_physics_poses();
+    poses->step = world.step_count;
+    poses->poses.clear();
+    for (std::size_t i = 0; i < world.pose_written.size(); ++i) {
+        if (world.pose_written[i]) {
+            poses->poses.push_back(world.written_poses[i]);
+        }
+    }
+    SharedDataHub::instance().publish_physics_poses(std::move(poses), interpolation);
+}
+
+void MechanicsSystem::set_broadphase_cell_size(float size) {
+    broadphase_cell_size_.store(std::max(size, 0.0f), std::memory_order_relaxed);
+}
+
+float MechanicsSystem::broadphase_cell_size() const {
+    return broadphase_cell_size_.load(std::memory_order_relaxed);
+}
+
+void MechanicsSystem::set_fixed_time_step(float seconds) {
+    if (seconds <= 0.0f) {
+        CFW_LOG_WARNING("MechanicsSystem: Ignoring non-positive fixed time step {}", seconds);
+        return;
+    }
+    fixed_time_step_.store(seconds, std::memory_order_relaxed);
+}
+
+float MechanicsSystem::fixed_time_step() const {
+    return fixed_time_step_.load(std::memory_order_relaxed);
+}
+
+void MechanicsSystem::set_max_substeps(int count) {
+    max_substeps_.store(std::max(count, 1), std::memory_order_relaxed);
+}
+
+int MechanicsSystem::max_substeps() const {
+    return max_substeps_.load(std::memory_order_relaxed);
+}
+
+float MechanicsSystem::interpolation_alpha() const {
+    return interpolation_alpha_.load(std::memory_order_relaxed);
+}
+
+void MechanicsSystem::set_worker_count(std::size_t count) {
+    requested_worker_count_.store(count, std::memory_order_relaxed);
+}
+
+void MechanicsSystem::set_auto_worker_count(std::size_t count) {
+    auto_worker_count_.store(count, std::memory_order_relaxed);
+}
+
+std::size_t MechanicsSystem::active_body_count() const {
+    return active_body_count_.load(std::memory_order_relaxed);
+}
+
+std::size_t MechanicsSystem::sleeping_body_count() const {
+    return sleeping_body_count_.load(std::memory_order_relaxed);
+}
+
+std::size_t MechanicsSystem::worker_count() const {
+    if (const std::size_t requested = requested_worker_count_.load(std::memory_order_relaxed); requested != 0) {
+        return requested;
+    }
+    const std::size_t automatic = auto_worker_count_.load(std::memory_order_relaxed);
+    return automatic == 0 ? WorkStealingPool::default_thread_count() : automatic;
+}
+
+void MechanicsSystem::ensure_worker_pool() {
+    auto& world = *world_;
+    const std::size_t desired = worker_count();
+    if (!world.pool || world.pool->thread_count() != desired) {
+        world.pool.reset();
+        world.pool = std::make_unique<WorkStealingPool>(desired);
+        CFW_LOG_INFO("MechanicsSystem: Worker pool started with {} threads", desired);
+    }
+}
+
+void MechanicsSystem::gather_bodies() {
     auto& mechanics_storage = SharedDataHub::instance().mechanics_storage();
-    auto& geometry_storage = SharedDataHub::instance().geometry_storage();
-    auto& transform_storage = SharedDataHub::instance().model_transform_storage();
-    
-    // 获取所有的 MechanicsDevice 句柄
-    std::vector<std::uintptr_t> mechanics_handles;
-    
-    // 遍历所有 MechanicsDevice 来收集句柄（假设有 for_each 或类似方法）
-    // 如果没有遍历方法，我们需要维护一个句柄列表或使用其他方式获取所有活动句柄
-    
-    // 临时解决方案：假设我们有一种方式获取所有活动的句柄
-    // 这里需要根据实际的 Storage API 进行调整
-    
-    CFW_LOG_DEBUG("MechanicsSystem: Starting collision detection update");
-    
-    // 双重循环进行碰撞检测
-    // 注意：这里需要根据实际的 Storage API 来获取所有活动句柄
-    // 目前我们先实现基本框架，假设我们有方式获取句柄列表
-    
-    // 示例：如果我们有一些方式获取句柄列表
-    for (std::uintptr_t handle1 : mechanics_handles) {
-        // 获取第一个 MechanicsDevice 的读取访问权
-        auto m1_accessor = mechanics_storage.acquire_read(handle1);
-        if (!m1_accessor) {
-            continue; // 无法获取访问权，跳过
+    auto& world = *world_;
+
+    // 获取所有活动的 MechanicsDevice 句柄，仅在句柄列表变化时重新拷贝
+    if (mechanics_storage.version() != world.handles_version) {
+        world.handles_version = mechanics_storage.snapshot_handles(world.mechanics_handles);
+    }
+
+    const std::size_t handle_count = world.mechanics_handles.size();
+    world.bodies.resize(handle_count);
+    world.rigid_bodies.resize(handle_count);
+    world.bounds.resize(handle_count);
+    world.body_valid.assign(handle_count, 0);
+
+    // 每个物体每帧只计算一次世界矩阵与世界包围盒，按句柄下标写入，结果与线程数无关；
+    // 休眠物体只读取 MechanicsDevice
+    world.pool->parallel_for(handle_count, MechanicsWorld::kGatherGrain, [&world](const JobRange& range) {
+        for (std::size_t i = range.begin; i < range.end; ++i) {
+            world.body_valid[i] = load_body(world, i, world.mechanics_handles[i], false) ? 1 : 0;
+        }
+    });
+
+    // 按原顺序压缩掉无法访问的物体
+    std::size_t write = 0;
+    for (std::size_t read = 0; read < handle_count; ++read) {
+        if (!world.body_valid[read]) {
+            continue;
         }
-        
-        const auto& m1 = *m1_accessor;
-        
-        for (std::uintptr_t handle2 : mechanics_handles) {
-            if (handle1 == handle2) {
-                continue; // 跳过自身
+        if (write != read) {
+            world.bodies[write] = world.bodies[read];
+            world.rigid_bodies[write] = world.rigid_bodies[read];
+            world.bounds.set(write, world.bounds.min_x[read], world.bounds.min_y[read], world.bounds.min_z[read],
+                             world.bounds.max_x[read], world.bounds.max_y[read], world.bounds.max_z[read]);
+        }
+        ++write;
+    }
+    world.bodies.resize(write);
+    world.rigid_bodies.resize(write);
+    world.bounds.resize(write);
+
+    world.body_keys.resize(write);
+    for (std::size_t i = 0; i < write; ++i) {
+        world.body_keys[i] = world.bodies[i].mechanics_handle;
+    }
+}
+
+void MechanicsSystem::publish_spatial_index() {
+    auto& world = *world_;
+    const auto& bounds = world.bounds;
+
+    // 快照发布后由 SharedDataHub 与查询线程共享，不能放在帧内存或成员缓冲中；
+    // 改为回收已不再被其他线程持有的旧快照的条目缓冲区，稳态下不再分配
+    std::vector<SpatialIndex::Entry> entries;
+    std::erase_if(world.published_indices, [&entries](const std::shared_ptr<SpatialIndex>& index) {
+        if (index.use_count() != 1) {
+            return false;
+        }
+        // 与最后一个持有者释放引用（acq_rel）配对，之后才能安全地改写其中的数据
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (entries.capacity() == 0) {
+            entries = index->take_entries();
+        }
+        return true;
+    });
+
+    // 本步开始时的包围盒随质心平移到本步结束时的位置
+    entries.resize(world.bodies.size());
+    for (std::size_t i = 0; i < world.bodies.size(); ++i) {
+        const auto& body = world.rigid_bodies[i];
+        const float dx = body.center.x - (bounds.min_x[i] + bounds.max_x[i]) * 0.5f;
+        const float dy = body.center.y - (bounds.min_y[i] + bounds.max_y[i]) * 0.5f;
+        const float dz = body.center.z - (bounds.min_z[i] + bounds.max_z[i]) * 0.5f;
+
+        auto& entry = entries[i];
+        entry.min.x = bounds.min_x[i] + dx;
+        entry.min.y = bounds.min_y[i] + dy;
+        entry.min.z = bounds.min_z[i] + dz;
+        entry.max.x = bounds.max_x[i] + dx;
+        entry.max.y = bounds.max_y[i] + dy;
+        entry.max.z = bounds.max_z[i] + dz;
+        entry.body.mechanics_handle = world.bodies[i].mechanics_handle;
+        entry.body.geometry_handle = world.bodies[i].geometry_handle;
+    }
+
+    auto index = std::make_shared<SpatialIndex>(std::move(entries));
+    if (world.published_indices.size() >= MechanicsWorld::kMaxTrackedSpatialIndices) {
+        // 被查询方长期持有的旧快照不再等待回收
+        world.published_indices.erase(world.published_indices.begin());
+    }
+    world.published_indices.push_back(index);
+    SharedDataHub::instance().publish_spatial_index(std::move(index));
+}
+
+void MechanicsSystem::wake_islands() {
+    auto& world = *world_;
+    const std::size_t body_count = world.rigid_bodies.size();
+
+    world.body_dynamic.resize(body_count);
+    for (std::size_t i = 0; i < body_count; ++i) {
+        world.body_dynamic[i] = world.rigid_bodies[i].inv_mass != 0.0f ? 1 : 0;
+    }
+    world.islands.build(world.body_dynamic, world.pairs);
+
+    // 岛内只要有一个物体未休眠，整个岛都参与求解
+    world.island_awake.assign(world.islands.island_count(), 0);
+    for (std::size_t island = 0; island < world.islands.island_count(); ++island) {
+        for (const std::uint32_t body : world.islands.bodies(island)) {
+            if (!world.rigid_bodies[body].sleeping) {
+                world.island_awake[island] = 1;
+                break;
             }
-            
-            // 获取第二个 MechanicsDevice 的读取访问权
-            auto m2_accessor = mechanics_storage.acquire_read(handle2);
-            if (!m2_accessor) {
+        }
+    }
+
+    // 唤醒活动岛中的休眠物体：重新完整读取其状态
+    for (std::size_t island = 0; island < world.islands.island_count(); ++island) {
+        if (!world.island_awake[island]) {
+            continue;
+        }
+        for (const std::uint32_t body : world.islands.bodies(island)) {
+            if (!world.rigid_bodies[body].sleeping) {
                 continue;
             }
-            
-            const auto& m2 = *m2_accessor;
-            
-            // 获取第一个物体的世界坐标顶点
-            std::vector<ktm::fvec3> vertices1;
-            bool found1 = false;
-            
-            if (auto geom1_accessor = geometry_storage.acquire_read(m1.geometry_handle)) {
-                const auto& geom1 = *geom1_accessor;
-                
-                if (auto transform1_accessor = transform_storage.acquire_read(geom1.transform_handle)) {
-                    const auto& transform1 = *transform1_accessor;
-                    
-                    vertices1 = calculateVertices(m1.min_xyz, m1.max_xyz);
-                    
-                    // 从局部参数计算世界矩阵
-                    ktm::fmat4x4 world_matrix = transform1.compute_matrix();
-                    
-                    for (auto& v : vertices1) {
-                        ktm::fvec4 v4;
-                        v4.x = v.x;
-                        v4.y = v.y;
-                        v4.z = v.z;
-                        v4.w = 1.0f;
-                        
-                        ktm::fvec4 world_v = world_matrix * v4;
-                        v.x = world_v.x;
-                        v.y = world_v.y;
-                        v.z = world_v.z;
-                    }
-                    found1 = true;
-                }
+            if (!load_body(world, body, world.body_keys[body], true)) {
+                // 无法读取时本步按静态物体处理，保持休眠
+                world.rigid_bodies[body].inv_mass = 0.0f;
             }
-            
-            if (!found1 || vertices1.empty()) {
+        }
+    }
+}
+
+void MechanicsSystem::update_physics() {
+    CORONA_PROFILE_SCOPE("MechanicsSystem::update_physics");
+    auto& world = *world_;
+
+    CFW_LOG_DEBUG("MechanicsSystem: Starting collision detection update");
+
+    ensure_worker_pool();
+    gather_bodies();
+
+    // 宽阶段：按网格单元分段扫描-剪枝生成候选对，每对只输出一次，且三轴包围盒均已重叠
+    // 存在连续物体时改用扫掠包围盒，其路径上的物体也成为候选对；没有连续物体时不产生额外开销
+    const bool has_continuous =
+        std::any_of(world.rigid_bodies.begin(), world.rigid_bodies.end(), [](const Corona::Systems::RigidBody& body) {
+            return body.continuous && !body.sleeping && body.inv_mass != 0.0f;
+        });
+    if (has_continuous) {
+        expand_swept_bounds(world.rigid_bodies, world.bounds, world.swept_bounds, world.settings);
+    }
+    world.broadphase.set_cell_size(broadphase_cell_size());
+    world.broadphase.update(has_continuous ? world.swept_bounds : world.bounds, world.pairs, world.pool.get());
+
+    // 岛划分：与活动物体接触的休眠岛整体唤醒
+    wake_islands();
+
+    // 求解：固定步长的顺序冲量求解器，接触冲量在帧间缓存用于热启动，休眠岛跳过
+    world.solver.step(world.rigid_bodies, world.body_keys, world.bounds, world.pairs, world.islands,
+                      world.island_awake, world.settings, world.pool.get());
+
+    // 批量写回：每个活动物体的变换与状态每帧各获取一次写访问，静态物体与持续休眠的物体不写回
+    world.written_poses.resize(world.bodies.size());
+    world.pose_written.assign(world.bodies.size(), 0);
+    world.pool->parallel_for(world.bodies.size(), MechanicsWorld::kGatherGrain, [&world](const JobRange& range) {
+        auto& mechanics = SharedDataHub::instance().mechanics_storage();
+        auto& transforms = SharedDataHub::instance().model_transform_storage();
+
+        for (std::size_t i = range.begin; i < range.end; ++i) {
+            const auto& body = world.rigid_bodies[i];
+            if (body.inv_mass == 0.0f || (body.was_sleeping && body.sleeping)) {
                 continue;
             }
-            
-            // 获取第二个物体的世界坐标顶点
-            std::vector<ktm::fvec3> vertices2;
-            bool found2 = false;
-            
-            if (auto geom2_accessor = geometry_storage.acquire_read(m2.geometry_handle)) {
-                const auto& geom2 = *geom2_accessor;
-                
-                if (auto transform2_accessor = transform_storage.acquire_read(geom2.transform_handle)) {
-                    const auto& transform2 = *transform2_accessor;
-                    
-                    vertices2 = calculateVertices(m2.min_xyz, m2.max_xyz);
-                    
-                    // 从局部参数计算世界矩阵
-                    ktm::fmat4x4 world_matrix = transform2.compute_matrix();
-                    
-                    for (auto& v : vertices2) {
-                        ktm::fvec4 v4;
-                        v4.x = v.x;
-                        v4.y = v.y;
-                        v4.z = v.z;
-                        v4.w = 1.0f;
-                        
-                        ktm::fvec4 world_v = world_matrix * v4;
-                        v.x = world_v.x;
-                        v.y = world_v.y;
-                        v.z = world_v.z;
-                    }
-                    found2 = true;
+
+            if (auto transform_accessor = transforms.acquire_write(world.bodies[i].transform_handle)) {
+                // 由质心反推变换原点：position = center - R * offset
+                const auto& r = body.rotation;
+                const auto& offset = body.center_offset;
+                transform_accessor->previous_position = transform_accessor->position;
+                transform_accessor->previous_euler_rotation = transform_accessor->euler_rotation;
+                transform_accessor->physics_step = world.step_count;
+                transform_accessor->position.x = body.center.x - ktm::dot(r.row0, offset);
+                transform_accessor->position.y = body.center.y - ktm::dot(r.row1, offset);
+                transform_accessor->position.z = body.center.z - ktm::dot(r.row2, offset);
+                if (body.rotated) {
+                    transform_accessor->euler_rotation = body.euler_rotation;
                 }
+
+                // 同时记下写回的位姿，更新结束时随插值状态一同发布
+                auto& pose = world.written_poses[i];
+                pose.transform_handle = world.bodies[i].transform_handle;
+                pose.position = transform_accessor->position;
+                pose.euler_rotation = transform_accessor->euler_rotation;
+                pose.previous_position = transform_accessor->previous_position;
+                pose.previous_euler_rotation = transform_accessor->previous_euler_rotation;
+                world.pose_written[i] = 1;
             }
-            
-            if (!found2 || vertices2.empty()) {
-                continue;
-            }
-            
-            // 碰撞检测
-            if (checkCollision(vertices1, vertices2)) {
-                CFW_LOG_DEBUG("Collision detected between objects with handles {} and {}", handle1, handle2);
-                
-                // 计算碰撞法线（从 m1 中心指向 m2 中心）
-                ktm::fvec3 center1;
-                center1.x = (m1.min_xyz.x + m1.max_xyz.x) * 0.5f;
-                center1.y = (m1.min_xyz.y + m1.max_xyz.y) * 0.5f;
-                center1.z = (m1.min_xyz.z + m1.max_xyz.z) * 0.5f;
-                
-                ktm::fvec3 center2;
-                center2.x = (m2.min_xyz.x + m2.max_xyz.x) * 0.5f;
-                center2.y = (m2.min_xyz.y + m2.max_xyz.y) * 0.5f;
-                center2.z = (m2.min_xyz.z + m2.max_xyz.z) * 0.5f;
-                
-                ktm::fvec3 diff;
-                diff.x = center2.x - center1.x;
-                diff.y = center2.y - center1.y;
-                diff.z = center2.z - center1.z;
-                
-                ktm::fvec3 normal = ktm::normalize(diff);
-                
-                // 物体分离（防止穿透）
-                constexpr float separation = 0.02f;
-                constexpr float bounceStrength = 0.1f;
-                
-                ktm::fvec3 total_offset;
-                total_offset.x = normal.x * (separation + bounceStrength);
-                total_offset.y = normal.y * (separation + bounceStrength);
-                total_offset.z = normal.z * (separation + bounceStrength);
-                
-                // 更新 m1 的 transform（反方向偏移）- 直接修改局部位置参数
-                if (auto geom1_accessor = geometry_storage.acquire_read(m1.geometry_handle)) {
-                    const auto& geom1 = *geom1_accessor;
-                    
-                    if (auto transform1_accessor = transform_storage.acquire_write(geom1.transform_handle)) {
-                        auto& transform1 = *transform1_accessor;
-                        
-                        // 直接修改局部位置参数
-                        transform1.position.x -= total_offset.x;
-                        transform1.position.y -= total_offset.y;
-                        transform1.position.z -= total_offset.z;
-                    }
+
+            if (auto m_accessor = mechanics.acquire_write(world.bodies[i].mechanics_handle)) {
+                // 收集之后脚本设置过速度或唤醒了物体：保留脚本的修改，下一步从其开始求解
+                if (m_accessor->revision != world.bodies[i].revision) {
+                    continue;
                 }
-                
-                // 更新 m2 的 transform（正方向偏移）- 直接修改局部位置参数
-                if (auto geom2_accessor = geometry_storage.acquire_read(m2.geometry_handle)) {
-                    const auto& geom2 = *geom2_accessor;
-                    
-                    if (auto transform2_accessor = transform_storage.acquire_write(geom2.transform_handle)) {
-                        auto& transform2 = *transform2_accessor;
-                        
-                        // 直接修改局部位置参数
-                        transform2.position.x += total_offset.x;
-                        transform2.position.y += total_offset.y;
-                        transform2.position.z += total_offset.z;
-                    }
+                m_accessor->linear_velocity = body.linear_velocity;
+                m_accessor->angular_velocity = body.angular_velocity;
+                m_accessor->sleeping = body.sleeping;
+                m_accessor->sleep_timer = body.sleep_timer;
+
+                if (body.sleeping) {
+                    // 入睡时缓存世界包围盒：本步开始时的包围盒随质心平移
+                    const auto& bounds = world.bounds;
+                    const float dx = body.center.x - (bounds.min_x[i] + bounds.max_x[i]) * 0.5f;
+                    const float dy = body.center.y - (bounds.min_y[i] + bounds.max_y[i]) * 0.5f;
+                    const float dz = body.center.z - (bounds.min_z[i] + bounds.max_z[i]) * 0.5f;
+                    m_accessor->sleep_min_xyz.x = bounds.min_x[i] + dx;
+                    m_accessor->sleep_min_xyz.y = bounds.min_y[i] + dy;
+                    m_accessor->sleep_min_xyz.z = bounds.min_z[i] + dz;
+                    m_accessor->sleep_max_xyz.x = bounds.max_x[i] + dx;
+                    m_accessor->sleep_max_xyz.y = bounds.max_y[i] + dy;
+                    m_accessor->sleep_max_xyz.z = bounds.max_z[i] + dz;
                 }
             }
         }
-    }
+    });
+
+    const auto& stats = world.broadphase.stats();
+    const auto& solver_stats = world.solver.stats();
+    active_body_count_.store(solver_stats.active_bodies, std::memory_order_relaxed);
+    sleeping_body_count_.store(solver_stats.sleeping_bodies, std::memory_order_relaxed);
+
+    auto& metrics = MechanicsMetrics::instance();
+    metrics.manifolds.set(static_cast<double>(solver_stats.manifold_count));
+    metrics.contacts.set(static_cast<double>(solver_stats.contact_count));
+    metrics.contacts_total.increment(solver_stats.contact_count);
+    metrics.active_bodies.set(static_cast<double>(solver_stats.active_bodies));
+    metrics.sleeping_bodies.set(static_cast<double>(solver_stats.sleeping_bodies));
+
+    CFW_LOG_DEBUG("MechanicsSystem: {} bodies, {} pair tests, {} candidate pairs, {} manifolds, {} contacts",
+                  stats.body_count, stats.pair_tests, stats.pair_count,
+                  solver_stats.manifold_count, solver_stats.contact_count);
+    CFW_LOG_DEBUG("MechanicsSystem: {} active bodies ({} continuous), {} sleeping bodies, {}/{} islands awake",
+                  solver_stats.active_bodies, solver_stats.ccd_bodies, solver_stats.sleeping_bodies,
+                  solver_stats.active_islands, solver_stats.island_count);
 }
 
 void MechanicsSystem::shutdown() {
     CFW_LOG_NOTICE("MechanicsSystem: Shutting down...");
+    world_->pool.reset();
+    world_->solver.reset();
 }
-}  // namespace Corona::Systems
\ No newline at end of file
+}  // namespace Corona::Systems
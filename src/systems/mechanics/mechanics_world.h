@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <corona/job_pool.h>
+#include <corona/shared_data_hub.h>
+#include <corona/systems/mechanics/spatial_index.h>
+#include <ktm/ktm.h>
+
+#include "aabb_soa.h"
+#include "broadphase.h"
+#include "island_builder.h"
+#include "rigid_body_solver.h"
+
+namespace Corona::Systems {
+
+/**
+ * @brief 力学系统的帧间状态
+ *
+ * 由 MechanicsSystem 独占持有，容器在帧间复用以避免重复分配。
+ */
+struct MechanicsWorld {
+    struct Body {
+        std::uintptr_t mechanics_handle{};
+        std::uintptr_t geometry_handle{};
+        std::uintptr_t transform_handle{};  ///< 本帧解析得到的变换句柄，响应阶段直接写回
+        std::uint32_t revision{};           ///< 收集时 MechanicsDevice::revision 的值
+    };
+
+    // 并行阶段每个任务区间的元素数量
+    static constexpr std::size_t kGatherGrain = 256;
+    static constexpr std::size_t kPairGrain = 1024;
+
+    // 跟踪以待回收的已发布空间索引快照数量上限
+    static constexpr std::size_t kMaxTrackedSpatialIndices = 4;
+
+    std::unique_ptr<WorkStealingPool> pool;  ///< 宽阶段、窄阶段共用的工作线程池
+    SweepAndPrune broadphase;
+    RigidBodySolver solver;
+    SolverSettings settings;
+
+    float accumulator = 0.0f;       ///< 尚未模拟的累积时间（秒）
+    std::uint64_t step_count = 0;   ///< 已完成的固定步数量，写入 ModelTransform::physics_step
+
+    std::vector<std::uintptr_t> mechanics_handles;        ///< MechanicsStorage 活动句柄快照
+    std::uint64_t handles_version = ~std::uint64_t{0};    ///< 快照对应的句柄列表版本
+
+    std::vector<Body> bodies;               ///< 本帧参与模拟的物体
+    std::vector<std::uint8_t> body_valid;   ///< 收集阶段各句柄是否成功读取
+    AabbSoA bounds;                         ///< 与 bodies 对应的世界空间包围盒
+    AabbSoA swept_bounds;                   ///< 连续物体沿本步位移扩展后的包围盒，供宽阶段使用
+    std::vector<BroadphasePair> pairs;      ///< 宽阶段输出的候选对
+    std::vector<RigidBody> rigid_bodies;    ///< 与 bodies 对应的刚体状态
+    std::vector<std::uintptr_t> body_keys;  ///< 与 bodies 对应的 MechanicsDevice 句柄，用于匹配缓存冲量
+
+    IslandBuilder islands;                   ///< 按接触关系划分的岛
+    std::vector<std::uint8_t> body_dynamic;  ///< 与 bodies 对应，是否为动态物体
+    std::vector<std::uint8_t> island_awake;  ///< 与岛对应，本步是否参与求解
+
+    std::vector<PhysicsPoseSnapshot::Pose> written_poses;  ///< 与 bodies 对应，本步写回的变换位姿
+    std::vector<std::uint8_t> pose_written;                ///< 与 bodies 对应，本步是否写回了变换
+
+    std::vector<std::shared_ptr<SpatialIndex>> published_indices;  ///< 已发布的空间索引快照，不再被其他线程引用后回收其缓冲区
+};
+
+}  // namespace Corona::Systems
@@ -0,0 +1,660 @@
+#include "rigid_body_solver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include <corona/job_pool.h>
+
+namespace Corona::Systems {
+
+namespace {
+
+inline ktm::fvec3 make_vec3(float x, float y, float z) {
+    ktm::fvec3 v;
+    v.x = x;
+    v.y = y;
+    v.z = z;
+    return v;
+}
+
+inline float axis_value(const ktm::fvec3& v, int axis) {
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+inline ktm::fvec3 axis_vector(int axis, float length) {
+    return make_vec3(axis == 0 ? length : 0.0f, axis == 1 ? length : 0.0f, axis == 2 ? length : 0.0f);
+}
+
+inline ktm::fvec3 multiply(const Basis3& m, const ktm::fvec3& v) {
+    return make_vec3(ktm::dot(m.row0, v), ktm::dot(m.row1, v), ktm::dot(m.row2, v));
+}
+
+inline Basis3 transpose(const Basis3& m) {
+    return {make_vec3(m.row0.x, m.row1.x, m.row2.x),
+            make_vec3(m.row0.y, m.row1.y, m.row2.y),
+            make_vec3(m.row0.z, m.row1.z, m.row2.z)};
+}
+
+// R * diag(d) * R^T
+inline Basis3 rotate_diagonal(const Basis3& r, const ktm::fvec3& d) {
+    const Basis3 rt = transpose(r);
+    const ktm::fvec3 c0 = rt.row0 * d.x;
+    const ktm::fvec3 c1 = rt.row1 * d.y;
+    const ktm::fvec3 c2 = rt.row2 * d.z;
+    // 结果的第 i 行第 j 列 = sum_k r[i][k] * d[k] * r[j][k]
+    const auto entry = [&](const ktm::fvec3& ri, int j) {
+        return ri.x * axis_value(c0, j) + ri.y * axis_value(c1, j) + ri.z * axis_value(c2, j);
+    };
+    return {make_vec3(entry(r.row0, 0), entry(r.row0, 1), entry(r.row0, 2)),
+            make_vec3(entry(r.row1, 0), entry(r.row1, 1), entry(r.row1, 2)),
+            make_vec3(entry(r.row2, 0), entry(r.row2, 1), entry(r.row2, 2))};
+}
+
+inline float length_squared(const ktm::fvec3& v) {
+    return ktm::dot(v, v);
+}
+
+// 施密特正交化，抵消积分带来的误差
+Basis3 orthonormalize(const Basis3& m) {
+    ktm::fvec3 x = m.row0 * (1.0f / std::sqrt(length_squared(m.row0)));
+    ktm::fvec3 y = m.row1 - x * ktm::dot(x, m.row1);
+    y = y * (1.0f / std::sqrt(length_squared(y)));
+    const ktm::fvec3 z = ktm::cross(x, y);
+    return {x, y, z};
+}
+
+}  // namespace
+
+Basis3 basis_from_euler(const ktm::fvec3& euler) {
+    const float cx = std::cos(euler.x);
+    const float sx = std::sin(euler.x);
+    const float cy = std::cos(euler.y);
+    const float sy = std::sin(euler.y);
+    const float cz = std::cos(euler.z);
+    const float sz = std::sin(euler.z);
+
+    return {make_vec3(cy * cz, cz * sy * sx - sz * cx, cz * sy * cx + sz * sx),
+            make_vec3(cy * sz, sz * sy * sx + cz * cx, sz * sy * cx - cz * sx),
+            make_vec3(-sy, cy * sx, cy * cx)};
+}
+
+ktm::fvec3 euler_from_basis(const Basis3& basis) {
+    const float sy = std::clamp(-basis.row2.x, -1.0f, 1.0f);
+    const float y = std::asin(sy);
+
+    // 万向节锁附近 x 与 z 无法区分，令 x = 0
+    if (std::fabs(sy) > 0.9999f) {
+        return make_vec3(0.0f, y, std::atan2(-basis.row0.y, basis.row1.y));
+    }
+    return make_vec3(std::atan2(basis.row2.y, basis.row2.z), y, std::atan2(basis.row1.x, basis.row0.x));
+}
+
+void set_box_mass(RigidBody& body, float mass, const ktm::fvec3& half_extents) {
+    if (mass <= 0.0f) {
+        body.inv_mass = 0.0f;
+        body.inv_inertia_local = make_vec3(0.0f, 0.0f, 0.0f);
+        body.inv_inertia_world = {body.inv_inertia_local, body.inv_inertia_local, body.inv_inertia_local};
+        return;
+    }
+
+    const float xx = half_extents.x * half_extents.x;
+    const float yy = half_extents.y * half_extents.y;
+    const float zz = half_extents.z * half_extents.z;
+
+    // 实心长方体：I = m / 3 * (b^2 + c^2)，其中 b、c 为半尺寸
+    const auto inverse = [mass](float sum) {
+        const float inertia = mass / 3.0f * sum;
+        return inertia > 1e-12f ? 1.0f / inertia : 0.0f;
+    };
+
+    body.inv_mass = 1.0f / mass;
+    body.inv_inertia_local = make_vec3(inverse(yy + zz), inverse(xx + zz), inverse(xx + yy));
+    body.inv_inertia_world = rotate_diagonal(body.rotation, body.inv_inertia_local);
+}
+
+void expand_swept_bounds(const std::vector<RigidBody>& bodies, const AabbSoA& bounds, AabbSoA& swept,
+                         const SolverSettings& settings) {
+    const float dt = settings.time_step;
+    swept = bounds;
+    for (std::size_t i = 0; i < bodies.size(); ++i) {
+        const auto& body = bodies[i];
+        if (!body.continuous || body.inv_mass == 0.0f || body.sleeping) {
+            continue;
+        }
+
+        // 按积分外力后的速度预测本步位移
+        const ktm::fvec3 velocity = body.linear_velocity + settings.gravity * (body.gravity_scale * dt);
+        const ktm::fvec3 displacement = velocity * dt;
+        swept.min_x[i] += std::min(displacement.x, 0.0f);
+        swept.min_y[i] += std::min(displacement.y, 0.0f);
+        swept.min_z[i] += std::min(displacement.z, 0.0f);
+        swept.max_x[i] += std::max(displacement.x, 0.0f);
+        swept.max_y[i] += std::max(displacement.y, 0.0f);
+        swept.max_z[i] += std::max(displacement.z, 0.0f);
+    }
+}
+
+void RigidBodySolver::reset() {
+    manifolds_.clear();
+    cache_.clear();
+    next_cache_.clear();
+    stats_ = {};
+}
+
+void RigidBodySolver::step(std::vector<RigidBody>& bodies, const std::vector<std::uintptr_t>& keys,
+                           const AabbSoA& bounds, const std::vector<BroadphasePair>& pairs,
+                           const IslandBuilder& islands, const std::vector<std::uint8_t>& island_awake,
+                           const SolverSettings& settings, WorkStealingPool* pool) {
+    const float dt = settings.time_step;
+    stats_ = {};
+
+    const auto run = [pool](std::size_t count, std::size_t grain, const WorkStealingPool::RangeFn& fn) {
+        if (pool) {
+            pool->parallel_for(count, grain, fn);
+        } else {
+            fn(JobRange{0, 0, count, 0});
+        }
+    };
+
+    const auto body_awake = [&](std::size_t body) {
+        const std::uint32_t island = islands.island_of(body);
+        return island != IslandBuilder::kNoIsland && island_awake[island] != 0;
+    };
+
+    // 1. 积分外力（重力）与阻尼，休眠物体跳过
+    const float linear_damping = 1.0f / (1.0f + dt * settings.linear_damping);
+    const float angular_damping = 1.0f / (1.0f + dt * settings.angular_damping);
+    run(bodies.size(), kBodyGrain, [&](const JobRange& range) {
+        for (std::size_t i = range.begin; i < range.end; ++i) {
+            auto& body = bodies[i];
+            if (body.inv_mass == 0.0f || !body_awake(i)) {
+                continue;
+            }
+            body.linear_velocity += settings.gravity * (body.gravity_scale * dt);
+            body.linear_velocity = body.linear_velocity * linear_damping;
+            body.angular_velocity = body.angular_velocity * angular_damping;
+        }
+    });
+
+    // 2. 构建活动岛的接触流形并预计算有效质量，按碰撞对下标写入
+    manifolds_.resize(pairs.size());
+    run(pairs.size(), kManifoldGrain, [&](const JobRange& range) {
+        for (std::size_t p = range.begin; p < range.end; ++p) {
+            if (!body_awake(pairs[p].a) && !body_awake(pairs[p].b)) {
+                manifolds_[p].point_count = 0;
+                continue;
+            }
+            build_manifold(p, bodies, keys, bounds, pairs[p], settings);
+        }
+    });
+
+    // 3. 各活动岛独立求解：热启动、迭代、积分位置与休眠判定
+    run(islands.island_count(), kIslandGrain, [&](const JobRange& range) {
+        for (std::size_t island = range.begin; island < range.end; ++island) {
+            if (island_awake[island]) {
+                solve_island(bodies, bounds, pairs, islands, island, settings);
+            }
+        }
+    });
+
+    // 4. 统计
+    stats_.island_count = islands.island_count();
+    for (std::size_t island = 0; island < islands.island_count(); ++island) {
+        if (island_awake[island]) {
+            ++stats_.active_islands;
+        }
+    }
+    for (std::size_t i = 0; i < bodies.size(); ++i) {
+        if (bodies[i].inv_mass == 0.0f) {
+            continue;
+        }
+        if (bodies[i].sleeping) {
+            ++stats_.sleeping_bodies;
+        } else {
+            ++stats_.active_bodies;
+            if (bodies[i].continuous) {
+                ++stats_.ccd_bodies;
+            }
+        }
+    }
+    for (const auto& manifold : manifolds_) {
+        if (manifold.point_count == 0) {
+            continue;
+        }
+        ++stats_.manifold_count;
+        stats_.contact_count += static_cast<std::size_t>(manifold.point_count);
+        if (manifold.warm_started) {
+            stats_.warm_started += static_cast<std::size_t>(manifold.point_count);
+        }
+    }
+
+    // 5. 保存本步冲量，供下一步热启动
+    store_impulses(keys, pairs, islands, island_awake);
+}
+
+void RigidBodySolver::solve_island(std::vector<RigidBody>& bodies, const AabbSoA& bounds,
+                                   const std::vector<BroadphasePair>& pairs, const IslandBuilder& islands,
+                                   std::size_t island, const SolverSettings& settings) {
+    const float dt = settings.time_step;
+    const auto island_pairs = islands.pairs(island);
+    const auto island_bodies = islands.bodies(island);
+
+    // 热启动：先施加上一步的累计冲量
+    for (const std::uint32_t p : island_pairs) {
+        const auto& manifold = manifolds_[p];
+        if (!manifold.warm_started) {
+            continue;
+        }
+        for (int i = 0; i < manifold.point_count; ++i) {
+            const auto& point = manifold.points[i];
+            const ktm::fvec3 impulse = manifold.normal * point.normal_impulse +
+                                       manifold.tangent[0] * point.tangent_impulse[0] +
+                                       manifold.tangent[1] * point.tangent_impulse[1];
+            apply_impulse(bodies[manifold.a], bodies[manifold.b], point, impulse);
+        }
+    }
+
+    // 顺序冲量迭代（Gauss-Seidel），岛内按碰撞对顺序执行以保证结果确定
+    for (int iteration = 0; iteration < settings.velocity_iterations; ++iteration) {
+        for (const std::uint32_t p : island_pairs) {
+            auto& manifold = manifolds_[p];
+            if (manifold.point_count != 0) {
+                solve_manifold(bodies, manifold);
+            }
+        }
+    }
+
+    // 积分位置与姿态
+    bool has_continuous = false;
+    for (const std::uint32_t index : island_bodies) {
+        auto& body = bodies[index];
+        body.rotated = false;
+        if (body.inv_mass == 0.0f) {
+            continue;  // 唤醒失败的物体本步按静态处理
+        }
+        body.sleeping = false;
+
+        body.center += body.linear_velocity * dt;
+
+        if (length_squared(body.angular_velocity) > 1e-12f) {
+            // dR/dt = [w]x R
+            const ktm::fvec3& w = body.angular_velocity;
+            const Basis3& r = body.rotation;
+            const Basis3 wr = {ktm::cross(w, make_vec3(r.row0.x, r.row1.x, r.row2.x)),
+                               ktm::cross(w, make_vec3(r.row0.y, r.row1.y, r.row2.y)),
+                               ktm::cross(w, make_vec3(r.row0.z, r.row1.z, r.row2.z))};
+            // wr 按列存放，转置后与 r 逐行相加
+            const Basis3 delta = transpose(wr);
+            body.rotation = orthonormalize({r.row0 + delta.row0 * dt, r.row1 + delta.row1 * dt, r.row2 + delta.row2 * dt});
+            body.euler_rotation = euler_from_basis(body.rotation);
+            body.inv_inertia_world = rotate_diagonal(body.rotation, body.inv_inertia_local);
+            body.rotated = true;
+        }
+        has_continuous = has_continuous || body.continuous;
+    }
+
+    // 连续碰撞检测：岛内全部物体积分完成后再扫掠，结果与岛内遍历顺序无关
+    if (has_continuous) {
+        for (const std::uint32_t index : island_bodies) {
+            if (bodies[index].continuous && bodies[index].inv_mass != 0.0f) {
+                resolve_continuous(bodies, bounds, pairs, island_pairs, index, settings);
+            }
+        }
+    }
+
+    // 记录岛内最短的静止时间
+    const float linear_threshold = settings.sleep_linear_threshold * settings.sleep_linear_threshold;
+    const float angular_threshold = settings.sleep_angular_threshold * settings.sleep_angular_threshold;
+    float min_sleep_timer = settings.time_to_sleep;
+
+    for (const std::uint32_t index : island_bodies) {
+        auto& body = bodies[index];
+        if (body.inv_mass == 0.0f) {
+            continue;
+        }
+        if (length_squared(body.linear_velocity) > linear_threshold ||
+            length_squared(body.angular_velocity) > angular_threshold) {
+            body.sleep_timer = 0.0f;
+        } else {
+            body.sleep_timer += dt;
+        }
+        min_sleep_timer = std::min(min_sleep_timer, body.sleep_timer);
+    }
+
+    // 岛内所有物体都静止足够久时整体休眠，速度清零
+    if (min_sleep_timer >= settings.time_to_sleep) {
+        for (const std::uint32_t index : island_bodies) {
+            auto& body = bodies[index];
+            if (body.inv_mass == 0.0f) {
+                continue;
+            }
+            body.sleeping = true;
+            body.linear_velocity = make_vec3(0.0f, 0.0f, 0.0f);
+            body.angular_velocity = make_vec3(0.0f, 0.0f, 0.0f);
+        }
+    }
+}
+
+void RigidBodySolver::resolve_continuous(std::vector<RigidBody>& bodies, const AabbSoA& bounds,
+                                         const std::vector<BroadphasePair>& pairs,
+                                         std::span<const std::uint32_t> island_pairs, std::uint32_t index,
+                                         const SolverSettings& settings) {
+    const auto start_center = [&bounds](std::uint32_t i) {
+        return make_vec3((bounds.min_x[i] + bounds.max_x[i]) * 0.5f, (bounds.min_y[i] + bounds.max_y[i]) * 0.5f,
+                         (bounds.min_z[i] + bounds.max_z[i]) * 0.5f);
+    };
+
+    auto& body = bodies[index];
+    const ktm::fvec3 start = start_center(index);
+    ktm::fvec3 displacement = body.center - start;
+
+    // 某轴上的位移不超过半个包围盒时，离散检测必然能发现该轴上的穿透，只扫掠可能穿透的轴
+    bool fast[3];
+    bool any_fast = false;
+    for (int axis = 0; axis < 3; ++axis) {
+        const float extent = bounds.max_axis(axis)[index] - bounds.min_axis(axis)[index];
+        fast[axis] = std::abs(axis_value(displacement, axis)) > extent * 0.5f;
+        any_fast = any_fast || fast[axis];
+    }
+    if (!any_fast) {
+        return;
+    }
+
+    // 每次处理最早的撞击：截断该轴上的位移后继续扫掠剩余位移，使切向运动得以保留
+    for (int pass = 0; pass < 3; ++pass) {
+        float toi = 1.0f;
+        int toi_axis = -1;
+        std::uint32_t toi_other = 0;
+        float toi_approach = 0.0f;
+
+        for (const std::uint32_t p : island_pairs) {
+            const auto& pair = pairs[p];
+            if (pair.a != index && pair.b != index) {
+                continue;
+            }
+            const std::uint32_t other = pair.a == index ? pair.b : pair.a;
+
+            // 对方为动态物体时使用相对位移
+            ktm::fvec3 relative = displacement;
+            if (bodies[other].inv_mass != 0.0f) {
+                relative = relative - (bodies[other].center - start_center(other));
+            }
+
+            // 扫掠包围盒：各轴进入/离开时刻的交集
+            float t_enter = 0.0f;
+            float t_exit = 1.0f;
+            int enter_axis = -1;
+            bool hit = true;
+            for (int axis = 0; axis < 3 && hit; ++axis) {
+                const float a_min = bounds.min_axis(axis)[index];
+                const float a_max = bounds.max_axis(axis)[index];
+                const float b_min = bounds.min_axis(axis)[other];
+                const float b_max = bounds.max_axis(axis)[other];
+                const float d = axis_value(relative, axis);
+
+                float t0 = 0.0f;
+                float t1 = 1.0f;
+                if (a_max < b_min) {
+                    if (d <= 0.0f) {
+                        hit = false;
+                        break;
+                    }
+                    t0 = (b_min - a_max) / d;
+                    t1 = (b_max - a_min) / d;
+                } else if (b_max < a_min) {
+                    if (d >= 0.0f) {
+                        hit = false;
+                        break;
+                    }
+                    t0 = (b_max - a_min) / d;
+                    t1 = (b_min - a_max) / d;
+                } else if (d > 0.0f) {
+                    t1 = (b_max - a_min) / d;
+                } else if (d < 0.0f) {
+                    t1 = (b_min - a_max) / d;
+                }
+
+                if (t0 > t_enter) {
+                    t_enter = t0;
+                    enter_axis = axis;
+                }
+                t_exit = std::min(t_exit, t1);
+                hit = t_enter <= t_exit;
+            }
+
+            // 起始时刻已经重叠或从慢速轴进入的由离散接触处理
+            if (hit && enter_axis >= 0 && fast[enter_axis] && t_enter < toi) {
+                toi = t_enter;
+                toi_axis = enter_axis;
+                toi_other = other;
+                toi_approach = axis_value(relative, enter_axis);
+            }
+        }
+
+        if (toi_axis < 0) {
+            break;
+        }
+
+        // 该轴位移截断到撞击时刻，并保留一点间隙，避免下一步从内部开始
+        const float t = std::max(0.0f, toi - settings.ccd_skin / std::abs(toi_approach));
+        const float axis_displacement = axis_value(displacement, toi_axis);
+        displacement -= axis_vector(toi_axis, axis_displacement * (1.0f - t));
+        fast[toi_axis] = false;
+
+        // 去掉法向的接近速度，超过阈值时按恢复系数反弹
+        const auto& other = bodies[toi_other];
+        const float direction = toi_approach > 0.0f ? 1.0f : -1.0f;
+        const float other_velocity = other.inv_mass != 0.0f ? axis_value(other.linear_velocity, toi_axis) : 0.0f;
+        const float relative_velocity = (axis_value(body.linear_velocity, toi_axis) - other_velocity) * direction;
+        if (relative_velocity > 0.0f) {
+            const float restitution = std::max(body.restitution, other.restitution);
+            const float bounce =
+                relative_velocity > settings.restitution_threshold ? restitution * relative_velocity : 0.0f;
+            body.linear_velocity -= axis_vector(toi_axis, (relative_velocity + bounce) * direction);
+        }
+    }
+
+    body.center = start + displacement;
+}
+
+void RigidBodySolver::build_manifold(std::size_t index, const std::vector<RigidBody>& bodies,
+                                     const std::vector<std::uintptr_t>& keys, const AabbSoA& bounds,
+                                     const BroadphasePair& pair, const SolverSettings& settings) {
+    auto& manifold = manifolds_[index];
+    manifold.point_count = 0;
+    manifold.warm_started = false;
+
+    // 按句柄排序，使同一对物体在帧间的法线方向与缓存键保持一致
+    std::uint32_t a = pair.a;
+    std::uint32_t b = pair.b;
+    if (keys[a] > keys[b]) {
+        std::swap(a, b);
+    }
+
+    const RigidBody& body_a = bodies[a];
+    const RigidBody& body_b = bodies[b];
+    if (body_a.inv_mass == 0.0f && body_b.inv_mass == 0.0f) {
+        return;  // 两个静态物体之间无需求解
+    }
+
+    // 三轴上的重叠区间
+    float lo[3];
+    float hi[3];
+    float overlap[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        lo[axis] = std::max(bounds.min_axis(axis)[a], bounds.min_axis(axis)[b]);
+        hi[axis] = std::min(bounds.max_axis(axis)[a], bounds.max_axis(axis)[b]);
+        overlap[axis] = hi[axis] - lo[axis];
+    }
+    if (overlap[0] < 0.0f || overlap[1] < 0.0f || overlap[2] < 0.0f) {
+        return;
+    }
+
+    // 法线取穿透最浅的坐标轴
+    int axis = 0;
+    if (overlap[1] < overlap[axis]) {
+        axis = 1;
+    }
+    if (overlap[2] < overlap[axis]) {
+        axis = 2;
+    }
+
+    // 上一步的法线轴仍接近最浅时沿用，避免法线在两轴间来回切换
+    const auto cached = cache_.find(ContactKey{keys[a], keys[b]});
+    if (cached != cache_.end() && cached->second.axis != axis &&
+        overlap[cached->second.axis] <= overlap[axis] * 1.1f + settings.penetration_slop) {
+        axis = cached->second.axis;
+    }
+
+    const float center_a = axis_value(body_a.center, axis);
+    const float center_b = axis_value(body_b.center, axis);
+    const float sign = center_b >= center_a ? 1.0f : -1.0f;
+
+    const int u = (axis + 1) % 3;
+    const int v = (axis + 2) % 3;
+
+    manifold.a = a;
+    manifold.b = b;
+    manifold.axis = axis;
+    manifold.normal = axis_vector(axis, sign);
+    manifold.tangent[0] = axis_vector(u, 1.0f);
+    manifold.tangent[1] = axis_vector(v, 1.0f);
+    manifold.friction = std::sqrt(body_a.friction * body_b.friction);
+    const float restitution = std::max(body_a.restitution, body_b.restitution);
+
+    // 接触点取重叠区域在接触面上的四个角，顺序固定，便于与缓存逐点匹配
+    const float plane = (lo[axis] + hi[axis]) * 0.5f;
+    const float corner_u[kMaxManifoldPoints] = {lo[u], hi[u], hi[u], lo[u]};
+    const float corner_v[kMaxManifoldPoints] = {lo[v], lo[v], hi[v], hi[v]};
+
+    const bool warm = cached != cache_.end() && cached->second.axis == axis;
+    const float inv_dt = settings.time_step > 0.0f ? 1.0f / settings.time_step : 0.0f;
+
+    for (int i = 0; i < kMaxManifoldPoints; ++i) {
+        float coords[3];
+        coords[axis] = plane;
+        coords[u] = corner_u[i];
+        coords[v] = corner_v[i];
+        const ktm::fvec3 position = make_vec3(coords[0], coords[1], coords[2]);
+
+        auto& point = manifold.points[i];
+        point.r_a = position - body_a.center;
+        point.r_b = position - body_b.center;
+        point.penetration = overlap[axis];
+
+        const auto effective_mass = [&](const ktm::fvec3& direction) {
+            const ktm::fvec3 ra_n = ktm::cross(point.r_a, direction);
+            const ktm::fvec3 rb_n = ktm::cross(point.r_b, direction);
+            const float k = body_a.inv_mass + body_b.inv_mass +
+                            ktm::dot(ra_n, multiply(body_a.inv_inertia_world, ra_n)) +
+                            ktm::dot(rb_n, multiply(body_b.inv_inertia_world, rb_n));
+            return k > 0.0f ? 1.0f / k : 0.0f;
+        };
+        point.normal_mass = effective_mass(manifold.normal);
+        point.tangent_mass[0] = effective_mass(manifold.tangent[0]);
+        point.tangent_mass[1] = effective_mass(manifold.tangent[1]);
+
+        // 速度偏置：穿透修正与反弹取较大者
+        const ktm::fvec3 relative = body_b.linear_velocity + ktm::cross(body_b.angular_velocity, point.r_b) -
+                                    body_a.linear_velocity - ktm::cross(body_a.angular_velocity, point.r_a);
+        const float approach = ktm::dot(relative, manifold.normal);
+        const float position_bias = settings.baumgarte * inv_dt * std::max(0.0f, point.penetration - settings.penetration_slop);
+        const float bounce_bias = approach < -settings.restitution_threshold ? -restitution * approach : 0.0f;
+        point.bias = std::max(position_bias, bounce_bias);
+
+        if (warm) {
+            point.normal_impulse = cached->second.normal_impulse[i];
+            point.tangent_impulse[0] = cached->second.tangent_impulse[i][0];
+            point.tangent_impulse[1] = cached->second.tangent_impulse[i][1];
+        } else {
+            point.normal_impulse = 0.0f;
+            point.tangent_impulse[0] = 0.0f;
+            point.tangent_impulse[1] = 0.0f;
+        }
+    }
+
+    manifold.point_count = kMaxManifoldPoints;
+    manifold.warm_started = warm;
+}
+
+void RigidBodySolver::apply_impulse(RigidBody& a, RigidBody& b, const ContactPoint& point, const ktm::fvec3& impulse) {
+    // 静态物体可能同时出现在多个岛中，不能写入
+    if (a.inv_mass != 0.0f) {
+        a.linear_velocity -= impulse * a.inv_mass;
+        a.angular_velocity -= multiply(a.inv_inertia_world, ktm::cross(point.r_a, impulse));
+    }
+    if (b.inv_mass != 0.0f) {
+        b.linear_velocity += impulse * b.inv_mass;
+        b.angular_velocity += multiply(b.inv_inertia_world, ktm::cross(point.r_b, impulse));
+    }
+}
+
+void RigidBodySolver::solve_manifold(std::vector<RigidBody>& bodies, ContactManifold& manifold) {
+    RigidBody& a = bodies[manifold.a];
+    RigidBody& b = bodies[manifold.b];
+
+    const auto relative_velocity = [&](const ContactPoint& point) {
+        return b.linear_velocity + ktm::cross(b.angular_velocity, point.r_b) -
+               a.linear_velocity - ktm::cross(a.angular_velocity, point.r_a);
+    };
+
+    // 法向冲量：累计值不小于 0
+    for (int i = 0; i < manifold.point_count; ++i) {
+        auto& point = manifold.points[i];
+        const float vn = ktm::dot(relative_velocity(point), manifold.normal);
+        const float lambda = -point.normal_mass * (vn - point.bias);
+        const float previous = point.normal_impulse;
+        point.normal_impulse = std::max(previous + lambda, 0.0f);
+        apply_impulse(a, b, point, manifold.normal * (point.normal_impulse - previous));
+    }
+
+    // 摩擦冲量：累计值限制在摩擦锥（以两条切线近似）内
+    for (int i = 0; i < manifold.point_count; ++i) {
+        auto& point = manifold.points[i];
+        const float max_friction = manifold.friction * point.normal_impulse;
+        for (int t = 0; t < 2; ++t) {
+            const float vt = ktm::dot(relative_velocity(point), manifold.tangent[t]);
+            const float lambda = -point.tangent_mass[t] * vt;
+            const float previous = point.tangent_impulse[t];
+            point.tangent_impulse[t] = std::clamp(previous + lambda, -max_friction, max_friction);
+            apply_impulse(a, b, point, manifold.tangent[t] * (point.tangent_impulse[t] - previous));
+        }
+    }
+}
+
+void RigidBodySolver::store_impulses(const std::vector<std::uintptr_t>& keys, const std::vector<BroadphasePair>& pairs,
+                                     const IslandBuilder& islands, const std::vector<std::uint8_t>& island_awake) {
+    // 只保留本步仍然存在的接触，消失的物体对自然被淘汰；休眠岛沿用原有冲量，唤醒后继续热启动
+    next_cache_.clear();
+    for (std::size_t p = 0; p < pairs.size(); ++p) {
+        const auto& manifold = manifolds_[p];
+        if (manifold.point_count != 0) {
+            CachedManifold entry;
+            entry.axis = manifold.axis;
+            entry.point_count = manifold.point_count;
+            for (int i = 0; i < manifold.point_count; ++i) {
+                entry.normal_impulse[i] = manifold.points[i].normal_impulse;
+                entry.tangent_impulse[i][0] = manifold.points[i].tangent_impulse[0];
+                entry.tangent_impulse[i][1] = manifold.points[i].tangent_impulse[1];
+            }
+            next_cache_[ContactKey{keys[manifold.a], keys[manifold.b]}] = entry;
+            continue;
+        }
+
+        const std::uint32_t island = islands.island_of(pairs[p].a) != IslandBuilder::kNoIsland
+                                         ? islands.island_of(pairs[p].a)
+                                         : islands.island_of(pairs[p].b);
+        if (island == IslandBuilder::kNoIsland || island_awake[island]) {
+            continue;
+        }
+
+        const ContactKey key{std::min(keys[pairs[p].a], keys[pairs[p].b]), std::max(keys[pairs[p].a], keys[pairs[p].b])};
+        if (const auto cached = cache_.find(key); cached != cache_.end()) {
+            next_cache_.insert(*cached);
+        }
+    }
+    cache_.swap(next_cache_);
+}
+
+}  // namespace Corona::Systems
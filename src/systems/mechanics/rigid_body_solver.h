@@ -0,0 +1,218 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <ktm/ktm.h>
+
+#include "aabb_soa.h"
+#include "broadphase.h"
+#include "island_builder.h"
+
+namespace Corona::Systems {
+
+/**
+ * @brief 3x3 矩阵（按行存放），用于旋转与惯量张量
+ */
+struct Basis3 {
+    ktm::fvec3 row0;
+    ktm::fvec3 row1;
+    ktm::fvec3 row2;
+};
+
+/**
+ * @brief 由欧拉角构造旋转矩阵，顺序与 ModelTransform::compute_matrix 一致（Z * Y * X）
+ */
+[[nodiscard]] Basis3 basis_from_euler(const ktm::fvec3& euler);
+
+/**
+ * @brief 从旋转矩阵还原欧拉角（basis_from_euler 的逆运算）
+ */
+[[nodiscard]] ktm::fvec3 euler_from_basis(const Basis3& basis);
+
+/**
+ * @brief 求解器使用的刚体状态
+ *
+ * 每步由力学系统从 MechanicsDevice 与 ModelTransform 收集，求解后再写回。
+ * 质量倒数为 0 的物体视为静态，不受重力与冲量影响。
+ */
+struct RigidBody {
+    ktm::fvec3 center;            ///< 质心世界位置（取世界包围盒中心）
+    ktm::fvec3 center_offset;     ///< 质心相对变换原点的偏移（已缩放、未旋转）
+    ktm::fvec3 euler_rotation;    ///< 变换的欧拉角
+    Basis3 rotation;              ///< 与 euler_rotation 对应的旋转矩阵
+    ktm::fvec3 linear_velocity;
+    ktm::fvec3 angular_velocity;
+    ktm::fvec3 inv_inertia_local;  ///< 主轴惯量的倒数（盒体近似）
+    Basis3 inv_inertia_world;      ///< 世界空间惯量张量的逆
+    float inv_mass = 0.0f;
+    float restitution = 0.0f;
+    float friction = 0.0f;
+    float gravity_scale = 1.0f;
+    float sleep_timer = 0.0f;   ///< 速度持续低于休眠阈值的时间（秒）
+    bool sleeping = false;      ///< 本步结束时是否处于休眠
+    bool was_sleeping = false;  ///< 本步开始时是否处于休眠，休眠且未被唤醒的物体不写回
+    bool rotated = false;       ///< 本步姿态是否改变，未改变时不写回欧拉角
+    bool continuous = false;    ///< 启用连续碰撞检测
+};
+
+/**
+ * @brief 由质量、盒体半尺寸初始化刚体的质量属性
+ * @param mass 质量，小于等于 0 时为静态物体
+ * @param half_extents 盒体半尺寸（已缩放）
+ */
+void set_box_mass(RigidBody& body, float mass, const ktm::fvec3& half_extents);
+
+/**
+ * @brief 求解器参数
+ */
+struct SolverSettings {
+    ktm::fvec3 gravity{0.0f, -9.81f, 0.0f};
+    float time_step = 1.0f / 60.0f;     ///< 固定步长（秒）
+    int velocity_iterations = 10;       ///< 顺序冲量迭代次数
+    float baumgarte = 0.2f;             ///< 穿透修正系数
+    float penetration_slop = 0.005f;    ///< 允许的穿透深度，避免接触抖动
+    float restitution_threshold = 1.0f; ///< 低于该接近速度不产生反弹
+    float linear_damping = 0.01f;
+    float angular_damping = 0.05f;
+    float sleep_linear_threshold = 0.05f;   ///< 休眠线速度阈值（米/秒）
+    float sleep_angular_threshold = 0.05f;  ///< 休眠角速度阈值（弧度/秒）
+    float time_to_sleep = 0.5f;             ///< 岛内所有物体持续低于阈值多久后休眠（秒）
+    float ccd_skin = 0.001f;                ///< 连续碰撞检测回退后与障碍物保留的间隙（米）
+};
+
+/**
+ * @brief 将连续物体的包围盒沿本步预测位移扩展，供宽阶段生成扫掠候选对
+ * @param bodies 刚体状态（积分外力前）
+ * @param bounds 本步开始时的世界包围盒
+ * @param swept 输出，非连续物体与 bounds 相同
+ * @param settings 求解器参数
+ */
+void expand_swept_bounds(const std::vector<RigidBody>& bodies, const AabbSoA& bounds, AabbSoA& swept,
+                         const SolverSettings& settings);
+
+/**
+ * @brief 一步求解的统计信息
+ */
+struct SolverStats {
+    std::size_t manifold_count = 0;
+    std::size_t contact_count = 0;
+    std::size_t warm_started = 0;  ///< 命中上一步缓存冲量的接触点数量
+    std::size_t island_count = 0;
+    std::size_t active_islands = 0;
+    std::size_t active_bodies = 0;    ///< 本步参与求解的动态物体
+    std::size_t sleeping_bodies = 0;  ///< 本步结束时处于休眠的动态物体
+    std::size_t ccd_bodies = 0;       ///< 参与连续碰撞检测的动态物体
+};
+
+/**
+ * @brief 顺序冲量（Sequential Impulse）刚体求解器
+ *
+ * 以世界包围盒的重叠区域生成最多 4 个接触点的接触流形，
+ * 接触冲量按物体句柄对缓存并用于下一步的热启动，使堆叠能够稳定下来。
+ * 求解以岛为单位：各岛互不影响，可并行求解；岛内按碰撞对顺序串行迭代，结果与线程数量无关。
+ * 休眠的岛跳过积分与求解，其缓存冲量保留到被唤醒时继续使用。
+ * 标记为连续的物体在积分后沿位移做扫掠包围盒检测，命中时回退到撞击时刻并去掉法向速度，
+ * 其候选对需由调用方用 expand_swept_bounds 扩展后的包围盒生成。
+ */
+class RigidBodySolver {
+   public:
+    /**
+     * @brief 推进一个固定步长
+     * @param bodies 刚体状态，原地更新速度与位置
+     * @param keys 与 bodies 对应的稳定标识（MechanicsDevice 句柄），用于匹配缓存冲量
+     * @param bounds 与 bodies 对应的世界空间包围盒
+     * @param pairs 宽阶段输出的候选对
+     * @param islands 由 pairs 划分得到的岛
+     * @param island_awake 各岛是否需要求解（非 0 为活动）
+     * @param settings 求解器参数
+     * @param pool 可选的工作线程池
+     */
+    void step(std::vector<RigidBody>& bodies, const std::vector<std::uintptr_t>& keys, const AabbSoA& bounds,
+              const std::vector<BroadphasePair>& pairs, const IslandBuilder& islands,
+              const std::vector<std::uint8_t>& island_awake, const SolverSettings& settings,
+              WorkStealingPool* pool = nullptr);
+
+    /**
+     * @brief 清空缓存冲量
+     */
+    void reset();
+
+    [[nodiscard]] const SolverStats& stats() const {
+        return stats_;
+    }
+
+   private:
+    static constexpr int kMaxManifoldPoints = 4;
+    static constexpr std::size_t kManifoldGrain = 512;
+    static constexpr std::size_t kBodyGrain = 1024;
+    static constexpr std::size_t kIslandGrain = 16;
+
+    struct ContactPoint {
+        ktm::fvec3 r_a;  ///< 接触点相对 a 质心
+        ktm::fvec3 r_b;  ///< 接触点相对 b 质心
+        float penetration = 0.0f;
+        float normal_mass = 0.0f;
+        float tangent_mass[2] = {0.0f, 0.0f};
+        float bias = 0.0f;
+        float normal_impulse = 0.0f;
+        float tangent_impulse[2] = {0.0f, 0.0f};
+    };
+
+    struct ContactManifold {
+        std::uint32_t a = 0;
+        std::uint32_t b = 0;
+        int axis = 0;  ///< 法线所在坐标轴
+        ktm::fvec3 normal;  ///< 由 a 指向 b
+        ktm::fvec3 tangent[2];
+        float friction = 0.0f;
+        int point_count = 0;
+        bool warm_started = false;
+        ContactPoint points[kMaxManifoldPoints];
+    };
+
+    struct ContactKey {
+        std::uintptr_t a;
+        std::uintptr_t b;
+
+        bool operator==(const ContactKey&) const = default;
+    };
+
+    struct ContactKeyHash {
+        std::size_t operator()(const ContactKey& key) const {
+            const std::size_t ha = std::hash<std::uintptr_t>{}(key.a);
+            const std::size_t hb = std::hash<std::uintptr_t>{}(key.b);
+            return ha ^ (hb + 0x9e3779b97f4a7c15ULL + (ha << 6) + (ha >> 2));
+        }
+    };
+
+    struct CachedManifold {
+        int axis = 0;
+        int point_count = 0;
+        float normal_impulse[kMaxManifoldPoints] = {};
+        float tangent_impulse[kMaxManifoldPoints][2] = {};
+    };
+
+    void build_manifold(std::size_t index, const std::vector<RigidBody>& bodies,
+                        const std::vector<std::uintptr_t>& keys, const AabbSoA& bounds,
+                        const BroadphasePair& pair, const SolverSettings& settings);
+    static void apply_impulse(RigidBody& a, RigidBody& b, const ContactPoint& point, const ktm::fvec3& impulse);
+    void solve_manifold(std::vector<RigidBody>& bodies, ContactManifold& manifold);
+    void solve_island(std::vector<RigidBody>& bodies, const AabbSoA& bounds, const std::vector<BroadphasePair>& pairs,
+                      const IslandBuilder& islands, std::size_t island, const SolverSettings& settings);
+    static void resolve_continuous(std::vector<RigidBody>& bodies, const AabbSoA& bounds,
+                                   const std::vector<BroadphasePair>& pairs, std::span<const std::uint32_t> island_pairs,
+                                   std::uint32_t index, const SolverSettings& settings);
+    void store_impulses(const std::vector<std::uintptr_t>& keys, const std::vector<BroadphasePair>& pairs,
+                        const IslandBuilder& islands, const std::vector<std::uint8_t>& island_awake);
+
+    std::vector<ContactManifold> manifolds_;
+    std::unordered_map<ContactKey, CachedManifold, ContactKeyHash> cache_;
+    std::unordered_map<ContactKey, CachedManifold, ContactKeyHash> next_cache_;
+    SolverStats stats_;
+};
+
+}  // namespace Corona::Systems
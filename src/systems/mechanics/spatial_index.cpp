@@ -0,0 +1,339 @@
+#include <corona/systems/mechanics/spatial_index.h>
+
+#include <corona/frame_arena.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory_resource>
+
+namespace Corona::Systems {
+
+namespace {
+
+inline float axis_value(const ktm::fvec3& v, int axis) {
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+inline void set_axis(ktm::fvec3& v, int axis, float value) {
+    if (axis == 0) {
+        v.x = value;
+    } else if (axis == 1) {
+        v.y = value;
+    } else {
+        v.z = value;
+    }
+}
+
+inline bool box_overlap(const ktm::fvec3& a_min, const ktm::fvec3& a_max, const ktm::fvec3& b_min, const ktm::fvec3& b_max) {
+    return a_min.x <= b_max.x && b_min.x <= a_max.x &&
+           a_min.y <= b_max.y && b_min.y <= a_max.y &&
+           a_min.z <= b_max.z && b_min.z <= a_max.z;
+}
+
+inline bool sphere_overlap(const QuerySphere& sphere, const ktm::fvec3& box_min, const ktm::fvec3& box_max) {
+    // 球心到包围盒的最近距离
+    float distance_squared = 0.0f;
+    for (int axis = 0; axis < 3; ++axis) {
+        const float c = axis_value(sphere.center, axis);
+        const float lo = axis_value(box_min, axis);
+        const float hi = axis_value(box_max, axis);
+        const float d = c < lo ? lo - c : (c > hi ? c - hi : 0.0f);
+        distance_squared += d * d;
+    }
+    return distance_squared <= sphere.radius * sphere.radius;
+}
+
+/**
+ * @brief 归一化后的射线，预先计算方向的倒数
+ */
+struct PreparedRay {
+    ktm::fvec3 origin;
+    ktm::fvec3 direction;
+    ktm::fvec3 inv_direction;
+    float max_distance;
+    bool valid;
+
+    explicit PreparedRay(const QueryRay& ray) {
+        origin = ray.origin;
+        const float length = ktm::length(ray.direction);
+        valid = length > 1e-12f && ray.max_distance > 0.0f;
+        const float scale = valid ? 1.0f / length : 0.0f;
+        direction.x = ray.direction.x * scale;
+        direction.y = ray.direction.y * scale;
+        direction.z = ray.direction.z * scale;
+        // 方向分量为 0 时倒数为 ±inf，板条测试仍然成立
+        inv_direction.x = 1.0f / direction.x;
+        inv_direction.y = 1.0f / direction.y;
+        inv_direction.z = 1.0f / direction.z;
+        max_distance = ray.max_distance;
+    }
+
+    /**
+     * @brief 板条法求射线进入包围盒的距离，未命中返回 false
+     */
+    bool intersect(const ktm::fvec3& box_min, const ktm::fvec3& box_max, float limit, float& t_enter, int& enter_axis) const {
+        float t_min = 0.0f;
+        float t_max = limit;
+        enter_axis = -1;
+        for (int axis = 0; axis < 3; ++axis) {
+            const float o = axis_value(origin, axis);
+            const float inv = axis_value(inv_direction, axis);
+            float t0 = (axis_value(box_min, axis) - o) * inv;
+            float t1 = (axis_value(box_max, axis) - o) * inv;
+            if (std::isnan(t0) || std::isnan(t1)) {
+                // 方向分量为 0 且起点恰好在板条边界上
+                if (o < axis_value(box_min, axis) || o > axis_value(box_max, axis)) {
+                    return false;
+                }
+                continue;
+            }
+            if (t0 > t1) {
+                std::swap(t0, t1);
+            }
+            if (t0 > t_min) {
+                t_min = t0;
+                enter_axis = axis;
+            }
+            t_max = std::min(t_max, t1);
+            if (t_min > t_max) {
+                return false;
+            }
+        }
+        t_enter = t_min;
+        return true;
+    }
+};
+
+}  // namespace
+
+SpatialIndex::SpatialIndex(std::vector<Entry> entries)
+    : entries_(std::move(entries)) {}
+
+std::vector<SpatialIndex::Entry> SpatialIndex::take_entries() {
+    std::vector<Entry> entries = std::move(entries_);
+    entries.clear();
+    entries_.clear();
+    nodes_.clear();
+    return entries;
+}
+
+void SpatialIndex::ensure_built() const {
+    std::call_once(built_, [this] {
+        nodes_.clear();
+        if (entries_.empty()) {
+            return;
+        }
+        nodes_.reserve(2 * (entries_.size() / kLeafSize + 1));
+        build_node(0, static_cast<std::uint32_t>(entries_.size()));
+    });
+}
+
+std::uint32_t SpatialIndex::build_node(std::uint32_t first, std::uint32_t count) const {
+    const auto index = static_cast<std::uint32_t>(nodes_.size());
+    nodes_.push_back({});
+
+    Node node{};
+    node.min = entries_[first].min;
+    node.max = entries_[first].max;
+    ktm::fvec3 centroid_min = (entries_[first].min + entries_[first].max) * 0.5f;
+    ktm::fvec3 centroid_max = centroid_min;
+    for (std::uint32_t i = first; i < first + count; ++i) {
+        const auto& entry = entries_[i];
+        const ktm::fvec3 centroid = (entry.min + entry.max) * 0.5f;
+        for (int axis = 0; axis < 3; ++axis) {
+            set_axis(node.min, axis, std::min(axis_value(node.min, axis), axis_value(entry.min, axis)));
+            set_axis(node.max, axis, std::max(axis_value(node.max, axis), axis_value(entry.max, axis)));
+            set_axis(centroid_min, axis, std::min(axis_value(centroid_min, axis), axis_value(centroid, axis)));
+            set_axis(centroid_max, axis, std::max(axis_value(centroid_max, axis), axis_value(centroid, axis)));
+        }
+    }
+
+    if (count <= kLeafSize) {
+        node.first = first;
+        node.count = count;
+        nodes_[index] = node;
+        return index;
+    }
+
+    // 沿质心分布最宽的轴按中位数划分
+    int split_axis = 0;
+    float widest = -1.0f;
+    for (int axis = 0; axis < 3; ++axis) {
+        const float width = axis_value(centroid_max, axis) - axis_value(centroid_min, axis);
+        if (width > widest) {
+            widest = width;
+            split_axis = axis;
+        }
+    }
+
+    const std::uint32_t half = count / 2;
+    std::nth_element(entries_.begin() + first, entries_.begin() + first + half, entries_.begin() + first + count,
+                     [split_axis](const Entry& lhs, const Entry& rhs) {
+                         return axis_value(lhs.min, split_axis) + axis_value(lhs.max, split_axis) <
+                                axis_value(rhs.min, split_axis) + axis_value(rhs.max, split_axis);
+                     });
+
+    build_node(first, half);  // 左子节点紧随当前节点
+    node.first = build_node(first + half, count - half);
+    node.count = 0;
+    nodes_[index] = node;
+    return index;
+}
+
+std::optional<RayHit> SpatialIndex::raycast(const QueryRay& ray) const {
+    RayHit hit;
+    raycast(std::span<const QueryRay>(&ray, 1), std::span<RayHit>(&hit, 1));
+    if (hit.body.mechanics_handle == 0) {
+        return std::nullopt;
+    }
+    return hit;
+}
+
+void SpatialIndex::raycast(std::span<const QueryRay> rays, std::span<RayHit> hits) const {
+    ensure_built();
+
+    // 遍历栈只在本次查询内使用，从当前线程的临时内存池分配
+    const FrameArenaScope scratch;
+    std::pmr::vector<std::uint32_t> stack(scratch.resource());
+    stack.reserve(64);
+
+    for (std::size_t r = 0; r < rays.size() && r < hits.size(); ++r) {
+        RayHit& hit = hits[r];
+        hit = RayHit{};
+
+        const PreparedRay ray(rays[r]);
+        if (!ray.valid || nodes_.empty()) {
+            continue;
+        }
+
+        float best = ray.max_distance;
+        int best_axis = -1;
+        const Entry* best_entry = nullptr;
+
+        float t_enter = 0.0f;
+        int enter_axis = -1;
+
+        stack.clear();
+        stack.push_back(0);
+        while (!stack.empty()) {
+            const Node& node = nodes_[stack.back()];
+            stack.pop_back();
+
+            if (!ray.intersect(node.min, node.max, best, t_enter, enter_axis)) {
+                continue;
+            }
+
+            if (node.count != 0) {
+                for (std::uint32_t i = node.first; i < node.first + node.count; ++i) {
+                    const auto& entry = entries_[i];
+                    if (ray.intersect(entry.min, entry.max, best, t_enter, enter_axis) &&
+                        (best_entry == nullptr || t_enter < best)) {
+                        best = t_enter;
+                        best_axis = enter_axis;
+                        best_entry = &entry;
+                    }
+                }
+                continue;
+            }
+
+            // 先访问较近的子节点，使较远子节点更容易被剪枝
+            const std::uint32_t left = static_cast<std::uint32_t>(&node - nodes_.data()) + 1;
+            const std::uint32_t right = node.first;
+            float t_left = 0.0f;
+            float t_right = 0.0f;
+            int unused = 0;
+            const bool hit_left = ray.intersect(nodes_[left].min, nodes_[left].max, best, t_left, unused);
+            const bool hit_right = ray.intersect(nodes_[right].min, nodes_[right].max, best, t_right, unused);
+            if (hit_left && hit_right) {
+                stack.push_back(t_left <= t_right ? right : left);
+                stack.push_back(t_left <= t_right ? left : right);
+            } else if (hit_left) {
+                stack.push_back(left);
+            } else if (hit_right) {
+                stack.push_back(right);
+            }
+        }
+
+        if (best_entry == nullptr) {
+            continue;
+        }
+
+        hit.body = best_entry->body;
+        hit.distance = best;
+        hit.point = ray.origin + ray.direction * best;
+        hit.normal.x = 0.0f;
+        hit.normal.y = 0.0f;
+        hit.normal.z = 0.0f;
+        if (best_axis >= 0) {
+            // 法线与射线方向相反；起点在包围盒内部时法线为零向量
+            set_axis(hit.normal, best_axis, axis_value(ray.direction, best_axis) > 0.0f ? -1.0f : 1.0f);
+        }
+    }
+}
+
+template <typename Overlaps>
+void SpatialIndex::collect(const Overlaps& overlaps, std::vector<QueryBody>& out) const {
+    if (nodes_.empty()) {
+        return;
+    }
+
+    std::uint32_t stack[64];
+    std::size_t top = 0;
+    stack[top++] = 0;
+    while (top != 0) {
+        const std::uint32_t index = stack[--top];
+        const Node& node = nodes_[index];
+        if (!overlaps(node.min, node.max)) {
+            continue;
+        }
+        if (node.count != 0) {
+            for (std::uint32_t i = node.first; i < node.first + node.count; ++i) {
+                if (overlaps(entries_[i].min, entries_[i].max)) {
+                    out.push_back(entries_[i].body);
+                }
+            }
+            continue;
+        }
+        stack[top++] = node.first;
+        stack[top++] = index + 1;
+    }
+}
+
+std::vector<QueryBody> SpatialIndex::overlap_sphere(const QuerySphere& sphere) const {
+    ensure_built();
+    std::vector<QueryBody> out;
+    collect([&sphere](const ktm::fvec3& lo, const ktm::fvec3& hi) { return sphere_overlap(sphere, lo, hi); }, out);
+    return out;
+}
+
+void SpatialIndex::overlap_sphere(std::span<const QuerySphere> spheres, OverlapResults& results) const {
+    ensure_built();
+    results.offsets.assign(1, 0);
+    results.bodies.clear();
+    for (const auto& sphere : spheres) {
+        collect([&sphere](const ktm::fvec3& lo, const ktm::fvec3& hi) { return sphere_overlap(sphere, lo, hi); },
+                results.bodies);
+        results.offsets.push_back(static_cast<std::uint32_t>(results.bodies.size()));
+    }
+}
+
+std::vector<QueryBody> SpatialIndex::overlap_box(const QueryBox& box) const {
+    ensure_built();
+    std::vector<QueryBody> out;
+    collect([&box](const ktm::fvec3& lo, const ktm::fvec3& hi) { return box_overlap(box.min, box.max, lo, hi); }, out);
+    return out;
+}
+
+void SpatialIndex::overlap_box(std::span<const QueryBox> boxes, OverlapResults& results) const {
+    ensure_built();
+    results.offsets.assign(1, 0);
+    results.bodies.clear();
+    for (const auto& box : boxes) {
+        collect([&box](const ktm::fvec3& lo, const ktm::fvec3& hi) { return box_overlap(box.min, box.max, lo, hi); },
+                results.bodies);
+        results.offsets.push_back(static_cast<std::uint32_t>(results.bodies.size()));
+    }
+}
+
+}  // namespace Corona::Systems
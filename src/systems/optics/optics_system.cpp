@@ -2,14 +2,17 @@
 #include <corona/kernel/core/i_logger.h>
 #include <corona/kernel/event/i_event_bus.h>
 #include <corona/kernel/event/i_event_stream.h>
+#include <corona/profiler.h>
 #include <corona/resource/resource_manager.h>
 #include <corona/shared_data_hub.h>
 #include <corona/systems/optics/optics_system.h>
 
+#include <chrono>
 #include <filesystem>
 
 #include "corona/resource/types/text.h"
 #include "hardware.h"
+#include "scene_traversal.h"
 
 #undef CORONA_ENABLE_VISION
 
@@ -22,6 +25,7 @@
 namespace {
 
 Corona::Resource::TResourceID load_shader(const std::filesystem::path& shader_path) {
+    CORONA_PROFILE_SCOPE("ResourceManager::import_sync");
     auto shader = Corona::Resource::ResourceManager::get_instance().import_sync(shader_path);
     return shader;
 }
@@ -37,7 +41,7 @@ vision::Device visionDevice = RHIContext::instance().create_device("cuda");
 namespace Corona::Systems {
 
 OpticsSystem::OpticsSystem() {
-    set_target_fps(120);
+    set_target_fps(kDefaultTargetFps);
 }
 OpticsSystem::~OpticsSystem() = default;
 
@@ -153,94 +157,91 @@ void OpticsSystem::update() {
 }
 
 void OpticsSystem::optics_pipeline(float frame_count) const {
+    CORONA_PROFILE_SCOPE("OpticsSystem::optics_pipeline");
     CFW_LOG_DEBUG("OpticsSystem: Rendering pipeline temporarily disabled - waiting for new Storage API");
 
-    // 遍历场景存储并使用 acquire_read 访问相关句柄
-    for (const auto& scene : SharedDataHub::instance().scene_storage()) {
-        for (auto vp_handle : scene.viewport_handles) {
-            if (auto viewport = SharedDataHub::instance().viewport_storage().acquire_read(vp_handle)) {
-                if (viewport->camera == 0) {
-                    continue;
-                }
-                if (auto camera = SharedDataHub::instance().camera_storage().acquire_read(viewport->camera)) {
-                    hardware_->uniformBufferObjects.eyePosition = camera->position;
-                    hardware_->uniformBufferObjects.eyeDir = camera->forward;
-                    hardware_->uniformBufferObjects.eyeViewMatrix = camera->compute_view_matrix();
-                    hardware_->uniformBufferObjects.eyeProjMatrix = camera->compute_projection_matrix();
-                    hardware_->gbufferUniformBufferObjects.viewProjMatrix = camera->compute_view_proj_matrix();
-                    hardware_->gbufferUniformBuffer.copyFromData(&hardware_->gbufferUniformBufferObjects, sizeof(hardware_->gbufferUniformBufferObjects));
-
-                    hardware_->rasterizerPipeline["gbufferPostion"] = hardware_->gbufferPostionImage;
-                    hardware_->rasterizerPipeline["gbufferBaseColor"] = hardware_->gbufferBaseColorImage;
-                    hardware_->rasterizerPipeline["gbufferNormal"] = hardware_->gbufferNormalImage;
-                    hardware_->rasterizerPipeline["gbufferMotionVector"] = hardware_->gbufferMotionVectorImage;
-                    hardware_->rasterizerPipeline.setDepthImage(hardware_->gbufferDepthImage);
-
-                    // 遍历所有光学设备
-                    for (const auto& optics : SharedDataHub::instance().optics_storage()) {
-                        if (auto geom = SharedDataHub::instance().geometry_storage().acquire_write(optics.geometry_handle)) {
-                            if (auto transform = SharedDataHub::instance().model_transform_storage().acquire_read(geom->transform_handle)) {
-                                auto model_matrix = transform->compute_matrix();
-                                hardware_->rasterizerPipeline["pushConsts.modelMatrix"] = model_matrix;
-                            }
-                            hardware_->rasterizerPipeline["pushConsts.uniformBufferIndex"] = hardware_->gbufferUniformBuffer.storeDescriptor();
-
-                            for (auto& m : geom->mesh_handles) {
-                                hardware_->rasterizerPipeline["pushConsts.textureIndex"] = m.textureBuffer.storeDescriptor();
-                                hardware_->executor << hardware_->rasterizerPipeline.record(m.indexBuffer, m.vertexBuffer);
-                            }
-                        }
-                    }
+    // 每个视口录制 G-Buffer 光栅化与光照计算，再提交到相机对应的显示器
+    struct GpuRecorder {
+        Hardware& hardware;
+
+        void begin_view(const CameraDevice& camera) const {
+            hardware.uniformBufferObjects.eyePosition = camera.position;
+            hardware.uniformBufferObjects.eyeDir = camera.forward;
+            hardware.uniformBufferObjects.eyeViewMatrix = camera.compute_view_matrix();
+            hardware.uniformBufferObjects.eyeProjMatrix = camera.compute_projection_matrix();
+            hardware.gbufferUniformBufferObjects.viewProjMatrix = camera.compute_view_proj_matrix();
+            hardware.gbufferUniformBuffer.copyFromData(&hardware.gbufferUniformBufferObjects, sizeof(hardware.gbufferUniformBufferObjects));
+
+            hardware.rasterizerPipeline["gbufferPostion"] = hardware.gbufferPostionImage;
+            hardware.rasterizerPipeline["gbufferBaseColor"] = hardware.gbufferBaseColorImage;
+            hardware.rasterizerPipeline["gbufferNormal"] = hardware.gbufferNormalImage;
+            hardware.rasterizerPipeline["gbufferMotionVector"] = hardware.gbufferMotionVectorImage;
+            hardware.rasterizerPipeline.setDepthImage(hardware.gbufferDepthImage);
+        }
 
-                    hardware_->computePipeline["pushConsts.gbufferSize"] = hardware_->gbufferSize;
-                    hardware_->computePipeline["pushConsts.gbufferPostionImage"] = hardware_->gbufferPostionImage.storeDescriptor();
-                    hardware_->computePipeline["pushConsts.gbufferBaseColorImage"] = hardware_->gbufferBaseColorImage.storeDescriptor();
-                    hardware_->computePipeline["pushConsts.gbufferNormalImage"] = hardware_->gbufferNormalImage.storeDescriptor();
-                    hardware_->computePipeline["pushConsts.gbufferDepthImage"] = hardware_->rasterizerPipeline.getDepthImage().storeDescriptor();
-
-                    hardware_->computePipeline["pushConsts.finalOutputImage"] = hardware_->finalOutputImage.storeDescriptor();
-
-                    ktm::fvec3 sun_dir;
-                    sun_dir.x = 1.0f;
-                    sun_dir.y = 1.0f;
-                    sun_dir.z = 1.0f;
-                    if (scene.environment != 0) {
-                        if (auto env = SharedDataHub::instance().environment_storage().acquire_read(scene.environment)) {
-                            sun_dir = env->sun_position;
-                        }
-                    }
+        void draw(GeometryDevice& geom, const ktm::fmat4x4* model_matrix) const {
+            if (model_matrix) {
+                hardware.rasterizerPipeline["pushConsts.modelMatrix"] = *model_matrix;
+            }
+            hardware.rasterizerPipeline["pushConsts.uniformBufferIndex"] = hardware.gbufferUniformBuffer.storeDescriptor();
 
-                    hardware_->computePipeline["pushConsts.sun_dir"] = ktm::normalize(sun_dir);
-                    {
-                        ktm::fvec3 lightColor;
-                        lightColor.x = 23.47f;
-                        lightColor.y = 21.31f;
-                        lightColor.z = 20.79f;
-                        hardware_->computePipeline["pushConsts.lightColor"] = lightColor;
-                    }
+            for (auto& m : geom.mesh_handles) {
+                hardware.rasterizerPipeline["pushConsts.textureIndex"] = m.textureBuffer.storeDescriptor();
+                hardware.executor << hardware.rasterizerPipeline.record(m.indexBuffer, m.vertexBuffer);
+            }
+        }
 
-                    hardware_->uniformBuffer.copyFromData(&hardware_->uniformBufferObjects, sizeof(hardware_->uniformBufferObjects));
-                    hardware_->computePipeline["pushConsts.uniformBufferIndex"] = hardware_->uniformBuffer.storeDescriptor();
+        void end_view(const SceneDevice& scene, const CameraDevice& camera) const {
+            hardware.computePipeline["pushConsts.gbufferSize"] = hardware.gbufferSize;
+            hardware.computePipeline["pushConsts.gbufferPostionImage"] = hardware.gbufferPostionImage.storeDescriptor();
+            hardware.computePipeline["pushConsts.gbufferBaseColorImage"] = hardware.gbufferBaseColorImage.storeDescriptor();
+            hardware.computePipeline["pushConsts.gbufferNormalImage"] = hardware.gbufferNormalImage.storeDescriptor();
+            hardware.computePipeline["pushConsts.gbufferDepthImage"] = hardware.rasterizerPipeline.getDepthImage().storeDescriptor();
+
+            hardware.computePipeline["pushConsts.finalOutputImage"] = hardware.finalOutputImage.storeDescriptor();
+
+            ktm::fvec3 sun_dir;
+            sun_dir.x = 1.0f;
+            sun_dir.y = 1.0f;
+            sun_dir.z = 1.0f;
+            if (scene.environment != 0) {
+                if (auto env = SharedDataHub::instance().environment_storage().acquire_read(scene.environment)) {
+                    sun_dir = env->sun_position;
+                }
+            }
 
-                    hardware_->executor << hardware_->rasterizerPipeline(1920, 1080)
-                                        << hardware_->computePipeline(1920 / 8, 1080 / 8, 1)
-                                        << hardware_->executor.commit();
+            hardware.computePipeline["pushConsts.sun_dir"] = ktm::normalize(sun_dir);
+            {
+                ktm::fvec3 lightColor;
+                lightColor.x = 23.47f;
+                lightColor.y = 21.31f;
+                lightColor.z = 20.79f;
+                hardware.computePipeline["pushConsts.lightColor"] = lightColor;
+            }
+
+            hardware.uniformBuffer.copyFromData(&hardware.uniformBufferObjects, sizeof(hardware.uniformBufferObjects));
+            hardware.computePipeline["pushConsts.uniformBufferIndex"] = hardware.uniformBuffer.storeDescriptor();
+
+            hardware.executor << hardware.rasterizerPipeline(1920, 1080)
+                              << hardware.computePipeline(1920 / 8, 1080 / 8, 1)
+                              << hardware.executor.commit();
 
 #ifdef CORONA_ENABLE_VISION
-                    if (hardware_->displayers_.contains(reinterpret_cast<uint64_t>(camera->surface))) {
-                        renderPipeline->display(1 / 30);
-                        importedViewImage.copyFromBuffer(importedViewBuffer);
-                        hardware_->displayers_.at(reinterpret_cast<uint64_t>(camera->surface)).wait(hardware_->executor) << importedViewImage;
-                    }
+            if (hardware.displayers_.contains(reinterpret_cast<uint64_t>(camera.surface))) {
+                renderPipeline->display(1 / 30);
+                importedViewImage.copyFromBuffer(importedViewBuffer);
+                hardware.displayers_.at(reinterpret_cast<uint64_t>(camera.surface)).wait(hardware.executor) << importedViewImage;
+            }
 #else
-                    if (hardware_->displayers_.contains(reinterpret_cast<uint64_t>(camera->surface))) {
-                        hardware_->displayers_.at(reinterpret_cast<uint64_t>(camera->surface)).wait(hardware_->executor) << hardware_->finalOutputImage;
-                    }
-#endif
-                }
+            if (hardware.displayers_.contains(reinterpret_cast<uint64_t>(camera.surface))) {
+                hardware.displayers_.at(reinterpret_cast<uint64_t>(camera.surface)).wait(hardware.executor) << hardware.finalOutputImage;
             }
+#endif
         }
-    }
+    };
+
+    GpuRecorder recorder{*hardware_};
+    traverse_scene_views(recorder, std::chrono::steady_clock::now());
 }
 
 void OpticsSystem::shutdown() {
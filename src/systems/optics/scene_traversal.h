@@ -0,0 +1,137 @@
+#pragma once
+
+#include <corona/shared_data_hub.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace Corona::Systems {
+
+/**
+ * @brief 按渲染顺序遍历所有场景视口及其中的光学物体
+ *
+ * 与渲染后端无关，visitor 依次收到：
+ * - begin_view(camera)：视口的相机可用，开始录制该视口；
+ * - draw(geometry, model_matrix)：一个光学物体，model_matrix 为插值后的世界矩阵，找不到变换时为 nullptr；
+ *   变换取自最近一次帧末发布的 TransformSnapshot，因此比力学系统的写入最多晚一帧；
+ *   根节点的插值沿父链传播到子节点，挂载物与父节点在同一插值时刻绘制；
+ * - end_view(scene, camera)：该视口的物体已全部提交。
+ *
+ * 光学系统以 GPU 后端作为 visitor；基准测试以不提交任何命令的后端测量遍历本身的开销。
+ */
+template <typename Visitor>
+void traverse_scene_views(Visitor& visitor, std::chrono::steady_clock::time_point now) {
+    auto& hub = SharedDataHub::instance();
+
+    // 优先读取主循环帧末发布的变换快照，无需逐个加锁；尚未发布时退回直接读取存储
+    const auto snapshot = hub.model_transform_snapshot();
+
+    // 力学系统以固定步长推进，渲染时在最近两个物理步之间插值
+    const auto interpolation = snapshot ? snapshot->interpolation : hub.physics_interpolation();
+    const float physics_alpha = interpolation.alpha_at(now);
+
+    // 只有根节点由力学系统驱动，其局部矩阵在最近两个物理步之间插值
+    const auto local_matrix = [&](const ModelTransform& transform) {
+        const bool interpolate = transform.parent_handle == 0 && transform.physics_step != 0 &&
+                                 transform.physics_step == interpolation.step;
+        return interpolate ? transform.compute_interpolated_matrix(physics_alpha) : transform.compute_matrix();
+    };
+
+    // 父链的最大深度，超过时（包括父链成环）不再向上传播插值
+    constexpr std::size_t kMaxDepth = 64;
+
+    // 带父节点的变换：所在层级的根节点正在插值时，把插值后的根矩阵沿父链传播下来，
+    // 使挂载物与移动中的父节点同步；否则返回 false，直接使用快照中传播好的世界矩阵
+    const auto interpolated_child_matrix = [&](std::size_t index, ktm::fmat4x4& out) {
+        std::size_t chain[kMaxDepth];
+        std::size_t depth = 0;
+        std::size_t node = index;
+        while (snapshot->transforms[node].parent_handle != 0) {
+            // 父变换已释放时按根节点处理，与发布快照时一致
+            const std::size_t parent = snapshot->index_of(snapshot->transforms[node].parent_handle);
+            if (parent == TransformSnapshot::kNotFound) {
+                break;
+            }
+            if (depth == kMaxDepth) {
+                return false;
+            }
+            chain[depth++] = node;
+            node = parent;
+        }
+
+        const auto& root = snapshot->transforms[node];
+        if (node == index || root.physics_step == 0 || root.physics_step != interpolation.step) {
+            return false;
+        }
+        out = root.compute_interpolated_matrix(physics_alpha);
+        while (depth > 0) {
+            out = out * snapshot->transforms[chain[--depth]].compute_matrix();
+        }
+        return true;
+    };
+
+    // 没有快照时沿存储中的父链逐级组合世界矩阵
+    const auto storage_world_matrix = [&](const ModelTransform& transform) {
+        auto& transforms = hub.model_transform_storage();
+        ktm::fmat4x4 world = local_matrix(transform);
+        std::uintptr_t parent_handle = transform.parent_handle;
+        for (std::size_t depth = 0; parent_handle != 0 && depth < kMaxDepth; ++depth) {
+            auto parent = transforms.acquire_read(parent_handle);
+            if (!parent) {
+                break;
+            }
+            world = local_matrix(*parent) * world;
+            parent_handle = parent->parent_handle;
+        }
+        return world;
+    };
+
+    for (const auto& scene : hub.scene_storage()) {
+        for (auto vp_handle : scene.viewport_handles) {
+            auto viewport = hub.viewport_storage().acquire_read(vp_handle);
+            if (!viewport || viewport->camera == 0) {
+                continue;
+            }
+            auto camera = hub.camera_storage().acquire_read(viewport->camera);
+            if (!camera) {
+                continue;
+            }
+
+            visitor.begin_view(*camera);
+            for (const auto& optics : hub.optics_storage()) {
+                auto geom = hub.geometry_storage().acquire_write(optics.geometry_handle);
+                if (!geom) {
+                    continue;
+                }
+                if (snapshot) {
+                    const std::size_t index = snapshot->index_of(geom->transform_handle);
+                    if (index == TransformSnapshot::kNotFound) {
+                        visitor.draw(*geom, nullptr);
+                        continue;
+                    }
+                    // 不参与插值的变换直接使用快照中传播好的世界矩阵
+                    const auto& transform = snapshot->transforms[index];
+                    ktm::fmat4x4 model_matrix;
+                    if (transform.parent_handle == 0 && transform.physics_step != 0 &&
+                        transform.physics_step == interpolation.step) {
+                        model_matrix = transform.compute_interpolated_matrix(physics_alpha);
+                        visitor.draw(*geom, &model_matrix);
+                    } else if (transform.parent_handle != 0 && interpolated_child_matrix(index, model_matrix)) {
+                        visitor.draw(*geom, &model_matrix);
+                    } else {
+                        visitor.draw(*geom, &snapshot->world_matrices[index]);
+                    }
+                } else if (auto transform = hub.model_transform_storage().acquire_read(geom->transform_handle)) {
+                    const auto model_matrix = storage_world_matrix(*transform);
+                    visitor.draw(*geom, &model_matrix);
+                } else {
+                    visitor.draw(*geom, nullptr);
+                }
+            }
+            visitor.end_view(scene, *camera);
+        }
+    }
+}
+
+}  // namespace Corona::Systems
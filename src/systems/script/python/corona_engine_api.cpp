@@ -6,13 +6,66 @@
 #include <corona/events/optics_system_events.h>
 #include <corona/kernel/core/kernel_context.h>
 #include <corona/kernel/event/i_event_bus.h>
+#include <corona/metrics.h>
+#include <corona/profiler.h>
 #include <corona/resource/resource_manager.h>
 #include <corona/resource/types/scene.h>
+#include <corona/systems/mechanics/spatial_index.h>
 #include <corona/systems/script/corona_engine_api.h>
+#include <corona/systems/script/script_system.h>
 #include <corona/shared_data_hub.h>
 
+#include <algorithm>
+#include <cmath>
+
 #include "corona/resource/types/image.h"
 
+namespace {
+
+// Geometry 句柄 -> 所属 Actor，用于把空间查询的结果映射回脚本对象
+std::unordered_map<std::uintptr_t, Corona::API::Actor*>& actor_registry() {
+    static std::unordered_map<std::uintptr_t, Corona::API::Actor*> registry;
+    return registry;
+}
+
+Corona::API::Actor* find_actor(std::uintptr_t geometry_handle) {
+    const auto& registry = actor_registry();
+    auto it = registry.find(geometry_handle);
+    return it != registry.end() ? it->second : nullptr;
+}
+
+void unregister_actor(std::uintptr_t geometry_handle, const Corona::API::Actor* actor) {
+    auto& registry = actor_registry();
+    auto it = registry.find(geometry_handle);
+    if (it != registry.end() && it->second == actor) {
+        registry.erase(it);
+    }
+}
+
+Corona::API::RaycastHit to_raycast_hit(const Corona::Systems::RayHit& hit) {
+    Corona::API::RaycastHit result;
+    result.actor = find_actor(hit.body.geometry_handle);
+    result.distance = hit.distance;
+    result.point = {hit.point.x, hit.point.y, hit.point.z};
+    result.normal = {hit.normal.x, hit.normal.y, hit.normal.z};
+    return result;
+}
+
+std::vector<Corona::API::Actor*> to_actors(const std::vector<Corona::Systems::QueryBody>& bodies) {
+    std::vector<Corona::API::Actor*> actors;
+    actors.reserve(bodies.size());
+    for (const auto& body : bodies) {
+        auto* actor = find_actor(body.geometry_handle);
+        // 同一 Actor 的多个 Geometry 可能同时命中
+        if (actor != nullptr && std::find(actors.begin(), actors.end(), actor) == actors.end()) {
+            actors.push_back(actor);
+        }
+    }
+    return actors;
+}
+
+}  // namespace
+
 // ########################
 //          Scene
 // ########################
@@ -244,7 +297,11 @@ std::uintptr_t Corona::API::Environment::get_handle() const {
 //         Geometry
 // ########################
 Corona::API::Geometry::Geometry(const std::string& model_path) {
-    auto model_id = Resource::ResourceManager::get_instance().import_sync(std::filesystem::path(model_path));
+    Resource::TResourceID model_id = 0;
+    {
+        CORONA_PROFILE_SCOPE("ResourceManager::import_sync");
+        model_id = Resource::ResourceManager::get_instance().import_sync(std::filesystem::path(model_path));
+    }
     if (model_id == 0) {
         CFW_LOG_CRITICAL("[Geometry] Failed to load model: {}", model_path);
         return;
@@ -371,6 +428,7 @@ void Corona::API::Geometry::set_position(const std::array<float, 3>& pos) {
         accessor->position.x = pos[0];
         accessor->position.y = pos[1];
         accessor->position.z = pos[2];
+        accessor->physics_step = 0;  // 直接设置的位姿不做插值
     } else {
         CFW_LOG_ERROR("[Geometry::set_position] Failed to acquire write access to transform storage");
     }
@@ -387,6 +445,7 @@ void Corona::API::Geometry::set_rotation(const std::array<float, 3>& euler) {
         accessor->euler_rotation.x = euler[0];  // Pitch
         accessor->euler_rotation.y = euler[1];  // Yaw
         accessor->euler_rotation.z = euler[2];  // Roll
+        accessor->physics_step = 0;             // 直接设置的位姿不做插值
     } else {
         CFW_LOG_ERROR("[Geometry::set_rotation] Failed to acquire write access to transform storage");
     }
@@ -465,6 +524,35 @@ std::array<float, 3> Corona::API::Geometry::get_scale() const {
     return result;
 }
 
+bool Corona::API::Geometry::set_parent(const Geometry* parent) {
+    if (transform_handle_ == 0) {
+        CFW_LOG_WARNING("[Geometry::set_parent] Invalid transform handle");
+        return false;
+    }
+    if (parent == this) {
+        CFW_LOG_WARNING("[Geometry::set_parent] A geometry cannot be its own parent");
+        return false;
+    }
+
+    // 力学系统按世界空间求解，带父节点的变换不能挂载刚体
+    if (parent != nullptr) {
+        for (const auto& mechanics : SharedDataHub::instance().mechanics_storage()) {
+            if (mechanics.geometry_handle == handle_) {
+                CFW_LOG_ERROR("[Geometry::set_parent] A geometry with a Mechanics body cannot have a parent");
+                return false;
+            }
+        }
+    }
+
+    if (auto accessor = SharedDataHub::instance().model_transform_storage().acquire_write(transform_handle_)) {
+        accessor->parent_handle = parent ? parent->transform_handle_ : 0;
+        accessor->physics_step = 0;  // 挂接后位姿相对父变换，不再参与力学插值
+        return true;
+    }
+    CFW_LOG_ERROR("[Geometry::set_parent] Failed to acquire write access to transform storage");
+    return false;
+}
+
 std::uintptr_t Corona::API::Geometry::get_handle() const {
     return handle_;
 }
@@ -511,31 +599,60 @@ Corona::API::Geometry* Corona::API::Optics::get_geometry() const {
 // ########################
 Corona::API::Mechanics::Mechanics(Geometry& geo)
     : geometry_(&geo), handle_(0) {
-    // 获取模型的包围盒信息
-    ktm::fvec3 max_xyz{0, 0, 0};
-    ktm::fvec3 min_xyz{0, 0, 0};
-
-    if (auto geom_handle = SharedDataHub::instance().geometry_storage().acquire_read(geo.get_handle())) {
-        if (auto res_handle = SharedDataHub::instance().model_resource_storage().acquire_read(geom_handle->model_resource_handle)) {
-            // if (res_handle->model_id) {
-            //     max_xyz = res_handle->model_id->max_xyz;
-            //     min_xyz = res_handle->model_id->min_xyz;
-            // }
-            return;
-        }
+    // 模型资源目前不提供包围盒，零体积的刚体会让宽阶段、求解与连续碰撞都退化为点，
+    // 因此在调用方给出包围盒之前不创建 MechanicsDevice
+    CFW_LOG_WARNING("[Mechanics] No bounds given; call set_bounds() to create the rigid body");
+}
+
+Corona::API::Mechanics::Mechanics(Geometry& geo, const Bounds& min_xyz, const Bounds& max_xyz)
+    : geometry_(&geo), handle_(0) {
+    set_bounds(min_xyz, max_xyz);
+}
+
+bool Corona::API::Mechanics::set_bounds(const Bounds& min_xyz, const Bounds& max_xyz) {
+    if (!(max_xyz[0] > min_xyz[0] && max_xyz[1] > min_xyz[1] && max_xyz[2] > min_xyz[2])) {
+        CFW_LOG_ERROR("[Mechanics::set_bounds] Bounds must have positive extent on every axis");
+        return false;
     }
 
-    // 创建 MechanicsDevice
-    handle_ = SharedDataHub::instance().mechanics_storage().allocate();
-    if (auto accessor = SharedDataHub::instance().mechanics_storage().acquire_write(handle_)) {
-        accessor->geometry_handle = geo.get_handle();
-        accessor->max_xyz = max_xyz;
-        accessor->min_xyz = min_xyz;
-    } else {
-        CFW_LOG_ERROR("[Mechanics] Failed to acquire write access to mechanics storage");
-        SharedDataHub::instance().mechanics_storage().deallocate(handle_);
+    auto& storage = SharedDataHub::instance().mechanics_storage();
+    const bool created = handle_ == 0;
+    if (created) {
+        // 力学系统按世界空间求解，带父节点的变换不能挂载刚体
+        auto transform = SharedDataHub::instance().model_transform_storage().acquire_read(geometry_->get_transform_handle());
+        if (transform && transform->parent_handle != 0) {
+            CFW_LOG_ERROR("[Mechanics::set_bounds] A geometry with a parent cannot have a Mechanics body");
+            return false;
+        }
+        handle_ = storage.allocate();
+    }
+    if (auto accessor = storage.acquire_write(handle_)) {
+        if (created) {
+            accessor->geometry_handle = geometry_->get_handle();
+        }
+        accessor->min_xyz.x = min_xyz[0];
+        accessor->min_xyz.y = min_xyz[1];
+        accessor->min_xyz.z = min_xyz[2];
+        accessor->max_xyz.x = max_xyz[0];
+        accessor->max_xyz.y = max_xyz[1];
+        accessor->max_xyz.z = max_xyz[2];
+        // 形状改变后需重新计算包围盒与质量属性
+        accessor->sleeping = false;
+        accessor->sleep_timer = 0.0f;
+        ++accessor->revision;
+        return true;
+    }
+
+    CFW_LOG_ERROR("[Mechanics::set_bounds] Failed to acquire write access to mechanics storage");
+    if (created) {
+        storage.deallocate(handle_);
         handle_ = 0;
     }
+    return false;
+}
+
+bool Corona::API::Mechanics::has_body() const {
+    return handle_ != 0;
 }
 
 Corona::API::Mechanics::~Mechanics() {
@@ -544,6 +661,211 @@ Corona::API::Mechanics::~Mechanics() {
     }
 }
 
+void Corona::API::Mechanics::set_mass(float mass) {
+    if (handle_ == 0) {
+        CFW_LOG_WARNING("[Mechanics::set_mass] Invalid mechanics handle");
+        return;
+    }
+
+    if (auto accessor = SharedDataHub::instance().mechanics_storage().acquire_write(handle_)) {
+        accessor->mass = mass;
+        // 修改运动参数时唤醒物体
+        accessor->sleeping = false;
+        accessor->sleep_timer = 0.0f;
+        ++accessor->revision;
+    } else {
+        CFW_LOG_ERROR("[Mechanics::set_mass] Failed to acquire write access to mechanics storage");
+    }
+}
+
+void Corona::API::Mechanics::set_restitution(float restitution) {
+    if (handle_ == 0) {
+        CFW_LOG_WARNING("[Mechanics::set_restitution] Invalid mechanics handle");
+        return;
+    }
+
+    if (auto accessor = SharedDataHub::instance().mechanics_storage().acquire_write(handle_)) {
+        accessor->restitution = restitution;
+    } else {
+        CFW_LOG_ERROR("[Mechanics::set_restitution] Failed to acquire write access to mechanics storage");
+    }
+}
+
+void Corona::API::Mechanics::set_friction(float friction) {
+    if (handle_ == 0) {
+        CFW_LOG_WARNING("[Mechanics::set_friction] Invalid mechanics handle");
+        return;
+    }
+
+    if (auto accessor = SharedDataHub::instance().mechanics_storage().acquire_write(handle_)) {
+        accessor->friction = friction;
+    } else {
+        CFW_LOG_ERROR("[Mechanics::set_friction] Failed to acquire write access to mechanics storage");
+    }
+}
+
+void Corona::API::Mechanics::set_gravity_scale(float scale) {
+    if (handle_ == 0) {
+        CFW_LOG_WARNING("[Mechanics::set_gravity_scale] Invalid mechanics handle");
+        return;
+    }
+
+    if (auto accessor = SharedDataHub::instance().mechanics_storage().acquire_write(handle_)) {
+        accessor->gravity_scale = scale;
+        // 修改运动参数时唤醒物体
+        accessor->sleeping = false;
+        accessor->sleep_timer = 0.0f;
+        ++accessor->revision;
+    } else {
+        CFW_LOG_ERROR("[Mechanics::set_gravity_scale] Failed to acquire write access to mechanics storage");
+    }
+}
+
+void Corona::API::Mechanics::set_linear_velocity(const std::array<float, 3>& velocity) {
+    if (handle_ == 0) {
+        CFW_LOG_WARNING("[Mechanics::set_linear_velocity] Invalid mechanics handle");
+        return;
+    }
+
+    if (auto accessor = SharedDataHub::instance().mechanics_storage().acquire_write(handle_)) {
+        accessor->linear_velocity.x = velocity[0];
+        accessor->linear_velocity.y = velocity[1];
+        accessor->linear_velocity.z = velocity[2];
+        // 修改运动参数时唤醒物体
+        accessor->sleeping = false;
+        accessor->sleep_timer = 0.0f;
+        ++accessor->revision;
+    } else {
+        CFW_LOG_ERROR("[Mechanics::set_linear_velocity] Failed to acquire write access to mechanics storage");
+    }
+}
+
+void Corona::API::Mechanics::set_angular_velocity(const std::array<float, 3>& velocity) {
+    if (handle_ == 0) {
+        CFW_LOG_WARNING("[Mechanics::set_angular_velocity] Invalid mechanics handle");
+        return;
+    }
+
+    if (auto accessor = SharedDataHub::instance().mechanics_storage().acquire_write(handle_)) {
+        accessor->angular_velocity.x = velocity[0];
+        accessor->angular_velocity.y = velocity[1];
+        accessor->angular_velocity.z = velocity[2];
+        // 修改运动参数时唤醒物体
+        accessor->sleeping = false;
+        accessor->sleep_timer = 0.0f;
+        ++accessor->revision;
+    } else {
+        CFW_LOG_ERROR("[Mechanics::set_angular_velocity] Failed to acquire write access to mechanics storage");
+    }
+}
+
+void Corona::API::Mechanics::set_continuous_collision(bool enabled) {
+    if (handle_ == 0) {
+        CFW_LOG_WARNING("[Mechanics::set_continuous_collision] Invalid mechanics handle");
+        return;
+    }
+
+    if (auto accessor = SharedDataHub::instance().mechanics_storage().acquire_write(handle_)) {
+        accessor->continuous = enabled;
+    } else {
+        CFW_LOG_ERROR("[Mechanics::set_continuous_collision] Failed to acquire write access to mechanics storage");
+    }
+}
+
+void Corona::API::Mechanics::wake_up() {
+    if (handle_ == 0) {
+        CFW_LOG_WARNING("[Mechanics::wake_up] Invalid mechanics handle");
+        return;
+    }
+
+    if (auto accessor = SharedDataHub::instance().mechanics_storage().acquire_write(handle_)) {
+        accessor->sleeping = false;
+        accessor->sleep_timer = 0.0f;
+        ++accessor->revision;
+    } else {
+        CFW_LOG_ERROR("[Mechanics::wake_up] Failed to acquire write access to mechanics storage");
+    }
+}
+
+bool Corona::API::Mechanics::is_sleeping() const {
+    if (handle_ == 0) {
+        CFW_LOG_WARNING("[Mechanics::is_sleeping] Invalid mechanics handle");
+        return false;
+    }
+
+    bool result = false;
+    if (auto accessor = SharedDataHub::instance().mechanics_storage().acquire_read(handle_)) {
+        result = accessor->sleeping;
+    } else {
+        CFW_LOG_ERROR("[Mechanics::is_sleeping] Failed to acquire read access to mechanics storage");
+    }
+    return result;
+}
+
+bool Corona::API::Mechanics::is_continuous_collision() const {
+    if (handle_ == 0) {
+        CFW_LOG_WARNING("[Mechanics::is_continuous_collision] Invalid mechanics handle");
+        return false;
+    }
+
+    bool result = false;
+    if (auto accessor = SharedDataHub::instance().mechanics_storage().acquire_read(handle_)) {
+        result = accessor->continuous;
+    } else {
+        CFW_LOG_ERROR("[Mechanics::is_continuous_collision] Failed to acquire read access to mechanics storage");
+    }
+    return result;
+}
+
+float Corona::API::Mechanics::get_mass() const {
+    if (handle_ == 0) {
+        CFW_LOG_WARNING("[Mechanics::get_mass] Invalid mechanics handle");
+        return 0.0f;
+    }
+
+    float result = 0.0f;
+    if (auto accessor = SharedDataHub::instance().mechanics_storage().acquire_read(handle_)) {
+        result = accessor->mass;
+    } else {
+        CFW_LOG_ERROR("[Mechanics::get_mass] Failed to acquire read access to mechanics storage");
+    }
+    return result;
+}
+
+std::array<float, 3> Corona::API::Mechanics::get_linear_velocity() const {
+    if (handle_ == 0) {
+        CFW_LOG_WARNING("[Mechanics::get_linear_velocity] Invalid mechanics handle");
+        return {0.0f, 0.0f, 0.0f};
+    }
+
+    std::array<float, 3> result = {0.0f, 0.0f, 0.0f};
+    if (auto accessor = SharedDataHub::instance().mechanics_storage().acquire_read(handle_)) {
+        result[0] = accessor->linear_velocity.x;
+        result[1] = accessor->linear_velocity.y;
+        result[2] = accessor->linear_velocity.z;
+    } else {
+        CFW_LOG_ERROR("[Mechanics::get_linear_velocity] Failed to acquire read access to mechanics storage");
+    }
+    return result;
+}
+
+std::array<float, 3> Corona::API::Mechanics::get_angular_velocity() const {
+    if (handle_ == 0) {
+        CFW_LOG_WARNING("[Mechanics::get_angular_velocity] Invalid mechanics handle");
+        return {0.0f, 0.0f, 0.0f};
+    }
+
+    std::array<float, 3> result = {0.0f, 0.0f, 0.0f};
+    if (auto accessor = SharedDataHub::instance().mechanics_storage().acquire_read(handle_)) {
+        result[0] = accessor->angular_velocity.x;
+        result[1] = accessor->angular_velocity.y;
+        result[2] = accessor->angular_velocity.z;
+    } else {
+        CFW_LOG_ERROR("[Mechanics::get_angular_velocity] Failed to acquire read access to mechanics storage");
+    }
+    return result;
+}
+
 std::uintptr_t Corona::API::Mechanics::get_handle() const {
     return handle_;
 }
@@ -662,6 +984,10 @@ Corona::API::Actor::Actor()
 }
 
 Corona::API::Actor::~Actor() {
+    for (const auto& [profile_handle, profile] : profiles_) {
+        unregister_actor(profile.geometry->get_handle(), this);
+    }
+
     if (handle_ != 0) {
         SharedDataHub::instance().actor_storage().deallocate(handle_);
     }
@@ -695,6 +1021,7 @@ Corona::API::Actor::Profile* Corona::API::Actor::add_profile(const Profile& prof
 
     std::uintptr_t profile_handle = next_profile_handle_++;
     profiles_[profile_handle] = profile;
+    actor_registry()[profile.geometry->get_handle()] = this;
 
     if (active_profile_handle_ == 0) {
         active_profile_handle_ = profile_handle;
@@ -739,6 +1066,7 @@ void Corona::API::Actor::remove_profile(const Profile* profile) {
         it->second.kinematics->stop_animation();
     }
 
+    unregister_actor(it->second.geometry->get_handle(), this);
     profiles_.erase(it);
 
     if (active_profile_handle_ == profile_handle) {
@@ -1071,9 +1399,42 @@ void Corona::API::Viewport::set_viewport_rect(int x, int y, int width, int heigh
     CFW_LOG_WARNING("[Corona::API::Viewport::set_viewport_rect] Not implemented yet");
 }
 
-void Corona::API::Viewport::pick_actor_at_pixel(int x, int y) const {
-    // TODO: Implement pixel picking for actor selection
-    CFW_LOG_WARNING("[Corona::API::Viewport::pick_actor_at_pixel] Not implemented yet");
+Corona::API::Actor* Corona::API::Viewport::pick_actor_at_pixel(int x, int y) const {
+    if (camera_ == nullptr || camera_->get_handle() == 0) {
+        CFW_LOG_WARNING("[Viewport::pick_actor_at_pixel] Viewport has no camera");
+        return nullptr;
+    }
+
+    if (x < 0 || y < 0 || x >= width_ || y >= height_) {
+        return nullptr;
+    }
+
+    Systems::QueryRay ray;
+    if (auto accessor = SharedDataHub::instance().camera_storage().acquire_read(camera_->get_handle())) {
+        // 与 CameraDevice::compute_view_matrix 一致的左手坐标系
+        const ktm::fvec3 forward = ktm::normalize(accessor->forward);
+        const ktm::fvec3 right = ktm::normalize(ktm::cross(accessor->world_up, forward));
+        const ktm::fvec3 up = ktm::cross(forward, right);
+
+        const float tan_half_fov = std::tan(ktm::radians(accessor->fov) * 0.5f);
+        const float ndc_x = 2.0f * (static_cast<float>(x) + 0.5f) / static_cast<float>(width_) - 1.0f;
+        const float ndc_y = 1.0f - 2.0f * (static_cast<float>(y) + 0.5f) / static_cast<float>(height_);
+
+        ray.origin = accessor->position;
+        ray.direction = forward + right * (ndc_x * tan_half_fov * accessor->aspect) + up * (ndc_y * tan_half_fov);
+        ray.max_distance = accessor->far_plane;
+    } else {
+        CFW_LOG_ERROR("[Viewport::pick_actor_at_pixel] Failed to acquire read access to camera storage");
+        return nullptr;
+    }
+
+    const auto index = SharedDataHub::instance().spatial_index();
+    if (!index) {
+        return nullptr;
+    }
+
+    const auto hit = index->raycast(ray);
+    return hit ? find_actor(hit->body.geometry_handle) : nullptr;
 }
 
 void Corona::API::Viewport::save_screenshot(const std::string& path) const {
@@ -1083,4 +1444,103 @@ void Corona::API::Viewport::save_screenshot(const std::string& path) const {
 
 std::uintptr_t Corona::API::Viewport::get_handle() const {
     return handle_;
-}
\ No newline at end of file
+}
+
+// ########################
+//     Physics queries
+// ########################
+std::optional<Corona::API::RaycastHit> Corona::API::raycast(const std::array<float, 3>& origin,
+                                                            const std::array<float, 3>& direction,
+                                                            float max_distance) {
+    const auto index = SharedDataHub::instance().spatial_index();
+    if (!index) {
+        return std::nullopt;
+    }
+
+    Systems::QueryRay ray;
+    ray.origin = ktm::fvec3{origin[0], origin[1], origin[2]};
+    ray.direction = ktm::fvec3{direction[0], direction[1], direction[2]};
+    ray.max_distance = max_distance;
+
+    const auto hit = index->raycast(ray);
+    if (!hit) {
+        return std::nullopt;
+    }
+    return to_raycast_hit(*hit);
+}
+
+std::vector<std::optional<Corona::API::RaycastHit>> Corona::API::raycast_batch(
+    const std::vector<std::array<float, 3>>& origins, const std::vector<std::array<float, 3>>& directions,
+    float max_distance) {
+    if (origins.size() != directions.size()) {
+        CFW_LOG_WARNING("[raycast_batch] Size mismatch: {} origins, {} directions", origins.size(), directions.size());
+        return {};
+    }
+
+    std::vector<std::optional<RaycastHit>> results(origins.size());
+    const auto index = SharedDataHub::instance().spatial_index();
+    if (!index) {
+        return results;
+    }
+
+    std::vector<Systems::QueryRay> rays(origins.size());
+    for (std::size_t i = 0; i < rays.size(); ++i) {
+        rays[i].origin = ktm::fvec3{origins[i][0], origins[i][1], origins[i][2]};
+        rays[i].direction = ktm::fvec3{directions[i][0], directions[i][1], directions[i][2]};
+        rays[i].max_distance = max_distance;
+    }
+
+    std::vector<Systems::RayHit> hits(rays.size());
+    index->raycast(rays, hits);
+    for (std::size_t i = 0; i < hits.size(); ++i) {
+        if (hits[i].body.mechanics_handle != 0) {
+            results[i] = to_raycast_hit(hits[i]);
+        }
+    }
+    return results;
+}
+
+std::vector<Corona::API::Actor*> Corona::API::overlap_sphere(const std::array<float, 3>& center, float radius) {
+    const auto index = SharedDataHub::instance().spatial_index();
+    if (!index) {
+        return {};
+    }
+
+    Systems::QuerySphere sphere;
+    sphere.center = ktm::fvec3{center[0], center[1], center[2]};
+    sphere.radius = radius;
+    return to_actors(index->overlap_sphere(sphere));
+}
+
+std::vector<Corona::API::Actor*> Corona::API::overlap_box(const std::array<float, 3>& min, const std::array<float, 3>& max) {
+    const auto index = SharedDataHub::instance().spatial_index();
+    if (!index) {
+        return {};
+    }
+
+    Systems::QueryBox box;
+    box.min = ktm::fvec3{min[0], min[1], min[2]};
+    box.max = ktm::fvec3{max[0], max[1], max[2]};
+    return to_actors(index->overlap_box(box));
+}
+
+std::unordered_map<std::string, double> Corona::API::metrics() {
+    std::unordered_map<std::string, double> result;
+    for (auto& [series, value] : MetricsRegistry::instance().series()) {
+        result.emplace(std::move(series), value);
+    }
+    return result;
+}
+
+std::vector<Corona::API::SystemRate> Corona::API::system_rates() {
+    std::vector<SystemRate> result;
+    for (const auto& rate : SharedDataHub::instance().system_rates()) {
+        result.push_back({rate.name, rate.priority, rate.nominal_fps, rate.effective_fps, rate.budget_ms,
+                          rate.average_ms, rate.overruns, rate.sheddable});
+    }
+    return result;
+}
+
+float Corona::API::delta_time() {
+    return Corona::Systems::ScriptSystem::frame_delta_time();
+}
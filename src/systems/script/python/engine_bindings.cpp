@@ -2,7 +2,10 @@
 #include <corona/systems/script/engine_scripts.h>
 #include <nanobind/nanobind.h>
 #include <nanobind/stl/array.h>
+#include <nanobind/stl/optional.h>
 #include <nanobind/stl/string.h>
+#include <nanobind/stl/unordered_map.h>
+#include <nanobind/stl/vector.h>
 
 #include <array>
 #include <cstdint>
@@ -25,6 +28,9 @@ void BindAll(nanobind::module_& m) {
              "Set local rotation (Euler angles ZYX order) [pitch, yaw, roll]")
         .def("set_scale", &Geometry::set_scale, nb::arg("scale"),
              "Set local scale [x, y, z]")
+        .def("set_parent", &Geometry::set_parent, nb::arg("parent").none(),
+             "Attach to a parent Geometry (None to detach); the local transform becomes relative to the parent. "
+             "Returns False for a geometry that has a Mechanics body")
         .def("get_position", &Geometry::get_position,
              "Get local position [x, y, z]")
         .def("get_rotation", &Geometry::get_rotation,
@@ -37,7 +43,40 @@ void BindAll(nanobind::module_& m) {
     // ============================================================================
     nb::class_<Mechanics>(m, "Mechanics")
         .def(nb::init<Geometry&>(), nb::arg("geometry"),
-             "Create a Mechanics component attached to a Geometry");
+             "Create a Mechanics component attached to a Geometry (call set_bounds to create the body)")
+        .def(nb::init<Geometry&, const Mechanics::Bounds&, const Mechanics::Bounds&>(), nb::arg("geometry"),
+             nb::arg("min"), nb::arg("max"),
+             "Create a rigid body with model-space bounds [x, y, z] attached to a Geometry")
+        .def("set_bounds", &Mechanics::set_bounds, nb::arg("min"), nb::arg("max"),
+             "Set model-space bounds [x, y, z]; creates the body if needed, rejects empty bounds and parented geometries")
+        .def("has_body", &Mechanics::has_body,
+             "Whether the rigid body exists (bounds have been set)")
+        .def("set_mass", &Mechanics::set_mass, nb::arg("mass"),
+             "Set body mass in kg (0 = static body)")
+        .def("set_restitution", &Mechanics::set_restitution, nb::arg("restitution"),
+             "Set restitution (bounciness) [0, 1]")
+        .def("set_friction", &Mechanics::set_friction, nb::arg("friction"),
+             "Set friction coefficient")
+        .def("set_gravity_scale", &Mechanics::set_gravity_scale, nb::arg("scale"),
+             "Set gravity scale (0 = no gravity)")
+        .def("set_linear_velocity", &Mechanics::set_linear_velocity, nb::arg("velocity"),
+             "Set linear velocity [x, y, z]")
+        .def("set_angular_velocity", &Mechanics::set_angular_velocity, nb::arg("velocity"),
+             "Set angular velocity in world space [x, y, z] (rad/s)")
+        .def("set_continuous_collision", &Mechanics::set_continuous_collision, nb::arg("enabled"),
+             "Enable continuous collision detection for fast-moving bodies")
+        .def("is_continuous_collision", &Mechanics::is_continuous_collision,
+             "Check whether continuous collision detection is enabled")
+        .def("wake_up", &Mechanics::wake_up,
+             "Wake the body up (call after moving a sleeping body's Geometry)")
+        .def("is_sleeping", &Mechanics::is_sleeping,
+             "Whether the body is currently sleeping")
+        .def("get_mass", &Mechanics::get_mass,
+             "Get body mass in kg")
+        .def("get_linear_velocity", &Mechanics::get_linear_velocity,
+             "Get linear velocity [x, y, z]")
+        .def("get_angular_velocity", &Mechanics::get_angular_velocity,
+             "Get angular velocity in world space [x, y, z] (rad/s)");
 
     // ============================================================================
     // Optics: 光学/渲染组件
@@ -157,7 +196,8 @@ void BindAll(nanobind::module_& m) {
              "Set viewport rectangle")
         .def("pick_actor_at_pixel", &Viewport::pick_actor_at_pixel,
              nb::arg("x"), nb::arg("y"),
-             "Pick actor at pixel coordinates")
+             "Pick the nearest actor under pixel coordinates, or None",
+             nb::rv_policy::reference)
         .def("save_screenshot", &Viewport::save_screenshot, nb::arg("path"),
              "Save screenshot to file");
 
@@ -209,6 +249,50 @@ void BindAll(nanobind::module_& m) {
         .def("has_viewport", &Scene::has_viewport, nb::arg("viewport"),
              "Check if viewport is in the scene");
 
+    // ============================================================================
+    // Physics queries: 基于力学系统发布的空间索引
+    // ============================================================================
+    nb::class_<RaycastHit>(m, "RaycastHit")
+        .def_ro("actor", &RaycastHit::actor, "Hit actor, None if the geometry is not in any actor",
+                nb::rv_policy::reference)
+        .def_ro("distance", &RaycastHit::distance, "Distance from ray origin")
+        .def_ro("point", &RaycastHit::point, "Hit point [x, y, z]")
+        .def_ro("normal", &RaycastHit::normal, "Hit surface normal [x, y, z]");
+
+    m.def("raycast", &raycast, nb::arg("origin"), nb::arg("direction"), nb::arg("max_distance") = 1e30f,
+          "Cast a ray against mechanics bodies, returns the nearest RaycastHit or None");
+    m.def("raycast_batch", &raycast_batch, nb::arg("origins"), nb::arg("directions"),
+          nb::arg("max_distance") = 1e30f,
+          "Cast many rays at once, returns a list of RaycastHit or None");
+    m.def("overlap_sphere", &overlap_sphere, nb::arg("center"), nb::arg("radius"),
+          "Actors whose mechanics bounds overlap the sphere",
+          nb::rv_policy::reference);
+    m.def("overlap_box", &overlap_box, nb::arg("min"), nb::arg("max"),
+          "Actors whose mechanics bounds overlap the box",
+          nb::rv_policy::reference);
+
+    // ============================================================================
+    // Metrics
+    // ============================================================================
+    m.def("metrics", &metrics,
+          "Current engine metrics as {series: value}, series named as in the Prometheus text format");
+
+    nb::class_<SystemRate>(m, "SystemRate")
+        .def_ro("name", &SystemRate::name, "System name")
+        .def_ro("priority", &SystemRate::priority, "System priority")
+        .def_ro("nominal_fps", &SystemRate::nominal_fps, "Update rate declared by the system")
+        .def_ro("effective_fps", &SystemRate::effective_fps,
+                "Update rate currently applied, below nominal_fps while the system is load-shed")
+        .def_ro("budget_ms", &SystemRate::budget_ms, "Time budget for one update in milliseconds")
+        .def_ro("average_ms", &SystemRate::average_ms, "Recent average update time in milliseconds")
+        .def_ro("overruns", &SystemRate::overruns, "Budget evaluations in which the system averaged over its budget")
+        .def_ro("sheddable", &SystemRate::sheddable, "Whether the system may be load-shed");
+
+    m.def("system_rates", &system_rates,
+          "Update rates and budget state of every system, as of the last budget evaluation (every 500 ms)");
+    m.def("delta_time", &delta_time,
+          "Frame time in seconds given to this script run, constant at fixed_dt during batch runs (Engine::run_frames)");
+
     // ============================================================================
     // Scene I/O utilities
     // ============================================================================
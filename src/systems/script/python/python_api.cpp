@@ -1,13 +1,19 @@
 #define PY_SSIZE_T_CLEAN
 #include <corona/systems/script/python_api.h>
 #include <corona/kernel/core/i_logger.h>
+#include <corona/frame_arena.h>
+#include <corona/metrics.h>
+#include <corona/profiler.h>
 #include <nanobind/stl/string.h>
 #include <windows.h>
 
 #include <iostream>
+#include <memory_resource>
 #include <ranges>
 #include <regex>
 #include <set>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 
 #include "python_error_handler.cpp"
@@ -202,11 +208,18 @@ void PythonAPI::sendMessage(const std::string& message) const {
 }
 
 void PythonAPI::runPythonScript() {
+    CORONA_PROFILE_SCOPE("PythonAPI::runPythonScript");
     if (!ensureInitialized()) {
         CFW_LOG_ERROR("PythonAPI: Python initialization failed");
         return;
     }
 
+    static auto& run_seconds = MetricsRegistry::instance().histogram("corona_python_run_seconds",
+                                                                      "Time spent in one Python script run");
+    static auto& hot_reloads = MetricsRegistry::instance().counter("corona_python_hot_reloads_total",
+                                                                   "Python hot reloads performed");
+    const auto start = std::chrono::steady_clock::now();
+
     bool reloaded = false;
     {
         std::unique_lock lk(queMtx);
@@ -215,8 +228,12 @@ void PythonAPI::runPythonScript() {
             hasHotReload = false;
         }
     }
+    if (reloaded) {
+        hot_reloads.increment();
+    }
 
     invokeEntry(reloaded);
+    run_seconds.record(std::chrono::steady_clock::now() - start);
 }
 
 void PythonAPI::checkPythonScriptChange() {
@@ -248,21 +265,25 @@ void PythonAPI::checkReleaseScriptChange() {
 
     std::unique_lock lk(queMtx);
     const auto& mods = messageQue.front();
-    
+
+    // 日志与路径拼接用到的临时字符串从当前线程的临时内存池分配
+    const FrameArenaScope scratch;
+
     // Build module list string for logging
-    std::string moduleListStr;
+    std::pmr::string moduleListStr(scratch.resource());
     bool first = true;
     for (const auto& m : mods) {
         if (!first) moduleListStr += ", ";
         moduleListStr += m;
         first = false;
     }
-    CFW_LOG_DEBUG("PythonAPI: detected modified modules ({}): {}", mods.size(), moduleListStr);
+    CFW_LOG_DEBUG("PythonAPI: detected modified modules ({}): {}", mods.size(), std::string_view(moduleListStr));
 
     auto modToPath = [&](const std::string& mod) {
-        std::string rel = mod;  // replace '.' with '/'
+        std::pmr::string rel(mod, scratch.resource());  // replace '.' with '/'
         std::ranges::replace(rel, '.', '/');
-        return runtimePath / (rel + ".py");
+        rel += ".py";
+        return runtimePath / std::string_view(rel);
     };
 
     for (const auto& mod : mods) {
@@ -21,7 +21,14 @@ bool ScriptSystem::initialize(Kernel::ISystemContext* ctx) {
     return true;
 }
 
+std::atomic<float> ScriptSystem::frame_delta_time_{0.0f};
+
 void ScriptSystem::update() {
+    advance(delta_time());
+}
+
+void ScriptSystem::advance(float elapsed) {
+    frame_delta_time_.store(elapsed, std::memory_order_relaxed);
 
 #ifdef CORONA_ENABLE_PYTHON_API
     python_api_.runPythonScript();
@@ -29,6 +36,10 @@ void ScriptSystem::update() {
 
 }
 
+float ScriptSystem::frame_delta_time() {
+    return frame_delta_time_.load(std::memory_order_relaxed);
+}
+
 void ScriptSystem::shutdown() {
     CFW_LOG_NOTICE("ScriptSystem: Shutting down...");
 }
@@ -0,0 +1,197 @@
+#include <corona/transform_hierarchy.h>
+
+#include <algorithm>
+
+namespace Corona {
+
+namespace {
+
+ktm::fmat4x4 identity_matrix() {
+    ktm::fmat4x4 result;
+    for (int c = 0; c < 4; ++c) {
+        for (int r = 0; r < 4; ++r) {
+            result[c][r] = c == r ? 1.0f : 0.0f;
+        }
+    }
+    return result;
+}
+
+// out = lhs * rhs，列主序（m[列][行]），out 不得与输入重叠
+void multiply(const ktm::fmat4x4& lhs, const ktm::fmat4x4& rhs, ktm::fmat4x4& out) {
+    for (int c = 0; c < 4; ++c) {
+        const float b0 = rhs[c][0];
+        const float b1 = rhs[c][1];
+        const float b2 = rhs[c][2];
+        const float b3 = rhs[c][3];
+        for (int r = 0; r < 4; ++r) {
+            out[c][r] = lhs[0][r] * b0 + lhs[1][r] * b1 + lhs[2][r] * b2 + lhs[3][r] * b3;
+        }
+    }
+}
+
+}  // namespace
+
+void TransformHierarchy::resize(std::size_t count) {
+    const std::size_t old_size = size();
+    if (count == old_size) {
+        return;
+    }
+
+    if (count < old_size) {
+        std::erase_if(dirty_list_, [count](std::uint32_t node) { return node >= count; });
+    }
+    parent_.resize(count, kNoParent);
+    local_.resize(count, identity_matrix());
+    dirty_.resize(count, 0);
+
+    for (auto& parent : parent_) {
+        if (parent != kNoParent && parent >= count) {
+            parent = kNoParent;
+        }
+    }
+    layout_dirty_ = true;
+}
+
+void TransformHierarchy::set_parent(std::size_t node, std::uint32_t parent) {
+    if (parent != kNoParent && (parent >= size() || parent == node)) {
+        parent = kNoParent;
+    }
+    if (parent_[node] != parent) {
+        parent_[node] = parent;
+        layout_dirty_ = true;
+    }
+}
+
+void TransformHierarchy::set_local(std::size_t node, const ktm::fmat4x4& local) {
+    local_[node] = local;
+    if (dirty_[node] == 0) {
+        dirty_[node] = 1;
+        dirty_list_.push_back(static_cast<std::uint32_t>(node));
+    }
+}
+
+void TransformHierarchy::rebuild_layout() {
+    const auto count = static_cast<std::uint32_t>(size());
+
+    // 按父节点分桶得到每个节点的子节点列表（保持节点下标顺序）
+    child_offsets_.assign(count + 1, 0);
+    for (std::uint32_t node = 0; node < count; ++node) {
+        if (parent_[node] != kNoParent) {
+            ++child_offsets_[parent_[node] + 1];
+        }
+    }
+    for (std::uint32_t node = 0; node < count; ++node) {
+        child_offsets_[node + 1] += child_offsets_[node];
+    }
+    children_.resize(child_offsets_[count]);
+    stack_.assign(child_offsets_.begin(), child_offsets_.end() - 1);  // 暂作每个桶的写入游标
+    for (std::uint32_t node = 0; node < count; ++node) {
+        if (parent_[node] != kNoParent) {
+            children_[stack_[parent_[node]]++] = node;
+        }
+    }
+
+    // 从根节点出发深度优先编号，子节点按下标顺序访问
+    node_at_.clear();
+    node_at_.reserve(count);
+    position_.assign(count, kNoParent);
+    stack_.clear();
+    const auto visit = [this](std::uint32_t root) {
+        stack_.push_back(root);
+        while (!stack_.empty()) {
+            const std::uint32_t node = stack_.back();
+            stack_.pop_back();
+            position_[node] = static_cast<std::uint32_t>(node_at_.size());
+            node_at_.push_back(node);
+            for (std::uint32_t i = child_offsets_[node + 1]; i > child_offsets_[node]; --i) {
+                const std::uint32_t child = children_[i - 1];
+                if (position_[child] == kNoParent) {
+                    stack_.push_back(child);
+                }
+            }
+        }
+    };
+    for (std::uint32_t node = 0; node < count; ++node) {
+        if (parent_[node] == kNoParent) {
+            visit(node);
+        }
+    }
+    // 剩余节点的父链成环：断开后作为根节点
+    for (std::uint32_t node = 0; node < count; ++node) {
+        if (position_[node] == kNoParent) {
+            parent_[node] = kNoParent;
+            visit(node);
+        }
+    }
+
+    parent_position_.resize(count);
+    for (std::uint32_t position = 0; position < count; ++position) {
+        const std::uint32_t parent = parent_[node_at_[position]];
+        parent_position_[position] = parent == kNoParent ? kNoParent : position_[parent];
+    }
+
+    // 子节点位置总在父节点之后，逆序累加子树大小
+    subtree_end_.assign(count, 1);
+    for (std::uint32_t position = count; position-- > 0;) {
+        const std::uint32_t parent = parent_position_[position];
+        if (parent != kNoParent) {
+            subtree_end_[parent] += subtree_end_[position];
+        }
+    }
+    for (std::uint32_t position = 0; position < count; ++position) {
+        subtree_end_[position] += position;
+    }
+
+    world_.resize(count);
+    layout_dirty_ = false;
+}
+
+void TransformHierarchy::propagate(std::uint32_t begin, std::uint32_t end) {
+    for (std::uint32_t position = begin; position < end; ++position) {
+        const auto& local = local_[node_at_[position]];
+        const std::uint32_t parent = parent_position_[position];
+        if (parent == kNoParent) {
+            world_[position] = local;
+        } else {
+            multiply(world_[parent], local, world_[position]);
+        }
+    }
+}
+
+std::size_t TransformHierarchy::update() {
+    const auto count = static_cast<std::uint32_t>(size());
+
+    if (layout_dirty_) {
+        rebuild_layout();
+        for (const auto node : dirty_list_) {
+            dirty_[node] = 0;
+        }
+        dirty_list_.clear();
+        propagate(0, count);
+        return count;
+    }
+
+    dirty_positions_.clear();
+    for (const auto node : dirty_list_) {
+        dirty_[node] = 0;
+        dirty_positions_.push_back(position_[node]);
+    }
+    dirty_list_.clear();
+    std::sort(dirty_positions_.begin(), dirty_positions_.end());
+
+    // 祖先已重算的子树被其区间覆盖，直接跳过
+    std::size_t updated = 0;
+    std::uint32_t covered = 0;
+    for (const auto position : dirty_positions_) {
+        if (position < covered) {
+            continue;
+        }
+        const std::uint32_t end = subtree_end_[position];
+        propagate(position, end);
+        updated += end - position;
+        covered = end;
+    }
+    return updated;
+}
+
+}  // namespace Corona
@@ -0,0 +1,276 @@
+#include <corona/transform_store.h>
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CORONA_TRANSFORM_SSE2 1
+#endif
+
+namespace Corona {
+
+namespace {
+
+/**
+ * @brief 一个条目的输入分量与三个欧拉角的正余弦
+ */
+struct ComposeInput {
+    float px, py, pz;
+    float sx, sy, sz;                 ///< 缩放
+    float sin_x, sin_y, sin_z;
+    float cos_x, cos_y, cos_z;
+};
+
+// 平移 * Rz * Ry * Rx * 缩放，列主序，与 basis_from_euler 的行展开一致
+void compose_matrix(const ComposeInput& in, ktm::fmat4x4& out) {
+    const float r00 = in.cos_y * in.cos_z;
+    const float r01 = in.cos_z * in.sin_y * in.sin_x - in.sin_z * in.cos_x;
+    const float r02 = in.cos_z * in.sin_y * in.cos_x + in.sin_z * in.sin_x;
+    const float r10 = in.cos_y * in.sin_z;
+    const float r11 = in.sin_z * in.sin_y * in.sin_x + in.cos_z * in.cos_x;
+    const float r12 = in.sin_z * in.sin_y * in.cos_x - in.cos_z * in.sin_x;
+    const float r20 = -in.sin_y;
+    const float r21 = in.cos_y * in.sin_x;
+    const float r22 = in.cos_y * in.cos_x;
+
+    out[0][0] = r00 * in.sx;
+    out[0][1] = r10 * in.sx;
+    out[0][2] = r20 * in.sx;
+    out[0][3] = 0.0f;
+    out[1][0] = r01 * in.sy;
+    out[1][1] = r11 * in.sy;
+    out[1][2] = r21 * in.sy;
+    out[1][3] = 0.0f;
+    out[2][0] = r02 * in.sz;
+    out[2][1] = r12 * in.sz;
+    out[2][2] = r22 * in.sz;
+    out[2][3] = 0.0f;
+    out[3][0] = in.px;
+    out[3][1] = in.py;
+    out[3][2] = in.pz;
+    out[3][3] = 1.0f;
+}
+
+#if defined(CORONA_TRANSFORM_SSE2)
+
+inline __m128 select_ps(__m128 mask, __m128 if_true, __m128 if_false) {
+    return _mm_or_ps(_mm_and_ps(mask, if_true), _mm_andnot_ps(mask, if_false));
+}
+
+/**
+ * @brief 4 路正余弦（Cephes sinf/cosf 的多项式，相对误差约 1e-7）
+ *
+ * 先按 π/2 分象限（Cody-Waite 三段常数减小约简误差），再在 [-π/4, π/4] 上求多项式，
+ * 最后按象限交换正余弦并修正符号。适用于 |x| 远小于 2^23 的角度。
+ */
+inline void sincos_ps(__m128 x, __m128& out_sin, __m128& out_cos) {
+    const __m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(0.636619772367581343f)));
+    const __m128 q = _mm_cvtepi32_ps(quadrant);
+
+    __m128 r = _mm_sub_ps(x, _mm_mul_ps(q, _mm_set1_ps(1.5703125f)));
+    r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(4.837512969970703125e-4f)));
+    r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(7.54978995489188216e-8f)));
+    const __m128 z = _mm_mul_ps(r, r);
+
+    __m128 sin_r = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-1.9515295891e-4f), z), _mm_set1_ps(8.3321608736e-3f));
+    sin_r = _mm_add_ps(_mm_mul_ps(sin_r, z), _mm_set1_ps(-1.6666654611e-1f));
+    sin_r = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sin_r, z), r), r);
+
+    __m128 cos_r = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.443315711809948e-5f), z), _mm_set1_ps(-1.388731625493765e-3f));
+    cos_r = _mm_add_ps(_mm_mul_ps(cos_r, z), _mm_set1_ps(4.166664568298827e-2f));
+    cos_r = _mm_mul_ps(_mm_mul_ps(cos_r, z), z);
+    cos_r = _mm_add_ps(_mm_sub_ps(cos_r, _mm_mul_ps(z, _mm_set1_ps(0.5f))), _mm_set1_ps(1.0f));
+
+    // 奇数象限交换正余弦；象限 2、3 的正弦与象限 1、2 的余弦取反
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i two = _mm_set1_epi32(2);
+    const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, one), one));
+    const __m128 sin_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, two), 30));
+    const __m128 cos_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, one), two), 30));
+
+    out_sin = _mm_xor_ps(select_ps(swap, cos_r, sin_r), sin_sign);
+    out_cos = _mm_xor_ps(select_ps(swap, sin_r, cos_r), cos_sign);
+}
+
+#endif
+
+}  // namespace
+
+void TransformStore::resize(std::size_t count) {
+    const std::size_t old_size = size();
+    if (count < old_size) {
+        std::erase_if(dirty_list_, [count](std::uint32_t index) { return index >= count; });
+    }
+
+    position_x_.resize(count, 0.0f);
+    position_y_.resize(count, 0.0f);
+    position_z_.resize(count, 0.0f);
+    rotation_x_.resize(count, 0.0f);
+    rotation_y_.resize(count, 0.0f);
+    rotation_z_.resize(count, 0.0f);
+    scale_x_.resize(count, 1.0f);
+    scale_y_.resize(count, 1.0f);
+    scale_z_.resize(count, 1.0f);
+    dirty_.resize(count, 0);
+    world_.resize(count);
+
+    for (std::size_t i = old_size; i < count; ++i) {
+        mark_dirty(i);
+    }
+}
+
+void TransformStore::reserve(std::size_t count) {
+    position_x_.reserve(count);
+    position_y_.reserve(count);
+    position_z_.reserve(count);
+    rotation_x_.reserve(count);
+    rotation_y_.reserve(count);
+    rotation_z_.reserve(count);
+    scale_x_.reserve(count);
+    scale_y_.reserve(count);
+    scale_z_.reserve(count);
+    dirty_.reserve(count);
+    dirty_list_.reserve(count);
+    world_.reserve(count);
+}
+
+bool TransformStore::set(std::size_t index, const ktm::fvec3& position, const ktm::fvec3& euler_rotation,
+                         const ktm::fvec3& scale) {
+    const bool changed = position_x_[index] != position.x || position_y_[index] != position.y ||
+                         position_z_[index] != position.z || rotation_x_[index] != euler_rotation.x ||
+                         rotation_y_[index] != euler_rotation.y || rotation_z_[index] != euler_rotation.z ||
+                         scale_x_[index] != scale.x || scale_y_[index] != scale.y || scale_z_[index] != scale.z;
+    if (!changed) {
+        return false;
+    }
+
+    position_x_[index] = position.x;
+    position_y_[index] = position.y;
+    position_z_[index] = position.z;
+    rotation_x_[index] = euler_rotation.x;
+    rotation_y_[index] = euler_rotation.y;
+    rotation_z_[index] = euler_rotation.z;
+    scale_x_[index] = scale.x;
+    scale_y_[index] = scale.y;
+    scale_z_[index] = scale.z;
+    mark_dirty(index);
+    return true;
+}
+
+void TransformStore::mark_dirty(std::size_t index) {
+    if (dirty_[index] == 0) {
+        dirty_[index] = 1;
+        dirty_list_.push_back(static_cast<std::uint32_t>(index));
+    }
+}
+
+std::size_t TransformStore::collect_dirty() {
+    for (const auto index : dirty_list_) {
+        dirty_[index] = 0;
+    }
+    return dirty_list_.size();
+}
+
+std::size_t TransformStore::lane_width() {
+#if defined(CORONA_TRANSFORM_SSE2)
+    return 4;
+#else
+    return 1;
+#endif
+}
+
+std::size_t TransformStore::update_world_matrices_scalar() {
+    const std::size_t count = collect_dirty();
+    for (const auto index : dirty_list_) {
+        const ComposeInput input{position_x_[index], position_y_[index], position_z_[index],
+                                 scale_x_[index], scale_y_[index], scale_z_[index],
+                                 std::sin(rotation_x_[index]), std::sin(rotation_y_[index]), std::sin(rotation_z_[index]),
+                                 std::cos(rotation_x_[index]), std::cos(rotation_y_[index]), std::cos(rotation_z_[index])};
+        compose_matrix(input, world_[index]);
+    }
+    dirty_list_.clear();
+    return count;
+}
+
+std::size_t TransformStore::update_world_matrices() {
+#if defined(CORONA_TRANSFORM_SSE2)
+    const std::size_t count = collect_dirty();
+    const std::uint32_t* indices = dirty_list_.data();
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const std::uint32_t i0 = indices[i];
+        const std::uint32_t i1 = indices[i + 1];
+        const std::uint32_t i2 = indices[i + 2];
+        const std::uint32_t i3 = indices[i + 3];
+        // 脏条目通常成段出现（新增或整体移动），连续时直接整段加载
+        const bool contiguous = i1 == i0 + 1 && i2 == i0 + 2 && i3 == i0 + 3;
+        const auto gather = [=](const std::vector<float>& values) {
+            return contiguous ? _mm_loadu_ps(values.data() + i0)
+                              : _mm_setr_ps(values[i0], values[i1], values[i2], values[i3]);
+        };
+
+        __m128 sin_x, cos_x, sin_y, cos_y, sin_z, cos_z;
+        sincos_ps(gather(rotation_x_), sin_x, cos_x);
+        sincos_ps(gather(rotation_y_), sin_y, cos_y);
+        sincos_ps(gather(rotation_z_), sin_z, cos_z);
+
+        const __m128 scale_x = gather(scale_x_);
+        const __m128 scale_y = gather(scale_y_);
+        const __m128 scale_z = gather(scale_z_);
+
+        // 旋转矩阵按列乘以对应缩放分量，九个元素各占一个向量
+        const __m128 sy_sx = _mm_mul_ps(sin_y, sin_x);
+        const __m128 sy_cx = _mm_mul_ps(sin_y, cos_x);
+        alignas(16) float m[9][4];
+        _mm_store_ps(m[0], _mm_mul_ps(_mm_mul_ps(cos_y, cos_z), scale_x));
+        _mm_store_ps(m[1], _mm_mul_ps(_mm_mul_ps(cos_y, sin_z), scale_x));
+        _mm_store_ps(m[2], _mm_mul_ps(_mm_sub_ps(_mm_setzero_ps(), sin_y), scale_x));
+        _mm_store_ps(m[3], _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(cos_z, sy_sx), _mm_mul_ps(sin_z, cos_x)), scale_y));
+        _mm_store_ps(m[4], _mm_mul_ps(_mm_add_ps(_mm_mul_ps(sin_z, sy_sx), _mm_mul_ps(cos_z, cos_x)), scale_y));
+        _mm_store_ps(m[5], _mm_mul_ps(_mm_mul_ps(cos_y, sin_x), scale_y));
+        _mm_store_ps(m[6], _mm_mul_ps(_mm_add_ps(_mm_mul_ps(cos_z, sy_cx), _mm_mul_ps(sin_z, sin_x)), scale_z));
+        _mm_store_ps(m[7], _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(sin_z, sy_cx), _mm_mul_ps(cos_z, sin_x)), scale_z));
+        _mm_store_ps(m[8], _mm_mul_ps(_mm_mul_ps(cos_y, cos_x), scale_z));
+
+        const std::uint32_t lanes[4] = {i0, i1, i2, i3};
+        for (int lane = 0; lane < 4; ++lane) {
+            const std::uint32_t index = lanes[lane];
+            auto& out = world_[index];
+            out[0][0] = m[0][lane];
+            out[0][1] = m[1][lane];
+            out[0][2] = m[2][lane];
+            out[0][3] = 0.0f;
+            out[1][0] = m[3][lane];
+            out[1][1] = m[4][lane];
+            out[1][2] = m[5][lane];
+            out[1][3] = 0.0f;
+            out[2][0] = m[6][lane];
+            out[2][1] = m[7][lane];
+            out[2][2] = m[8][lane];
+            out[2][3] = 0.0f;
+            out[3][0] = position_x_[index];
+            out[3][1] = position_y_[index];
+            out[3][2] = position_z_[index];
+            out[3][3] = 1.0f;
+        }
+    }
+
+    // 不足 4 个的尾部按标量处理
+    for (; i < count; ++i) {
+        const std::uint32_t index = indices[i];
+        const ComposeInput input{position_x_[index], position_y_[index], position_z_[index],
+                                 scale_x_[index], scale_y_[index], scale_z_[index],
+                                 std::sin(rotation_x_[index]), std::sin(rotation_y_[index]), std::sin(rotation_z_[index]),
+                                 std::cos(rotation_x_[index]), std::cos(rotation_y_[index]), std::cos(rotation_z_[index])};
+        compose_matrix(input, world_[index]);
+    }
+
+    dirty_list_.clear();
+    return count;
+#else
+    return update_world_matrices_scalar();
+#endif
+}
+
+}  // namespace Corona
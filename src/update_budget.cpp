@@ -0,0 +1,189 @@
+#include <corona/update_budget.h>
+
+#include <corona/kernel/core/i_logger.h>
+
+#include <algorithm>
+
+namespace Corona {
+
+namespace {
+
+constexpr float kCalmRatio = 0.75f;      ///< 平均耗时低于预算的该比例才视为有余量
+constexpr int kRecoverEvaluations = 4;  ///< 连续有余量的评估次数达到该值后恢复一个系统
+
+}  // namespace
+
+std::size_t UpdateBudget::add_system(std::string name, int priority, int nominal_fps) {
+    std::lock_guard lock(mutex_);
+    auto system = std::make_unique<System>();
+    system->name = std::move(name);
+    system->priority = priority;
+    system->nominal_fps = std::max(1, nominal_fps);
+    system->effective_fps.store(system->nominal_fps, std::memory_order_relaxed);
+
+    auto& registry = MetricsRegistry::instance();
+    const MetricLabels labels{{"system", system->name}};
+    registry.gauge("corona_system_nominal_fps", "Update rate declared by the system", labels)
+        .set(system->nominal_fps);
+    system->effective_fps_metric = &registry.gauge("corona_system_effective_fps",
+                                                   "Update rate currently applied to the system after load shedding",
+                                                   labels);
+    system->budget_metric = &registry.gauge("corona_system_budget_ms", "Time budget for one system update", labels);
+    system->overruns_metric = &registry.counter("corona_system_budget_overruns_total",
+                                                "Budget evaluations in which the system averaged over its budget",
+                                                labels);
+    update_metrics(*system);
+
+    systems_.push_back(std::move(system));
+    return systems_.size() - 1;
+}
+
+bool UpdateBudget::set_budget(std::string_view name, float budget_ms) {
+    std::lock_guard lock(mutex_);
+    for (auto& system : systems_) {
+        if (system->name == name) {
+            system->budget_ms = std::max(0.0f, budget_ms);
+            update_metrics(*system);
+            return true;
+        }
+    }
+    return false;
+}
+
+void UpdateBudget::set_shed_priority(int priority) {
+    std::lock_guard lock(mutex_);
+    shed_priority_ = priority;
+}
+
+void UpdateBudget::set_adaptive(bool enabled) {
+    std::lock_guard lock(mutex_);
+    adaptive_ = enabled;
+    if (!enabled) {
+        for (auto& system : systems_) {
+            system->effective_fps.store(system->nominal_fps, std::memory_order_relaxed);
+            update_metrics(*system);
+        }
+        calm_evaluations_ = 0;
+    }
+}
+
+bool UpdateBudget::adaptive() const {
+    std::lock_guard lock(mutex_);
+    return adaptive_;
+}
+
+void UpdateBudget::evaluate(std::span<const FrameSync::SystemTiming> timings) {
+    std::lock_guard lock(mutex_);
+    evaluate_locked(timings);
+    for (const auto& system : systems_) {
+        update_metrics(*system);
+    }
+}
+
+void UpdateBudget::evaluate_locked(std::span<const FrameSync::SystemTiming> timings) {
+    const System* overrun = nullptr;
+    bool calm = true;
+    for (std::size_t i = 0; i < systems_.size() && i < timings.size(); ++i) {
+        System& system = *systems_[i];
+        if (timings[i].updates == 0) {
+            continue;
+        }
+
+        system.average_ms = timings[i].average_ms;
+        const float budget = budget_of(system);
+        if (system.average_ms > budget) {
+            ++system.overruns;
+            system.overruns_metric->increment();
+            calm = false;
+            if (!overrun || system.priority > overrun->priority) {
+                overrun = &system;
+            }
+        } else if (system.average_ms > budget * kCalmRatio) {
+            calm = false;
+        }
+    }
+
+    if (!adaptive_) {
+        return;
+    }
+
+    if (overrun) {
+        calm_evaluations_ = 0;
+
+        // 降低优先级最低、仍高于下限的可降级系统
+        System* victim = nullptr;
+        for (auto& system : systems_) {
+            const int floor = std::max(1, system->nominal_fps / kMaxReduction);
+            if (sheddable(*system) && system->effective_fps.load(std::memory_order_relaxed) > floor &&
+                (!victim || system->priority < victim->priority)) {
+                victim = system.get();
+            }
+        }
+        if (victim) {
+            const int previous = victim->effective_fps.load(std::memory_order_relaxed);
+            const int reduced = std::max(std::max(1, victim->nominal_fps / kMaxReduction), previous / 2);
+            victim->effective_fps.store(reduced, std::memory_order_relaxed);
+            CFW_LOG_INFO("Load shedding: {} {} -> {} FPS ({} averages {:.2f} ms, budget {:.2f} ms)", victim->name,
+                         previous, reduced, overrun->name, overrun->average_ms, budget_of(*overrun));
+        }
+        return;
+    }
+
+    if (!calm) {
+        calm_evaluations_ = 0;
+        return;
+    }
+    if (++calm_evaluations_ < kRecoverEvaluations) {
+        return;
+    }
+    calm_evaluations_ = 0;
+
+    // 负载恢复后按优先级从高到低逐个恢复
+    System* restore = nullptr;
+    for (auto& system : systems_) {
+        if (system->effective_fps.load(std::memory_order_relaxed) < system->nominal_fps &&
+            (!restore || system->priority > restore->priority)) {
+            restore = system.get();
+        }
+    }
+    if (restore) {
+        const int previous = restore->effective_fps.load(std::memory_order_relaxed);
+        const int raised = std::min(restore->nominal_fps, previous * 2);
+        restore->effective_fps.store(raised, std::memory_order_relaxed);
+        CFW_LOG_INFO("Load recovered: {} {} -> {} FPS", restore->name, previous, raised);
+    }
+}
+
+std::vector<SystemRate> UpdateBudget::rates() const {
+    std::lock_guard lock(mutex_);
+    std::vector<SystemRate> result;
+    result.reserve(systems_.size());
+    for (const auto& system : systems_) {
+        SystemRate rate;
+        rate.name = system->name;
+        rate.priority = system->priority;
+        rate.nominal_fps = system->nominal_fps;
+        rate.effective_fps = system->effective_fps.load(std::memory_order_relaxed);
+        rate.budget_ms = budget_of(*system);
+        rate.average_ms = system->average_ms;
+        rate.overruns = system->overruns;
+        rate.sheddable = sheddable(*system);
+        result.push_back(std::move(rate));
+    }
+    return result;
+}
+
+void UpdateBudget::update_metrics(const System& system) const {
+    system.effective_fps_metric->set(system.effective_fps.load(std::memory_order_relaxed));
+    system.budget_metric->set(budget_of(system));
+}
+
+float UpdateBudget::budget_of(const System& system) const {
+    return system.budget_ms > 0.0f ? system.budget_ms : 1000.0f / static_cast<float>(system.nominal_fps);
+}
+
+bool UpdateBudget::sheddable(const System& system) const {
+    return system.priority < shed_priority_;
+}
+
+}  // namespace Corona